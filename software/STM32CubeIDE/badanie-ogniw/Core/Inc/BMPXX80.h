@@ -167,6 +167,8 @@
 #define	BMP280_DIG_P7		0x9A
 #define	BMP280_DIG_P8		0x9C
 #define	BMP280_DIG_P9		0x9E
+
+#define	BMP280_CALIB_LEN	24	// 0x88..0x9F, read in one burst
 #endif
 #ifdef BME280
 #define	BME280_DIG_T1		0x88
@@ -214,6 +216,8 @@
 #define	BMP280_CONFIG			0xF5
 #define	BMP280_PRESSUREDATA		0xF7
 #define	BMP280_TEMPDATA			0xFA
+#define	BMP280_DATA_LEN			6	// pressure and temperature, 0xF7..0xFC
+#define	BMP280_BURST_MAX		BMP280_CALIB_LEN	// longest burst read
 #endif
 #ifdef BME280
 #define	BME280_CHIPID			0xD0
@@ -262,6 +266,14 @@ void BMP280_Init(I2C_HandleTypeDef *i2c_handler, uint8_t temperature_resolution,
 void BMP280_Init(SPI_HandleTypeDef *spi_handler, uint8_t temperature_resolution, uint8_t pressure_oversampling, uint8_t mode);
 #endif
 void BMP280_SetConfig(uint8_t standby_time, uint8_t filter);
+// Normal mode with oversampling, IIR filter and standby time chosen for a new
+// result every period_ms at a pressure noise of noise_cpa (0.01 Pa RMS).
+// Returns the output period of the sensor in us, longer than period_ms only
+// when not even one sample fits.
+uint32_t BMP280_SetRate(uint32_t period_ms, uint16_t noise_cpa);
+HAL_StatusTypeDef BMP280_ReadBurst(uint8_t addr, uint8_t *data, uint8_t len);
+// First bus error since the last call or the last reading, then HAL_OK again
+HAL_StatusTypeDef BMP280_GetBusStatus(void);
 
 float BMP280_ReadTemperature(void);
 int32_t BMP280_ReadPressure(void);
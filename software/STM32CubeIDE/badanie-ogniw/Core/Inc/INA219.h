@@ -11,6 +11,7 @@
 #define INC_INA219_H_
 
 #include <stdbool.h>
+#include "i2c_bus.h"
 
 #define INA219_ADDRESS 							(0x40)
 
@@ -74,6 +75,16 @@ typedef struct
 	uint8_t				Address;
 } INA219_t;
 
+// Bus voltage, current and power registers read in the background over the
+// I2C queue (i2c_bus.h), the buffers must stay valid until the sample is ready
+typedef struct
+{
+	uint8_t				raw[3][2];
+	I2Cbus_Xfer			xfer[3];
+	volatile uint8_t	pending;
+	volatile uint8_t	errors;
+} INA219_Sample_t;
+
 enum BatteryState {Battery_START,Battery_OK, Battery_LOW}; // To help health check function sufficiently diagnose problems
 
 int INA219_GetDeltaTime_ms();
@@ -101,6 +112,14 @@ void INA219_setPowerMode(INA219_t *ina219, uint8_t Mode);
 uint16_t Read16(INA219_t *ina219, uint8_t Register);
 HAL_StatusTypeDef Write16(INA219_t *ina219, uint8_t Register, uint16_t Value);
 
+void INA219_StartSample(INA219_t *ina219, INA219_Sample_t *sample);
+bool INA219_SampleReady(INA219_Sample_t *sample);
+uint16_t INA219_SampleBusVoltage(const INA219_Sample_t *sample);
+int16_t INA219_SampleCurrent_raw(const INA219_Sample_t *sample);
+int16_t INA219_SampleCurrent_mA(const INA219_Sample_t *sample);
+int32_t INA219_SampleCurrent_uA(const INA219_Sample_t *sample);
+uint16_t INA219_SamplePower(const INA219_Sample_t *sample);
+
 
 
 #endif /* INC_INA219_H_ */
@@ -0,0 +1,60 @@
+/*
+ * adc_sampler.h
+ *
+ *  Timer triggered ADC1 acquisition into a circular DMA double buffer.
+ */
+
+#ifndef INC_ADC_SAMPLER_H_
+#define INC_ADC_SAMPLER_H_
+
+#include "stm32f7xx_hal.h"
+
+/* Default sample rate, TIM6 TRGO starts each conversion */
+#ifndef ADCSAMPLER_RATE_HZ
+#define ADCSAMPLER_RATE_HZ          10000
+#endif
+
+/* Half buffer = 2^ADCSAMPLER_HALF_LOG2 samples, one block per DMA half */
+#ifndef ADCSAMPLER_HALF_LOG2
+#define ADCSAMPLER_HALF_LOG2        8
+#endif
+
+/* Extra resolution from oversampling, 4^n samples per extra bit n */
+#ifndef ADCSAMPLER_OVERSAMPLE_BITS
+#define ADCSAMPLER_OVERSAMPLE_BITS  4
+#endif
+
+/* 144 cycles at 36 MHz ADCCLK: 4.3 us per conversion, tolerates a high
+   impedance divider or thermistor */
+#ifndef ADCSAMPLER_SAMPLETIME
+#define ADCSAMPLER_SAMPLETIME       ADC_SAMPLETIME_144CYCLES
+#endif
+
+#define ADCSAMPLER_HALF_LEN         (1u << ADCSAMPLER_HALF_LOG2)
+
+#if (2 * ADCSAMPLER_OVERSAMPLE_BITS) > ADCSAMPLER_HALF_LOG2
+#error "ADCSAMPLER_OVERSAMPLE_BITS needs 4^n samples per half buffer"
+#endif
+
+typedef struct {
+  uint32_t n;               /* samples */
+  uint16_t avg;             /* 12 bit, rounded */
+  uint16_t min;
+  uint16_t max;
+  uint32_t oversampled;     /* 12 + ADCSAMPLER_OVERSAMPLE_BITS bit */
+} ADCsampler_Result;
+
+typedef struct {
+  uint32_t blocks;          /* half buffers processed */
+  uint32_t errors;          /* ADC overrun or DMA error, acquisition restarted */
+  uint32_t rate_hz;         /* actual rate after TIM6 rounding */
+} ADCsampler_Stats;
+
+HAL_StatusTypeDef ADCsampler_Start(uint32_t rate_hz);
+void ADCsampler_Stop(void);
+uint32_t ADCsampler_SetRate(uint32_t rate_hz);
+uint8_t ADCsampler_GetBlock(ADCsampler_Result *result);
+uint8_t ADCsampler_Read(ADCsampler_Result *result);
+void ADCsampler_GetStats(ADCsampler_Stats *stats);
+
+#endif /* INC_ADC_SAMPLER_H_ */
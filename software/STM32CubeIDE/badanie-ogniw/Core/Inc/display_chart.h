@@ -0,0 +1,83 @@
+/*
+ * display_chart.h
+ *
+ *  Scrolling INA219 voltage and current trace on the ST7735. The chart is
+ *  a band of full length panel lines in the controller's vertical scroll
+ *  area, one line per CHART_SAMPLES_PER_LINE samples showing their
+ *  min..max, newest at the band edge next to the text.
+ *
+ *  The chart draws straight to the panel. Nothing else may draw into its
+ *  band, a framebuffer flush over it blanks the trace until Chart_Redraw.
+ */
+
+#ifndef INC_DISPLAY_CHART_H_
+#define INC_DISPLAY_CHART_H_
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Lines in the band, also the history ring length */
+#ifndef CHART_HISTORY
+#define CHART_HISTORY           60
+#endif
+
+/* Samples per line, 100 at INA219_PERIOD_MS 10 is one line per second */
+#ifndef CHART_SAMPLES_PER_LINE
+#define CHART_SAMPLES_PER_LINE  100
+#endif
+
+/* Value axis in mV and mA (not INA219 register counts), readings outside
+   are clamped to the band edge. The current range covers the 32V_2A
+   calibration. */
+#ifndef CHART_V_MIN_MV
+#define CHART_V_MIN_MV          2500
+#endif
+#ifndef CHART_V_MAX_MV
+#define CHART_V_MAX_MV          4500
+#endif
+#ifndef CHART_I_MIN_MA
+#define CHART_I_MIN_MA          (-2000)
+#endif
+#ifndef CHART_I_MAX_MA
+#define CHART_I_MAX_MA          2000
+#endif
+#if CHART_V_MIN_MV >= CHART_V_MAX_MV || CHART_I_MIN_MA >= CHART_I_MAX_MA
+#error "display_chart.h: empty value axis"
+#endif
+
+/* Memory lines the controller scrolls over (VSCRDEF), 160 on the
+   128x160 panel */
+#ifndef CHART_PANEL_LINES
+#define CHART_PANEL_LINES       160
+#endif
+
+/* RGB565 */
+#define CHART_BG_COLOR          0x0000
+#define CHART_ZERO_COLOR        0x4208    /* 0 mA reference */
+#define CHART_V_COLOR           0xFFE0
+#define CHART_I_COLOR           0x07FF
+
+/* One line of history */
+typedef struct {
+  uint16_t v_min, v_max;    /* mV */
+  int16_t i_min, i_max;     /* mA */
+} Chart_Point;
+
+/* first: screen row (column on a rotated MV panel) where the band starts */
+void Chart_Init(uint16_t first);
+/* From the sampling task, only updates the ring. current_mA as from
+   INA219_SampleCurrent_mA. */
+void Chart_Add(uint16_t voltage_mV, int16_t current_mA);
+/* From the display task, draws the lines completed since the last call */
+void Chart_Update(void);
+/* Draw the whole ring again on the next Chart_Update */
+void Chart_Redraw(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_DISPLAY_CHART_H_ */
@@ -0,0 +1,43 @@
+/*
+ * display_fields.h
+ *
+ *  Text fields on the ST7735 framebuffer that remember what they show
+ *  and redraw only the characters that changed.
+ */
+
+#ifndef INC_DISPLAY_FIELDS_H_
+#define INC_DISPLAY_FIELDS_H_
+
+#include <stdint.h>
+#include "fonts.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Longest field, one screen line of Font_7x10 */
+#ifndef FIELD_MAX_CHARS
+#define FIELD_MAX_CHARS   18
+#endif
+
+/* One line of text at a fixed place, owned by the caller */
+typedef struct {
+  uint16_t x, y;
+  const FontDef *font;
+  uint16_t color;
+  uint16_t bgcolor;
+
+  /* last rendered, spaces past the end of a shorter text */
+  char text[FIELD_MAX_CHARS];
+  uint8_t len;
+  uint8_t drawn;
+} Field;
+
+uint8_t Field_Set(Field *field, const char *text);
+void Field_Invalidate(Field *field);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_DISPLAY_FIELDS_H_ */
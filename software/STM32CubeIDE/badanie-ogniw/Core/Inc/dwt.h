@@ -0,0 +1,35 @@
+/*
+ * dwt.h
+ *
+ *  DWT cycle counter, one count per core clock (72 MHz, wraps after ~59 s).
+ */
+
+#ifndef INC_DWT_H_
+#define INC_DWT_H_
+
+#include "stm32f7xx_hal.h"
+
+static inline void DWT_Init(void)
+{
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->LAR = 0xC5ACCE55;      /* Cortex-M7: unlock the DWT registers */
+  DWT->CYCCNT = 0;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+static inline uint32_t DWT_Cycles(void)
+{
+  return DWT->CYCCNT;
+}
+
+static inline uint32_t DWT_CyclesToUs(uint32_t cycles)
+{
+  return cycles / (SystemCoreClock / 1000000);
+}
+
+static inline uint32_t DWT_UsToCycles(uint32_t us)
+{
+  return us * (SystemCoreClock / 1000000);
+}
+
+#endif /* INC_DWT_H_ */
@@ -21,14 +21,67 @@
 #define CMD55    (0x40+55)    /* APP_CMD */
 #define CMD58    (0x40+58)    /* READ_OCR */
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 DSTATUS SD_disk_initialize (BYTE pdrv);
 DSTATUS SD_disk_status (BYTE pdrv);
 DRESULT SD_disk_read (BYTE pdrv, BYTE* buff, DWORD sector, UINT count);
 DRESULT SD_disk_write (BYTE pdrv, const BYTE* buff, DWORD sector, UINT count);
 DRESULT SD_disk_ioctl (BYTE pdrv, BYTE cmd, void* buff);
 
+#ifdef __cplusplus
+}
+#endif
+
 #define SPI_TIMEOUT 1000
 
+/* 1: move data blocks with one SPI1 DMA transfer, 0: byte by byte */
+#ifndef SD_USE_DMA
+#define SD_USE_DMA 1
+#endif
+
+/* 1: verify the CRC16 of received data blocks */
+#ifndef SD_CHECK_CRC
+#define SD_CHECK_CRC 1
+#endif
+
+/* Extra attempts of a failed read / write, at a slower clock after a
+   CRC or token error, at the same clock after any other failure */
+#ifndef SD_RETRIES
+#define SD_RETRIES 2
+#endif
+
+/* Clean reads of sector 0 needed to keep a data clock after init */
+#ifndef SD_SELFTEST_READS
+#define SD_SELFTEST_READS 4
+#endif
+
+/* Bus activity counters, compare SD_USE_DMA settings with
+   spi_transfers / (sectors_read + sectors_written) */
+typedef struct {
+  uint32_t spi_transfers;     /* HAL SPI calls issued on hspi1 */
+  uint32_t sectors_read;
+  uint32_t sectors_written;
+  uint32_t crc_errors;        /* data blocks with a bad CRC16 */
+  uint32_t token_errors;      /* missing start token / rejected data response */
+  uint32_t retries;
+  uint32_t clock_steps;       /* data clock step downs */
+} SD_BusStats;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void SD_GetBusStats(SD_BusStats *stats);
+void SD_ResetBusStats(void);
+uint32_t SD_GetClockHz(void);
+
+#ifdef __cplusplus
+}
+#endif
+
 #endif
 
 
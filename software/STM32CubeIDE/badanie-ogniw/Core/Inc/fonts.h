@@ -4,12 +4,20 @@
 
 #include <stdint.h>
 
+// Glyphs are drawn from run length tables (fonts_packed.c, generated
+// offline by software/tools/fontgen and checked in, not made by the
+// firmware build). The one word per row tables in fonts.c are their
+// source and only built with FONTS_RAW, for host checks.
 typedef struct {
     const uint8_t width;
     uint8_t height;
-    const uint16_t *data;
+    const uint16_t *data;       // rows, NULL without FONTS_RAW
+    const uint8_t *runs;        // background << 4 | foreground pixels
+    const uint16_t *offsets;    // glyph c: runs[offsets[c - 32]] .. runs[offsets[c - 31] - 1]
 } FontDef;
 
+extern const uint8_t Font7x10_Runs[], Font11x18_Runs[], Font16x26_Runs[];
+extern const uint16_t Font7x10_Offsets[], Font11x18_Offsets[], Font16x26_Offsets[];
 
 extern FontDef Font_7x10;
 extern FontDef Font_11x18;
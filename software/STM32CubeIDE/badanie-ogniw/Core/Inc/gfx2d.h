@@ -0,0 +1,78 @@
+/*
+ * gfx2d.h
+ *
+ *  Pixel back end of the ST7735 framebuffer: rectangle fills, copies and
+ *  glyph blits into RGB565 surfaces in panel byte order. Runs on the
+ *  DMA2D (Chrom-ART) engine, or in portable C with the same pixels.
+ */
+
+#ifndef INC_GFX2D_H_
+#define INC_GFX2D_H_
+
+#include <stdint.h>
+#include "fonts.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* 1: DMA2D, 0: portable C only */
+#ifndef GFX2D_DMA2D
+#ifdef FB_HOST
+#define GFX2D_DMA2D       0
+#else
+#define GFX2D_DMA2D       1
+#endif
+#endif
+
+/* Smaller operations run on the CPU, the register setup costs more */
+#ifndef GFX2D_MIN_PIXELS
+#define GFX2D_MIN_PIXELS  16
+#endif
+
+typedef struct {
+  uint32_t ops;             /* started on the DMA2D */
+  uint32_t pixels;          /* written by the DMA2D */
+  uint32_t soft_ops;        /* done on the CPU */
+  uint32_t errors;          /* transfer or configuration errors */
+} Gfx2D_Stats;
+
+/* Surfaces are RGB565 in panel byte order, pitch in pixels. Colours are
+   native RGB565. An operation may still run when the call returns,
+   Gfx2D_Wait before the CPU touches its destination. */
+void Gfx2D_Init(void);
+void Gfx2D_Fill(uint16_t *dst, uint16_t pitch, uint16_t w, uint16_t h, uint16_t color);
+void Gfx2D_Copy(uint16_t *dst, uint16_t dst_pitch, const uint16_t *src, uint16_t src_pitch,
+                uint16_t w, uint16_t h);
+/* Top left w x h of the glyph, w and h at most the font size */
+void Gfx2D_Glyph(uint16_t *dst, uint16_t pitch, const FontDef *font, char ch, uint16_t w, uint16_t h,
+                 uint16_t color, uint16_t bgcolor);
+void Gfx2D_Wait(void);
+void Gfx2D_GetStats(Gfx2D_Stats *stats);
+
+/* The portable versions, also used below GFX2D_MIN_PIXELS */
+void Gfx2D_SoftFill(uint16_t *dst, uint16_t pitch, uint16_t w, uint16_t h, uint16_t color);
+void Gfx2D_SoftCopy(uint16_t *dst, uint16_t dst_pitch, const uint16_t *src, uint16_t src_pitch,
+                    uint16_t w, uint16_t h);
+void Gfx2D_SoftGlyph(uint16_t *dst, uint16_t pitch, const FontDef *font, char ch, uint16_t w, uint16_t h,
+                     uint16_t color, uint16_t bgcolor);
+
+/* Register values of one DMA2D transfer, addresses as pointers */
+typedef struct {
+  uint32_t CR, FGOR, BGOR, FGPFCCR, FGCOLR, BGPFCCR, BGCOLR;
+  uint32_t OPFCCR, OCOLR, OOR, NLR;
+  const void *fg, *bg;
+  void *out;
+} Gfx2D_Xfer;
+
+#if GFX2D_DMA2D && defined(FB_HOST)
+/* Host build of the DMA2D path, a model in the host tool runs the
+   transfer instead of the peripheral */
+void Gfx2D_HostRun(const Gfx2D_Xfer *xfer);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_GFX2D_H_ */
@@ -0,0 +1,60 @@
+/*
+ * glyph_cache.h
+ *
+ *  Expanded font glyphs, RGB565 in panel byte order, cached by font,
+ *  character and colours. Used by the ST7735 driver and its framebuffer.
+ */
+
+#ifndef INC_GLYPH_CACHE_H_
+#define INC_GLYPH_CACHE_H_
+
+#include <stdint.h>
+#include "fonts.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Direct mapped slots, 96 hold every printable character of one font and
+   colour pair without a conflict */
+#ifndef GLYPH_CACHE_SLOTS
+#define GLYPH_CACHE_SLOTS   96
+#endif
+
+/* Largest cached glyph in pixels (Font_7x10), bigger ones are expanded
+   on every call */
+#ifndef GLYPH_CACHE_PIXELS
+#define GLYPH_CACHE_PIXELS  (7 * 10)
+#endif
+
+/* A4 masks for the DMA2D (gfx2d.h), one per font and character */
+#ifndef GLYPH_MASK_SLOTS
+#define GLYPH_MASK_SLOTS    96
+#endif
+
+/* Mask row in pixels, even so every row starts on a byte */
+#define GLYPH_MASK_STRIDE(width)  (((width) + 1) & ~1)
+
+#ifndef GLYPH_MASK_BYTES
+#define GLYPH_MASK_BYTES    (GLYPH_MASK_STRIDE(7) / 2 * 10)
+#endif
+
+typedef struct {
+  uint32_t hits;            /* colour glyphs and A4 masks */
+  uint32_t misses;
+  uint32_t uncached;        /* glyphs too big for a slot */
+} Glyph_Stats;
+
+/* font.width x font.height pixels, row by row. Valid until the next call. */
+const uint16_t *Glyph_Get(const FontDef *font, char ch, uint16_t color, uint16_t bgcolor);
+/* GLYPH_MASK_STRIDE(font.width) pixels per row, 4 bits each, first pixel
+   in the low nibble, 0x0 background, 0xF foreground. Valid until the
+   next call. */
+const uint8_t *Glyph_GetMask(const FontDef *font, char ch);
+void Glyph_GetStats(Glyph_Stats *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_GLYPH_CACHE_H_ */
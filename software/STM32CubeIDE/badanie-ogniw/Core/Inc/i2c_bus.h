@@ -0,0 +1,72 @@
+/*
+ * i2c_bus.h
+ *
+ *  Interrupt driven transaction queue for hi2c1 (SGP30, INA219).
+ */
+
+#ifndef INC_I2C_BUS_H_
+#define INC_I2C_BUS_H_
+
+#include "stm32f7xx_hal.h"
+
+/* A transfer still running after this long is aborted and the bus recovered */
+#ifndef I2CBUS_TIMEOUT_MS
+#define I2CBUS_TIMEOUT_MS 25
+#endif
+
+typedef enum {
+  I2CBUS_WRITE,
+  I2CBUS_READ,
+  I2CBUS_MEM_WRITE,         /* register address, then data */
+  I2CBUS_MEM_READ           /* register address, repeated start, data */
+} I2Cbus_Op;
+
+typedef enum {
+  I2CBUS_IDLE,
+  I2CBUS_QUEUED,
+  I2CBUS_ACTIVE,
+  I2CBUS_DONE,
+  I2CBUS_ERROR
+} I2Cbus_State;
+
+typedef struct I2Cbus_Xfer I2Cbus_Xfer;
+typedef void (*I2Cbus_Callback)(I2Cbus_Xfer *xfer);
+
+/* One transaction, owned by the caller until it reaches DONE / ERROR */
+struct I2Cbus_Xfer {
+  I2Cbus_Op op;
+  uint8_t addr;             /* 7 bit */
+  uint8_t reg;              /* MEM ops */
+  uint8_t *buf;
+  uint16_t len;
+  I2Cbus_Callback done;     /* from the I2C interrupt, or I2Cbus_Poll on timeout */
+  void *ctx;
+
+  /* bus internal */
+  volatile I2Cbus_State state;
+  uint32_t error;           /* HAL_I2C_ERROR_x */
+  uint32_t start;
+  I2Cbus_Xfer *next;
+};
+
+typedef struct {
+  uint32_t xfers;
+  uint32_t nacks;           /* HAL_I2C_ERROR_AF, device busy or absent */
+  uint32_t errors;          /* bus errors, arbitration lost, overrun */
+  uint32_t timeouts;
+  uint32_t recoveries;
+} I2Cbus_Stats;
+
+void I2Cbus_Submit(I2Cbus_Xfer *xfer);
+void I2Cbus_Poll(void);
+HAL_StatusTypeDef I2Cbus_Transfer(I2Cbus_Xfer *xfer);
+void I2Cbus_Recover(void);
+void I2Cbus_GetStats(I2Cbus_Stats *stats);
+
+/* Blocking helpers, main loop only */
+HAL_StatusTypeDef I2Cbus_Write(uint8_t addr, uint8_t *data, uint16_t len);
+HAL_StatusTypeDef I2Cbus_Read(uint8_t addr, uint8_t *data, uint16_t len);
+HAL_StatusTypeDef I2Cbus_MemWrite(uint8_t addr, uint8_t reg, uint8_t *data, uint16_t len);
+HAL_StatusTypeDef I2Cbus_MemRead(uint8_t addr, uint8_t reg, uint8_t *data, uint16_t len);
+
+#endif /* INC_I2C_BUS_H_ */
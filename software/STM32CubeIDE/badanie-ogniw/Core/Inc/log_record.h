@@ -0,0 +1,140 @@
+/*
+ * log_record.h
+ *
+ *  Binary measurement log format, shared by the firmware and the host
+ *  exporter (software/tools/bin2csv). Only depends on <stdint.h>.
+ *
+ *  File layout: LogFileHeader (512 bytes) followed by fixed size records,
+ *  and a LogFileFooter (256 bytes) with the sampling loop timing when the
+ *  log is closed cleanly. A new header is written each time logging
+ *  starts, so one file may hold several sessions. All values are little
+ *  endian.
+ */
+
+#ifndef INC_LOG_RECORD_H_
+#define INC_LOG_RECORD_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define LOG_MAGIC           0x4C474F42u   /* "BOGL" */
+#define LOG_FOOTER_MAGIC    0x46474F42u   /* "BOGF" */
+#define LOG_VERSION         1
+#define LOG_HEADER_SIZE     512
+#define LOG_MAX_CHANNELS    28
+#define LOG_CHANNEL_NAME    12
+#define LOG_FOOTER_SIZE     256           /* multiple of the record size */
+#define LOG_HIST_BUCKETS    20
+
+/* Channel value types */
+#define LOG_TYPE_U16        1
+#define LOG_TYPE_I16        2
+#define LOG_TYPE_U32        3
+#define LOG_TYPE_I32        4
+
+/* One channel of the record payload: value = raw / divisor */
+typedef struct __attribute__((packed)) {
+  char     name[LOG_CHANNEL_NAME];
+  uint8_t  type;
+  uint8_t  reserved;
+  uint16_t divisor;
+} LogChannel;
+
+typedef struct __attribute__((packed)) {
+  uint32_t   magic;
+  uint16_t   version;
+  uint16_t   header_size;       /* LOG_HEADER_SIZE */
+  uint16_t   record_size;       /* sizeof(LogRecord) */
+  uint16_t   channel_count;
+  uint32_t   sample_period_ms;
+  uint32_t   first_seq;
+  uint32_t   cpu_clock_hz;      /* DWT cycle counter rate, 0 in old files */
+  uint8_t    reserved[4];
+  LogChannel channels[LOG_MAX_CHANNELS];
+  uint8_t    padding[LOG_HEADER_SIZE - 28 - LOG_MAX_CHANNELS * sizeof(LogChannel) - 2];
+  uint16_t   crc;               /* Log_Crc16 over the preceding bytes */
+} LogFileHeader;
+
+/* Channels follow time_ms in the order listed in the header */
+typedef struct __attribute__((packed)) {
+  uint32_t seq;                 /* increments by one per record */
+  uint32_t time_ms;             /* HAL tick */
+  int32_t  pressure_Pa;
+  int16_t  temperature_cC;      /* 0.01 degC */
+  uint16_t tvoc_ppb;
+  uint16_t co2_eq_ppm;
+  uint16_t ethanol_raw;         /* scaled by 512 */
+  uint16_t h2_raw;              /* scaled by 512 */
+  uint16_t voltage_mV;
+  int16_t  current_mA;
+  uint16_t power_mW;
+  uint16_t reserved;
+  uint16_t crc;                 /* Log_Crc16 over the preceding bytes */
+} LogRecord;
+
+/* Sampling loop timing, measured on the DWT cycle counter.
+   Histogram bucket i counts values in [2^(i-1), 2^i) us, bucket 0 counts
+   values below 1 us and the last bucket everything above. */
+typedef struct __attribute__((packed)) {
+  uint32_t ticks;               /* sample period ticks */
+  uint32_t missed_ticks;        /* ticks that found the previous one unserved */
+  uint32_t period_min_us;       /* tick to tick */
+  uint32_t period_max_us;
+  uint32_t latency_max_us;      /* tick to the end of that sample's work */
+  uint32_t jitter_max_us;       /* |start to start - nominal period| */
+  uint32_t latency_hist[LOG_HIST_BUCKETS];
+  uint32_t jitter_hist[LOG_HIST_BUCKETS];
+} LogTiming;
+
+typedef struct __attribute__((packed)) {
+  uint32_t  magic;              /* LOG_FOOTER_MAGIC */
+  uint16_t  version;
+  uint16_t  footer_size;        /* LOG_FOOTER_SIZE */
+  uint32_t  next_seq;           /* seq of the record after the last one */
+  uint32_t  time_ms;            /* HAL tick at close */
+  LogTiming timing;
+  uint8_t   padding[LOG_FOOTER_SIZE - 16 - sizeof(LogTiming) - 2];
+  uint16_t  crc;                /* Log_Crc16 over the preceding bytes */
+} LogFileFooter;
+
+/* compile time size checks, valid in C and C++ */
+typedef char LogFileHeader_size_check[(sizeof(LogFileHeader) == LOG_HEADER_SIZE) ? 1 : -1];
+typedef char LogRecord_size_check[(sizeof(LogRecord) == 32) ? 1 : -1];
+typedef char LogFileFooter_size_check[(sizeof(LogFileFooter) == LOG_FOOTER_SIZE &&
+                                       LOG_FOOTER_SIZE % sizeof(LogRecord) == 0) ? 1 : -1];
+
+/* CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF), nibble table */
+static inline uint16_t Log_Crc16(const void *data, size_t len)
+{
+  static const uint16_t table[16] = {
+    0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+    0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF
+  };
+  const uint8_t *p = (const uint8_t *)data;
+  uint16_t crc = 0xFFFF;
+
+  while (len--)
+  {
+    crc = (uint16_t)((crc << 4) ^ table[(crc >> 12) ^ (*p >> 4)]);
+    crc = (uint16_t)((crc << 4) ^ table[(crc >> 12) ^ (*p & 0x0F)]);
+    p++;
+  }
+
+  return crc;
+}
+
+/* Firmware side (log_record.c) */
+struct sensors;
+void LogRecord_InitHeader(LogFileHeader *hdr, uint32_t sample_period_ms);
+void LogRecord_Pack(LogRecord *rec, const struct sensors *s, uint32_t time_ms);
+void LogRecord_InitFooter(LogFileFooter *ftr, const LogTiming *timing, uint32_t time_ms);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_LOG_RECORD_H_ */
@@ -0,0 +1,20 @@
+/*
+ * loop_stats.h
+ *
+ *  Sample period overrun and jitter instrumentation (DWT timestamps).
+ */
+
+#ifndef INC_LOOP_STATS_H_
+#define INC_LOOP_STATS_H_
+
+#include "log_record.h"
+
+void LoopStats_Init(uint32_t period_ms);
+void LoopStats_Reset(void);
+void LoopStats_Tick(void);      /* sample period interrupt */
+void LoopStats_Start(void);     /* sample work starts */
+void LoopStats_End(void);       /* sample work done */
+void LoopStats_Get(LogTiming *timing);
+void LoopStats_Print(void);
+
+#endif /* INC_LOOP_STATS_H_ */
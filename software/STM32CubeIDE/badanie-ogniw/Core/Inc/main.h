@@ -51,6 +51,11 @@ struct sensors {
     uint16_t INA219_Voltage;
     int16_t INA219_Current;
     uint16_t INA219_Power;
+
+    // derived
+    uint16_t ADC_avg;       // ADC1 channel 0, average since the last read
+    int32_t charge_uAh;     // INA219 current integrated since start
+    int32_t energy_uWh;     // INA219 power integrated since start
 };
 extern struct sensors s;
 
@@ -65,6 +70,77 @@ extern struct sensors s;
 /* USER CODE BEGIN EM */
 #define RETRY_DELAY_MS 2000
 
+// TIM7 sample period
+#define SAMPLE_PERIOD_MS 1000
+
+// Task periods (scheduler.h), the log task runs on the TIM7 tick
+#ifndef INA219_PERIOD_MS
+#define INA219_PERIOD_MS  10
+#endif
+#ifndef BMP280_PERIOD_MS
+#define BMP280_PERIOD_MS  100
+#endif
+// BMP280 pressure noise in 0.01 Pa RMS, 1 Pa is about 8 cm of altitude
+#ifndef BMP280_NOISE_CPA
+#define BMP280_NOISE_CPA  100
+#endif
+#ifndef SGP30_PERIOD_MS
+#define SGP30_PERIOD_MS   1000    // IAQ baseline algorithm expects 1 Hz
+#endif
+#ifndef ADC_PERIOD_MS
+#define ADC_PERIOD_MS     100
+#endif
+#ifndef DISPLAY_PERIOD_MS
+#define DISPLAY_PERIOD_MS 200
+#endif
+// Minimum time between panel refreshes, 0 = every display period. The
+// fields are still updated in the framebuffer each period.
+#ifndef DISPLAY_FLUSH_MS
+#define DISPLAY_FLUSH_MS  0
+#endif
+// Voltage and current trace under the text (display_chart.h), the text
+// lines move closer together to make room
+#ifndef DISPLAY_CHART
+#define DISPLAY_CHART     1
+#endif
+
+// Binary live telemetry on USART3 (telemetry.h), 0 = off. Changed and
+// full packets, console text shares the line at TELEMETRY_BAUDRATE.
+#ifndef TELEMETRY_PERIOD_MS
+#define TELEMETRY_PERIOD_MS 10
+#endif
+#ifndef TELEMETRY_FULL_MS
+#define TELEMETRY_FULL_MS   1000
+#endif
+#ifndef TELEMETRY_BAUDRATE
+#define TELEMETRY_BAUDRATE  921600
+#endif
+
+// Profiler table appended to PROFILER_SD_FILE every N ms, 0 = UART only
+#ifndef PROFILER_SD_DUMP_MS
+#define PROFILER_SD_DUMP_MS 0
+#endif
+#define PROFILER_SD_FILE "prof.txt"
+
+// SD card log format: CSV text or fixed size binary records (log_record.h)
+#define LOG_FORMAT_CSV    0
+#define LOG_FORMAT_BINARY 1
+#ifndef LOG_FORMAT
+#define LOG_FORMAT LOG_FORMAT_BINARY
+#endif
+
+// Preallocated contiguous log (sd_log.h), a new file name_NNN.ext per session.
+// Past the preallocated size the file grows with f_write. 0 = append to LOG_FILE_NAME and let FatFs grow it cluster by cluster.
+#ifndef LOG_PREALLOC_BYTES
+#define LOG_PREALLOC_BYTES (16UL * 1024 * 1024)
+#endif
+
+#if LOG_FORMAT == LOG_FORMAT_BINARY
+#define LOG_FILE_NAME "pomiar.bin"
+#else
+#define LOG_FILE_NAME "test.txt"
+#endif
+
 /* USER CODE END EM */
 
 /* Exported functions prototypes ---------------------------------------------*/
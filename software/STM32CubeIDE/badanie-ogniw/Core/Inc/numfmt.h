@@ -0,0 +1,55 @@
+/*
+ * numfmt.h
+ *
+ *  Integer and fixed point number to text without printf, and a CSV row
+ *  builder on top. Builds for the target and for the host
+ *  (software/tools/numfmt_host).
+ *
+ *  The NumFmt_ calls write at p without a terminator and return the new
+ *  end, p needs room for NUMFMT_MAX characters.
+ */
+
+#ifndef INC_NUMFMT_H_
+#define INC_NUMFMT_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* "-4294967295.9999" */
+#define NUMFMT_MAX          16
+#define NUMFMT_MAX_DECIMALS 4
+
+char *NumFmt_U32(char *p, uint32_t v);
+char *NumFmt_I32(char *p, int32_t v);
+/* raw / divisor rounded to decimals like printf("%.*f"), -0.00 included */
+char *NumFmt_Fixed(char *p, int32_t raw, uint32_t divisor, uint8_t decimals);
+char *NumFmt_Str(char *p, const char *s);
+/* Right aligns [start, end) in width characters, returns the new end */
+char *NumFmt_Right(char *start, char *end, uint8_t width);
+
+/* Comma separated row, the separators go in between the columns */
+typedef struct {
+  char *buf;
+  char *p;
+  char *end;
+  uint8_t cols;
+  uint8_t overflow;
+} CsvRow;
+
+void CsvRow_Init(CsvRow *row, char *buf, size_t size);
+void CsvRow_U32(CsvRow *row, uint32_t v);
+void CsvRow_I32(CsvRow *row, int32_t v);
+void CsvRow_Fixed(CsvRow *row, int32_t raw, uint32_t divisor, uint8_t decimals);
+void CsvRow_Str(CsvRow *row, const char *s);
+/* Ends the row with '\n', returns its length or -1 when it did not fit */
+int CsvRow_End(CsvRow *row);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_NUMFMT_H_ */
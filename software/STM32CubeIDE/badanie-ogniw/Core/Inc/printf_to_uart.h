@@ -0,0 +1,39 @@
+/*
+ * printf_to_uart.h
+ *
+ *  printf output on USART3 through a DMA drained ring buffer.
+ */
+
+#ifndef INC_PRINTF_TO_UART_H_
+#define INC_PRINTF_TO_UART_H_
+
+#include "stm32f7xx_hal.h"
+
+/* Ring buffer size, power of two */
+#ifndef UARTTX_BUF_SIZE
+#define UARTTX_BUF_SIZE   2048
+#endif
+
+/* What a write does when the ring is full */
+#define UARTTX_DROP       0   /* a write that does not fit is dropped whole, no torn lines */
+#define UARTTX_BLOCK      1   /* wait for the DMA, in interrupt context keep what fits */
+#ifndef UARTTX_POLICY
+#define UARTTX_POLICY     UARTTX_DROP
+#endif
+
+#if (UARTTX_BUF_SIZE & (UARTTX_BUF_SIZE - 1)) != 0
+#error "UARTTX_BUF_SIZE must be a power of two"
+#endif
+
+typedef struct {
+  uint32_t bytes;           /* accepted into the ring */
+  uint32_t dropped;         /* lost to a full ring */
+  uint32_t dma_starts;
+  uint32_t max_used;        /* ring high water mark */
+} UARTtx_Stats;
+
+uint32_t UARTtx_Write(const void *data, uint32_t len);
+HAL_StatusTypeDef UARTtx_Flush(uint32_t timeout);
+void UARTtx_GetStats(UARTtx_Stats *stats);
+
+#endif /* INC_PRINTF_TO_UART_H_ */
@@ -0,0 +1,83 @@
+/*
+ * profiler.h
+ *
+ *  Named scope profiler: count, min/avg/max and p99 per scope in a fixed
+ *  table. Builds for the target (DWT cycle counter) and for the host
+ *  (std::chrono, software/tools/profiler_host).
+ */
+
+#ifndef INC_PROFILER_H_
+#define INC_PROFILER_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* 0 compiles the PROFILE_ macros out */
+#ifndef PROFILER_ENABLE
+#define PROFILER_ENABLE       1
+#endif
+
+#ifndef PROFILER_MAX_SCOPES
+#define PROFILER_MAX_SCOPES   16
+#endif
+
+/* 2^n histogram buckets per octave, p99 is reported within 2^-n */
+#ifndef PROFILER_SUB_BITS
+#define PROFILER_SUB_BITS     2
+#endif
+#define PROFILER_BUCKETS      (32 << PROFILER_SUB_BITS)
+
+/* Time source, PROFILER_NOW() returns a free running 32 bit count of
+   PROFILER_TICKS_PER_US per microsecond. Define both to use another clock. */
+#if defined(PROFILER_HOST)
+uint32_t Profiler_HostNow(void);
+#define PROFILER_NOW()          Profiler_HostNow()
+#define PROFILER_TICKS_PER_US   1000                /* nanoseconds */
+#elif !defined(PROFILER_NOW)
+#include "dwt.h"
+#define PROFILER_NOW()          DWT_Cycles()
+#define PROFILER_TICKS_PER_US   (SystemCoreClock / 1000000)
+#endif
+
+typedef struct {
+  const char *name;
+  uint32_t count;
+  uint32_t min;
+  uint32_t max;
+  uint64_t sum;
+  uint32_t hist[PROFILER_BUCKETS];
+} Profiler_Scope;
+
+int8_t Profiler_Register(const char *name);
+void Profiler_Record(int8_t id, uint32_t ticks);
+uint32_t Profiler_Percentile(const Profiler_Scope *scope, uint32_t permille);
+const Profiler_Scope *Profiler_Get(int8_t id);
+int Profiler_Format(char *buf, size_t size, int8_t id);
+void Profiler_Dump(void);
+void Profiler_Reset(void);
+
+/* PROFILE_BEGIN(x) ... PROFILE_END(x) in one block, x a plain identifier.
+   Main loop context only, the table is not interrupt safe. */
+#if PROFILER_ENABLE
+#define PROFILE_BEGIN(scope) \
+  static int8_t scope##_prof = -1; \
+  uint32_t scope##_t0; \
+  if (scope##_prof < 0) \
+    scope##_prof = Profiler_Register(#scope); \
+  scope##_t0 = PROFILER_NOW()
+#define PROFILE_END(scope) \
+  Profiler_Record(scope##_prof, PROFILER_NOW() - scope##_t0)
+#else
+#define PROFILE_BEGIN(scope)
+#define PROFILE_END(scope)
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_PROFILER_H_ */
@@ -0,0 +1,46 @@
+/*
+ * scheduler.h
+ *
+ *  Cooperative run to completion task scheduler.
+ */
+
+#ifndef INC_SCHEDULER_H_
+#define INC_SCHEDULER_H_
+
+#include <stdint.h>
+
+typedef struct Sched_Task Sched_Task;
+typedef void (*Sched_Fn)(void *ctx);
+
+typedef struct {
+  uint32_t runs;
+  uint32_t overruns;        /* releases lost because the task was still pending */
+  uint32_t deadline_misses; /* finished later than deadline_ms after its release */
+  uint32_t max_latency_ms;  /* release to start */
+  uint32_t max_exec_ms;
+} Sched_Stats;
+
+/* One task, owned by the caller for as long as it is scheduled */
+struct Sched_Task {
+  const char *name;
+  Sched_Fn fn;
+  void *ctx;
+  uint32_t period_ms;       /* 0: runs only when released with Sched_Release */
+  uint8_t prio;             /* higher runs first when several are due */
+  uint32_t deadline_ms;     /* 0: same as the period */
+
+  /* scheduler internal */
+  uint32_t release;
+  volatile uint8_t released;
+  int8_t prof;              /* profiler scope, run time under the task name */
+  Sched_Stats stats;
+  Sched_Task *next;
+};
+
+void Sched_Add(Sched_Task *task);
+void Sched_Release(Sched_Task *task);
+uint8_t Sched_Run(void);
+void Sched_ResetStats(void);
+void Sched_Print(void);
+
+#endif /* INC_SCHEDULER_H_ */
@@ -0,0 +1,80 @@
+/*
+ * sd_log.h
+ *
+ *  RAM staged writer for the SD card measurement log.
+ */
+
+#ifndef INC_SD_LOG_H_
+#define INC_SD_LOG_H_
+
+#include "ff.h"
+
+/* Bytes collected in RAM before they go to the card in one f_write.
+   Multiple of 512, chunks are aligned to this size within the file so FatFs
+   hands whole sectors to SD_disk_write (CMD25 + ACMD23) without a
+   read-modify-write of a partial sector. */
+#ifndef SDLOG_CHUNK_SIZE
+#define SDLOG_CHUNK_SIZE 8192
+#endif
+
+/* Sector size of the card, contiguous mode writes sectors directly */
+#define SDLOG_SECTOR_SIZE 512
+
+/* Default group commit policy, 0 disables a trigger.
+   A commit writes the staged rows and runs f_sync (FAT + directory entry). */
+#ifndef SDLOG_SYNC_ROWS
+#define SDLOG_SYNC_ROWS  0        /* every N rows */
+#endif
+#ifndef SDLOG_SYNC_MS
+#define SDLOG_SYNC_MS    60000    /* every T milliseconds */
+#endif
+#ifndef SDLOG_SYNC_BYTES
+#define SDLOG_SYNC_BYTES 0        /* when unsynced bytes pass the threshold */
+#endif
+
+typedef struct {
+  uint32_t rows;
+  uint32_t ms;
+  uint32_t bytes;
+} SDlog_SyncPolicy;
+
+typedef enum {
+  SDLOG_SYNC_BY_ROWS,
+  SDLOG_SYNC_BY_TIME,
+  SDLOG_SYNC_BY_BYTES,
+  SDLOG_SYNC_FORCED,        /* close, error paths, explicit SDlog_Sync */
+  SDLOG_SYNC_REASONS
+} SDlog_SyncReason;
+
+typedef struct {
+  uint32_t rows;            /* SDlog_Write calls */
+  uint32_t bytes;           /* bytes accepted by SDlog_Write */
+  uint32_t chunks;          /* aligned chunk writes */
+  uint32_t chunk_sectors;   /* sectors written by chunk writes */
+  uint32_t syncs[SDLOG_SYNC_REASONS];
+  uint32_t sync_sectors[SDLOG_SYNC_REASONS]; /* sectors written by each commit type */
+  uint32_t spills;          /* contiguous area full, continued with f_write */
+  uint32_t errors;          /* failed f_write / f_sync */
+} SDlog_Stats;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+FRESULT SDlog_Open(FIL *fil);
+FRESULT SDlog_OpenContiguous(FIL *fil, FSIZE_t size);
+FRESULT SDlog_Write(const void *data, UINT len);
+FRESULT SDlog_Poll(void);
+FRESULT SDlog_Sync(void);
+FRESULT SDlog_Close(void);
+void SDlog_SetSyncPolicy(const SDlog_SyncPolicy *policy);
+void SDlog_GetSyncPolicy(SDlog_SyncPolicy *policy);
+UINT SDlog_Pending(void);
+FSIZE_t SDlog_Free(void);   /* contiguous mode, preallocated bytes left */
+void SDlog_GetStats(SDlog_Stats *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_SD_LOG_H_ */
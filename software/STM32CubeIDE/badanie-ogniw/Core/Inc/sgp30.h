@@ -66,6 +66,8 @@ s16 sgp_read_signals(u16 *scaled_ethanol_signal, u16 *scaled_h2_signal);
 
 s16 sgp_measure_test(u16 *test_result);
 
+u32 sgp_get_profile_duration_us(u16 number);
+
 s16 sgp_set_absolute_humidity(u32 absolute_humidity);
 
 #ifdef __cplusplus
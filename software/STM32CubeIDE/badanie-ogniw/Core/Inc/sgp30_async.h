@@ -0,0 +1,47 @@
+/*
+ * sgp30_async.h
+ *
+ *  Non-blocking SGP30 measurement cycle (IAQ, then raw signals).
+ */
+
+#ifndef INC_SGP30_ASYNC_H_
+#define INC_SGP30_ASYNC_H_
+
+#include "sgp30.h"
+
+/* A result collected later than this past its deadline counts as missed */
+#ifndef SGPASYNC_LATE_MS
+#define SGPASYNC_LATE_MS 5
+#endif
+
+typedef enum {
+  SGPASYNC_IDLE,
+  SGPASYNC_IAQ_WAIT,        /* measure_iaq issued */
+  SGPASYNC_SIGNALS_WAIT,    /* measure_signals issued */
+  SGPASYNC_DONE,
+  SGPASYNC_ERROR
+} SGPasync_State;
+
+typedef struct {
+  uint16_t tvoc_ppb;
+  uint16_t co2_eq_ppm;
+  uint16_t scaled_ethanol_signal;
+  uint16_t scaled_h2_signal;
+} SGPasync_Result;
+
+typedef struct {
+  uint32_t cycles;          /* completed measurement cycles */
+  uint32_t missed;          /* results collected after deadline + SGPASYNC_LATE_MS,
+                               or a new cycle requested before the last one ended */
+  uint32_t errors;          /* command or read failures */
+  uint32_t max_late_ms;     /* worst collection delay past a deadline */
+} SGPasync_Stats;
+
+s16 SGPasync_Start(void);
+void SGPasync_Poll(void);
+SGPasync_State SGPasync_GetState(void);
+uint8_t SGPasync_Busy(void);
+s16 SGPasync_GetResult(SGPasync_Result *result);
+void SGPasync_GetStats(SGPasync_Stats *stats);
+
+#endif /* INC_SGP30_ASYNC_H_ */
@@ -0,0 +1,139 @@
+/*
+ * spi_bus.h
+ *
+ *  Per-device configuration of the shared SPI1 bus.
+ */
+
+#ifndef INC_SPI_BUS_H_
+#define INC_SPI_BUS_H_
+
+#include "stm32f7xx_hal.h"
+
+/* Device clock profiles, SPI1 runs from PCLK2 (72 MHz) */
+#ifndef SPIBUS_SD_INIT_PRESCALER
+#define SPIBUS_SD_INIT_PRESCALER  SPI_BAUDRATEPRESCALER_256  /* 281 kHz, card identification <= 400 kHz */
+#endif
+#ifndef SPIBUS_SD_DATA_PRESCALER
+#define SPIBUS_SD_DATA_PRESCALER  SPI_BAUDRATEPRESCALER_4    /* 18 MHz, SD default speed <= 25 MHz */
+#endif
+#ifndef SPIBUS_SD_MIN_PRESCALER
+#define SPIBUS_SD_MIN_PRESCALER   SPI_BAUDRATEPRESCALER_64   /* slowest data clock the self-test steps down to */
+#endif
+#ifndef SPIBUS_BMP280_PRESCALER
+#define SPIBUS_BMP280_PRESCALER   SPI_BAUDRATEPRESCALER_8    /* 9 MHz, BMP280 <= 10 MHz */
+#endif
+#ifndef SPIBUS_ST7735_PRESCALER
+#define SPIBUS_ST7735_PRESCALER   SPI_BAUDRATEPRESCALER_8    /* 9 MHz, ST7735 write cycle >= 66 ns */
+#endif
+
+/* Transfers shorter than this are polled, DMA setup costs more. Never
+   from interrupt context, there they use DMA as well. */
+#ifndef SPIBUS_DMA_MIN
+#define SPIBUS_DMA_MIN            8
+#endif
+
+/* Longest chip select cycle of a queued transfer in bytes, even. A high
+   priority transfer waits at most about two of these (SPIbus_TimeoutMs). */
+#ifndef SPIBUS_CHUNK
+#define SPIBUS_CHUNK              1024
+#endif
+#if (SPIBUS_CHUNK & 1) || SPIBUS_CHUNK > 0xFFFE
+#error "SPIBUS_CHUNK must be even and at most 0xFFFE"
+#endif
+
+/* A queued transfer gains one priority level per SPIBUS_AGING_MS of waiting */
+#ifndef SPIBUS_AGING_MS
+#define SPIBUS_AGING_MS           20
+#endif
+
+#define SPIBUS_PRIO_LOW           0         /* display */
+#define SPIBUS_PRIO_NORMAL        1
+#define SPIBUS_PRIO_HIGH          2         /* sensors */
+
+typedef enum {
+  SPIBUS_SD,
+  SPIBUS_BMP280,
+  SPIBUS_ST7735,
+  SPIBUS_DEVICES
+} SPIbus_Id;
+
+typedef struct {
+  GPIO_TypeDef *cs_port;
+  uint16_t cs_pin;
+  uint32_t prescaler;       /* SPI_BAUDRATEPRESCALER_x */
+  uint32_t polarity;        /* SPI_POLARITY_x */
+  uint32_t phase;           /* SPI_PHASE_x */
+} SPIbus_Device;
+
+typedef enum {
+  SPIBUS_IDLE,
+  SPIBUS_QUEUED,
+  SPIBUS_ACTIVE,
+  SPIBUS_DONE,
+  SPIBUS_ERROR
+} SPIbus_State;
+
+typedef struct SPIbus_Xfer SPIbus_Xfer;
+typedef void (*SPIbus_Callback)(SPIbus_Xfer *xfer);
+
+/* One transaction, owned by the caller until it reaches DONE / ERROR.
+   Each chunk runs in its own chip select cycle. */
+struct SPIbus_Xfer {
+  SPIbus_Id dev;
+  uint8_t prio;             /* SPIBUS_PRIO_x */
+  const uint8_t *tx;
+  uint8_t *rx;              /* NULL: transmit only, may equal tx */
+  uint32_t len;
+  uint16_t chunk;           /* 0: whole transfer, else split so other
+                               transfers can run in between */
+  uint8_t repeat;           /* tx is one 16 bit word sent len / 2 times
+                               MSB first, transmit only, len and chunk even */
+  SPIbus_Callback setup;    /* before CS goes low, e.g. ST7735 D/C line */
+  SPIbus_Callback done;     /* from the completion interrupt */
+  void *ctx;
+
+  /* bus internal */
+  volatile SPIbus_State state;
+  uint32_t pos;
+  uint16_t n;
+  uint32_t queued;
+  SPIbus_Xfer *next;
+};
+
+typedef struct {
+  uint32_t xfers;           /* completed transactions */
+  uint32_t chunks;          /* chip select cycles */
+  uint32_t bytes;
+  uint32_t errors;
+  uint32_t max_wait_ms;     /* submit to first chunk */
+} SPIbus_Stats;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Queued transfers */
+void SPIbus_Submit(SPIbus_Xfer *xfer);
+HAL_StatusTypeDef SPIbus_Transfer(SPIbus_Xfer *xfer, uint32_t timeout);
+void SPIbus_Cancel(SPIbus_Xfer *xfer);
+uint32_t SPIbus_TimeoutMs(SPIbus_Id id, uint32_t len);   /* worst case for SPIbus_Transfer */
+void SPIbus_GetStats(SPIbus_Id id, SPIbus_Stats *stats);
+
+/* Exclusive use by a driver with long CS cycles (SD card) */
+void SPIbus_Lock(SPIbus_Id id);
+void SPIbus_Unlock(void);
+HAL_StatusTypeDef SPIbus_LockedDma(const uint8_t *tx, uint8_t *rx, uint16_t len, uint32_t timeout);
+
+/* Device configuration */
+void SPIbus_Configure(SPIbus_Id id);
+void SPIbus_Select(SPIbus_Id id);
+void SPIbus_Deselect(SPIbus_Id id);
+void SPIbus_SetPrescaler(SPIbus_Id id, uint32_t prescaler);
+uint32_t SPIbus_GetPrescaler(SPIbus_Id id);
+uint32_t SPIbus_GetClockHz(SPIbus_Id id);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_SPI_BUS_H_ */
@@ -17,6 +17,26 @@
 #define ST7735_SPI_PORT hspi1
 extern SPI_HandleTypeDef ST7735_SPI_PORT;
 
+// bytes per CS cycle of a long data write, sensor transfers can run between
+#define ST7735_SPI_CHUNK 1024
+
+// bytes per CS cycle of a fill, 0: the bus limit (SPIBUS_CHUNK)
+#ifndef ST7735_FILL_CHUNK
+#define ST7735_FILL_CHUNK 0
+#endif
+
+// command and data writes queued ahead of the panel, a full queue makes
+// the caller wait for a slot
+#ifndef ST7735_QUEUE_OPS
+#define ST7735_QUEUE_OPS 32
+#endif
+
+// writes up to this size are copied into the queue
+#define ST7735_INLINE_BYTES 8
+
+// tallest font a string row is buffered for (Font_16x26), taller ones go per glyph
+#define ST7735_TEXT_MAX_HEIGHT 26
+
 #define ST7735_RES_Pin       GPIO_PIN_14
 #define ST7735_RES_GPIO_Port GPIOF
 #define ST7735_CS_Pin        GPIO_PIN_13
@@ -195,6 +215,8 @@ extern SPI_HandleTypeDef ST7735_SPI_PORT;
 #define ST7735_RAMRD   0x2E
 
 #define ST7735_PTLAR   0x30
+#define ST7735_VSCRDEF 0x33
+#define ST7735_VSCRSADD 0x37
 #define ST7735_COLMOD  0x3A
 #define ST7735_MADCTL  0x36
 
@@ -232,6 +254,15 @@ extern SPI_HandleTypeDef ST7735_SPI_PORT;
 #define ST7735_WHITE   0xFFFF
 #define ST7735_COLOR565(r, g, b) (((r & 0xF8) << 8) | ((g & 0xFC) << 3) | ((b & 0xF8) >> 3))
 
+// SPI transactions, each command and data write is one chip select cycle
+// or more (ST7735_SPI_CHUNK)
+typedef struct {
+    uint32_t commands;
+    uint32_t data_writes;
+    uint32_t bytes;
+    uint32_t errors;        // failed bus transfers, the panel misses them
+} ST7735_Stats;
+
 typedef enum {
 	GAMMA_10 = 0x01,
 	GAMMA_25 = 0x02,
@@ -256,6 +287,16 @@ void ST7735_FillScreenFast(uint16_t color);
 void ST7735_DrawImage(uint16_t x, uint16_t y, uint16_t w, uint16_t h, const uint16_t* data);
 void ST7735_InvertColors(bool invert);
 void ST7735_SetGamma(GammaDef gamma);
+void ST7735_SetScrollArea(uint16_t top, uint16_t lines, uint16_t bottom);
+void ST7735_SetScrollStart(uint16_t line);
+void ST7735_GetStats(ST7735_Stats *stats);
+
+// Drawing calls queue their writes and return before they reach the panel.
+// ST7735_DrawImage sends from the caller's buffer: it must stay unchanged
+// until ST7735_Wait returns or ST7735_Busy reads 0. Everything else is
+// copied or kept by the driver.
+void ST7735_Wait(void);
+uint8_t ST7735_Busy(void);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,71 @@
+/*
+ * st7735_fb.h
+ *
+ *  Off-screen framebuffer for the ST7735. Drawing only touches RAM and
+ *  records dirty rectangles, FB_Flush sends each of them to the panel as
+ *  one windowed transfer. Builds for the host with FB_HOST
+ *  (software/tools/fb_host), the transfers then go to FB_HostSend.
+ */
+
+#ifndef INC_ST7735_FB_H_
+#define INC_ST7735_FB_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include "fonts.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Panel size in the configured rotation, same as ST7735_WIDTH/HEIGHT */
+#define FB_WIDTH        128
+#define FB_HEIGHT       160
+
+/* Dirty rectangles kept between flushes, more get merged */
+#ifndef FB_MAX_DIRTY
+#define FB_MAX_DIRTY    8
+#endif
+
+/* Staging buffer for rectangles narrower than the screen, in pixels */
+#ifndef FB_STAGE_PIXELS
+#define FB_STAGE_PIXELS 2048
+#endif
+
+#ifdef FB_HOST
+/* w x h pixels in panel byte order for the window at x, y */
+void FB_HostSend(uint16_t x, uint16_t y, uint16_t w, uint16_t h, const uint16_t *data);
+#endif
+
+typedef struct {
+  uint16_t x0, y0, x1, y1;      /* inclusive */
+} FB_Rect;
+
+typedef struct {
+  uint32_t flushes;
+  uint32_t rects;               /* windowed transfers */
+  uint32_t pixels;              /* pixels sent */
+} FB_Stats;
+
+void FB_Init(void);
+void FB_Fill(uint16_t color);
+void FB_DrawPixel(uint16_t x, uint16_t y, uint16_t color);
+void FB_FillRect(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color);
+void FB_DrawRect(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color);
+void FB_DrawLine(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, uint16_t color);
+void FB_WriteChar(uint16_t x, uint16_t y, char ch, FontDef font, uint16_t color, uint16_t bgcolor);
+void FB_WriteString(uint16_t x, uint16_t y, const char *str, FontDef font, uint16_t color, uint16_t bgcolor);
+/* data in panel byte order, as for ST7735_DrawImage */
+void FB_DrawImage(uint16_t x, uint16_t y, uint16_t w, uint16_t h, const uint16_t *data);
+uint16_t FB_GetPixel(uint16_t x, uint16_t y);
+
+void FB_Invalidate(uint16_t x, uint16_t y, uint16_t w, uint16_t h);
+uint8_t FB_DirtyCount(void);
+uint32_t FB_Flush(void);
+void FB_GetStats(FB_Stats *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_ST7735_FB_H_ */
@@ -0,0 +1,139 @@
+/*
+ * telemetry.h
+ *
+ *  Binary live telemetry on USART3, shared by the firmware and the host
+ *  decoder (software/tools/telemetry_decoder). Only depends on <stdint.h>.
+ *
+ *  Frame on the wire: 0x00, COBS(packet), 0x00. The leading delimiter
+ *  closes any text printed between two frames, so printf output on the
+ *  same UART costs one rejected frame instead of a corrupted one.
+ *  Packet: TelemHeader, the values of the channels set in the bitmap in
+ *  channel order, CRC-16/CCITT-FALSE (Log_Crc16) over both. All values
+ *  are little endian.
+ */
+
+#ifndef INC_TELEMETRY_H_
+#define INC_TELEMETRY_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include "log_record.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define TELEM_VERSION       1
+#define TELEM_TYPE_SAMPLE   1
+
+/* Channels, bit n of TelemHeader.channels; value = raw / divisor */
+enum {
+  TELEM_CH_PRESSURE,            /* Pa */
+  TELEM_CH_TEMPERATURE,         /* 0.01 degC */
+  TELEM_CH_TVOC,                /* ppb */
+  TELEM_CH_CO2_EQ,              /* ppm */
+  TELEM_CH_ETHANOL,             /* raw signal scaled by 512 */
+  TELEM_CH_H2,                  /* raw signal scaled by 512 */
+  TELEM_CH_VOLTAGE,             /* mV */
+  TELEM_CH_CURRENT,             /* mA */
+  TELEM_CH_POWER,               /* mW */
+  TELEM_CH_ADC,                 /* ADC1 channel 0 average, 12 bit */
+  TELEM_CH_CHARGE,              /* uAh since start, integrated current */
+  TELEM_CH_ENERGY,              /* uWh since start, integrated power */
+  TELEM_CHANNELS
+};
+
+#define TELEM_MASK(ch)      ((uint32_t)1 << (ch))
+#define TELEM_ALL           (TELEM_MASK(TELEM_CHANNELS) - 1)
+
+typedef struct {
+  const char *name;
+  uint8_t type;                 /* LOG_TYPE_x */
+  uint16_t divisor;
+} TelemChannel;
+
+static const TelemChannel Telem_Channels[TELEM_CHANNELS] = {
+  { "pressure",    LOG_TYPE_I32, 1    },
+  { "temperature", LOG_TYPE_I16, 100  },
+  { "tvoc_ppb",    LOG_TYPE_U16, 1    },
+  { "co2_eq_ppm",  LOG_TYPE_U16, 1    },
+  { "ethanol",     LOG_TYPE_U16, 512  },
+  { "h2",          LOG_TYPE_U16, 512  },
+  { "voltage_mV",  LOG_TYPE_U16, 1    },
+  { "current_mA",  LOG_TYPE_I16, 1    },
+  { "power_mW",    LOG_TYPE_U16, 1    },
+  { "adc",         LOG_TYPE_U16, 1    },
+  { "charge_mAh",  LOG_TYPE_I32, 1000 },
+  { "energy_mWh",  LOG_TYPE_I32, 1000 },
+};
+
+typedef struct __attribute__((packed)) {
+  uint8_t  type;                /* TELEM_TYPE_SAMPLE */
+  uint8_t  version;             /* TELEM_VERSION */
+  uint16_t seq;                 /* increments by one per packet */
+  uint32_t time_ms;             /* HAL tick */
+  uint32_t channels;            /* bitmap of the values that follow */
+} TelemHeader;
+
+#define TELEM_MAX_PACKET    (sizeof(TelemHeader) + 4 * TELEM_CHANNELS + 2)
+#define TELEM_MAX_FRAME     (TELEM_MAX_PACKET + TELEM_MAX_PACKET / 254 + 3)
+
+static inline uint8_t Telem_ValueSize(uint8_t type)
+{
+  return (type == LOG_TYPE_U32 || type == LOG_TYPE_I32) ? 4 : 2;
+}
+
+/* COBS encode, returns the encoded length (no delimiters) */
+static inline size_t Telem_CobsEncode(const uint8_t *in, size_t len, uint8_t *out)
+{
+  size_t code_pos = 0, o = 1;
+  uint8_t code = 1;
+
+  for (size_t i = 0; i < len; i++)
+  {
+    if (in[i])
+    {
+      out[o++] = in[i];
+      code++;
+    }
+    if (!in[i] || code == 0xFF)
+    {
+      out[code_pos] = code;
+      code_pos = o++;
+      code = 1;
+    }
+  }
+  out[code_pos] = code;
+  return o;
+}
+
+/* COBS decode, returns the decoded length or 0 on a malformed frame */
+static inline size_t Telem_CobsDecode(const uint8_t *in, size_t len, uint8_t *out)
+{
+  size_t i = 0, o = 0;
+
+  while (i < len)
+  {
+    uint8_t code = in[i++];
+
+    if (code == 0 || i + code - 1 > len)
+      return 0;
+    for (uint8_t k = 1; k < code; k++)
+      out[o++] = in[i++];
+    if (code != 0xFF && i < len)
+      out[o++] = 0;
+  }
+  return o;
+}
+
+/* Firmware side (telemetry.c) */
+struct sensors;
+void Telemetry_Init(uint32_t baudrate);
+void Telemetry_Mark(uint32_t channels);
+void Telemetry_Send(const struct sensors *s, uint32_t time_ms, uint8_t full);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_TELEMETRY_H_ */
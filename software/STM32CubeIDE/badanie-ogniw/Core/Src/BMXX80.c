@@ -8,16 +8,14 @@
  *      www.msalamon.pl
  *
  */
-#define BMP_CS_GPIO_Port GPIOE
-#define BMP_CS_Pin GPIO_PIN_9
-
-
 #include "main.h"
 #include "stm32f7xx_hal.h"
 //#include "gpio.h"
 #include "BMPXX80.h"
+#include "spi_bus.h"
 
 #include "math.h"
+#include <string.h>
 
 #ifdef BMP180
 #include "delays.h"
@@ -31,10 +29,45 @@
 #if(BMP_I2C == 1)
 I2C_HandleTypeDef *i2c_h;
 #endif
+// First bus failure since BMP280_GetBusStatus, register reads return
+// garbage after one
+static HAL_StatusTypeDef BusStatus = HAL_OK;
+
+static HAL_StatusTypeDef BMP280_BusResult(HAL_StatusTypeDef res)
+{
+	if(res != HAL_OK && BusStatus == HAL_OK)
+		BusStatus = res;
+	return res;
+}
+
 #if(BMP_SPI == 1)
 SPI_HandleTypeDef *spi_h;
+
+/* One register access in a single chip select cycle, queued on the
+   shared bus ahead of display transfers. The timeout covers the display
+   and SD chunks that may be on the bus first. */
+static HAL_StatusTypeDef BMP280_SpiTransfer(uint8_t *buf, uint16_t len)
+{
+	SPIbus_Xfer xfer = {
+		.dev = SPIBUS_BMP280,
+		.prio = SPIBUS_PRIO_HIGH,
+		.tx = buf,
+		.rx = buf,
+		.len = len,
+	};
+
+	return BMP280_BusResult(SPIbus_Transfer(&xfer, SPIbus_TimeoutMs(SPIBUS_BMP280, len)));
+}
 #endif
 
+HAL_StatusTypeDef BMP280_GetBusStatus(void)
+{
+	HAL_StatusTypeDef res = BusStatus;
+
+	BusStatus = HAL_OK;
+	return res;
+}
+
 #ifdef BMP180
 uint8_t oversampling;
 int16_t ac1, ac2, ac3, b1, b2, mb, mc, md;
@@ -78,9 +111,7 @@ uint8_t BMP280_Read8(uint8_t addr)
     uint8_t tmp[2];
 	tmp[0] = addr;
 	tmp[0] |= (1<<7);
-	HAL_GPIO_WritePin(BMP_CS_GPIO_Port, BMP_CS_Pin, GPIO_PIN_RESET);
-	HAL_SPI_TransmitReceive(spi_h, tmp, tmp, 2, 10);
-	HAL_GPIO_WritePin(BMP_CS_GPIO_Port, BMP_CS_Pin, GPIO_PIN_SET);
+	BMP280_SpiTransfer(tmp, 2);
 	return tmp[1];
 #endif
 }
@@ -96,9 +127,7 @@ uint8_t BME280_Read8(uint8_t addr)
   uint8_t tmp[2];
 	tmp[0] = addr;
 	tmp[0] |= (1<<7);
-	HAL_GPIO_WritePin(BMP_CS_GPIO_Port, BMP_CS_Pin, GPIO_PIN_RESET);
-	HAL_SPI_TransmitReceive(spi_h, tmp, tmp, 2, 10);
-	HAL_GPIO_WritePin(BMP_CS_GPIO_Port, BMP_CS_Pin, GPIO_PIN_SET);
+	BMP280_SpiTransfer(tmp, 2);
 	return tmp[1];
 }
 #endif
@@ -126,9 +155,7 @@ uint16_t BMP280_Read16(uint8_t addr)
 	uint8_t tmp[3];
 	tmp[0] = addr;
 	tmp[0] |= (1<<7);
-	HAL_GPIO_WritePin(BMP_CS_GPIO_Port, BMP_CS_Pin, GPIO_PIN_RESET);
-	HAL_SPI_TransmitReceive(spi_h, tmp, tmp, 3, 10);
-	HAL_GPIO_WritePin(BMP_CS_GPIO_Port, BMP_CS_Pin, GPIO_PIN_SET);
+	BMP280_SpiTransfer(tmp, 3);
 	return ((tmp[1] << 8) | tmp[2]);
 #endif
 }
@@ -153,9 +180,7 @@ uint16_t BME280_Read16(uint8_t addr)
 	uint8_t tmp[3];
 	tmp[0] = addr;
 	tmp[0] |= (1<<7);
-	HAL_GPIO_WritePin(BMP_CS_GPIO_Port, BMP_CS_Pin, GPIO_PIN_RESET);
-	HAL_SPI_TransmitReceive(spi_h, tmp, tmp, 3, 10);
-	HAL_GPIO_WritePin(BMP_CS_GPIO_Port, BMP_CS_Pin, GPIO_PIN_SET);
+	BMP280_SpiTransfer(tmp, 3);
 	return ((tmp[1] << 8) | tmp[2]);
 #endif
 }
@@ -186,28 +211,36 @@ void BMP280_Write8(uint8_t address, uint8_t data)
 	tmp[0] = address;
 	tmp[0] &= ~(1<<7);
 	tmp[1] = data;
-	HAL_GPIO_WritePin(BMP_CS_GPIO_Port, BMP_CS_Pin, GPIO_PIN_RESET);
-	HAL_SPI_TransmitReceive(spi_h, tmp, tmp, 2, 10);
-	HAL_GPIO_WritePin(BMP_CS_GPIO_Port, BMP_CS_Pin, GPIO_PIN_SET);
+	BMP280_SpiTransfer(tmp, 2);
 #endif
 }
 
-uint32_t BMP280_Read24(uint8_t addr)
+// Registers from addr on in one transaction, the address auto increments
+HAL_StatusTypeDef BMP280_ReadBurst(uint8_t addr, uint8_t *data, uint8_t len)
 {
+	HAL_StatusTypeDef res;
+
+	if(len > BMP280_BURST_MAX)
+		len = BMP280_BURST_MAX;
 #if(BMP_I2C == 1)
-	uint8_t tmp[3];
-	HAL_I2C_Mem_Read(i2c_h, BMP280_I2CADDR, addr, 1, tmp, 3, 10);
-	return ((tmp[0] << 16) | tmp[1] << 8 | tmp[2]);
+	res = BMP280_BusResult(HAL_I2C_Mem_Read(i2c_h, BMP280_I2CADDR, addr, 1, data, len, 10));
 #endif
 #if(BMP_SPI == 1)
-	uint8_t tmp[4];
+	uint8_t tmp[BMP280_BURST_MAX + 1];
 	tmp[0] = addr;
 	tmp[0] |= (1<<7);
-	HAL_GPIO_WritePin(BMP_CS_GPIO_Port, BMP_CS_Pin, GPIO_PIN_RESET);
-	HAL_SPI_TransmitReceive(spi_h, tmp, tmp, 3, 10);
-	HAL_GPIO_WritePin(BMP_CS_GPIO_Port, BMP_CS_Pin, GPIO_PIN_SET);
-	return ((tmp[1] << 16) | tmp[2] << 8 | tmp[3]);
+	res = BMP280_SpiTransfer(tmp, len + 1);
+	memcpy(data, &tmp[1], len);
 #endif
+	return res;
+}
+
+uint32_t BMP280_Read24(uint8_t addr)
+{
+	uint8_t tmp[3];
+
+	BMP280_ReadBurst(addr, tmp, 3);
+	return ((tmp[0] << 16) | tmp[1] << 8 | tmp[2]);
 }
 #endif
 #ifdef BME280
@@ -221,9 +254,7 @@ void BME280_Write8(uint8_t address, uint8_t data)
 	tmp[0] = address;
 	tmp[0] &= ~(1<<7);
 	tmp[1] = data;
-	HAL_GPIO_WritePin(BMP_CS_GPIO_Port, BMP_CS_Pin, GPIO_PIN_RESET);
-	HAL_SPI_TransmitReceive(spi_h, tmp, tmp, 2, 10);
-	HAL_GPIO_WritePin(BMP_CS_GPIO_Port, BMP_CS_Pin, GPIO_PIN_SET);
+	BMP280_SpiTransfer(tmp, 2);
 #endif
 }
 
@@ -238,9 +269,7 @@ uint32_t BME280_Read24(uint8_t addr)
 	uint8_t tmp[4];
 	tmp[0] = addr;
 	tmp[0] |= (1<<7);
-	HAL_GPIO_WritePin(BMP_CS_GPIO_Port, BMP_CS_Pin, GPIO_PIN_RESET);
-	HAL_SPI_TransmitReceive(spi_h, tmp, tmp, 3, 10);
-	HAL_GPIO_WritePin(BMP_CS_GPIO_Port, BMP_CS_Pin, GPIO_PIN_SET);
+	BMP280_SpiTransfer(tmp, 3);
 	return ((tmp[1] << 16) | tmp[2] << 8 | tmp[3]);
 #endif
 }
@@ -323,10 +352,82 @@ void BMP180_Init(I2C_HandleTypeDef *i2c_handler, uint8_t mode)
 }
 #endif
 #ifdef BMP280
+// Little endian calibration word of register reg out of the block read from BMP280_DIG_T1
+#define BMP280_CAL16(cal, reg) ((uint16_t)((cal)[(reg) - BMP280_DIG_T1] | ((cal)[(reg) - BMP280_DIG_T1 + 1] << 8)))
+
 void BMP280_SetConfig(uint8_t standby_time, uint8_t filter)
 {
 	BMP280_Write8(BMP280_CONFIG, (((standby_time & 0x7) << 5) | ((filter & 0x7) << 2)) & 0xFC);
 }
+
+// Normal mode figures from the datasheet: samples per oversampling code,
+// pressure noise of each in 0.01 Pa RMS, and the standby times of the
+// BMP280 in us (codes 6 and 7 are 2 s and 4 s, not the 10 and 20 ms of
+// the BME280). The IIR filter with coefficient c cuts white noise by
+// sqrt(2c - 1), the gain is in 1/1000.
+static const uint8_t BMP280_OsrsSamples[] = { 1, 2, 4, 8, 16 };
+static const uint16_t BMP280_NoiseCpa[] = { 262, 189, 131, 95, 66 };
+static const uint32_t BMP280_StandbyUs[] = { 500, 62500, 125000, 250000, 500000, 1000000, 2000000, 4000000 };
+static const uint16_t BMP280_FilterGain[] = { 1000, 577, 378, 258, 180 };
+
+// Maximum measurement time in us
+static uint32_t BMP280_MeasureUs(uint8_t osrs_t, uint8_t osrs_p)
+{
+	return 1250 + 2300 * BMP280_OsrsSamples[osrs_t - 1] + 2300 * BMP280_OsrsSamples[osrs_p - 1] + 575;
+}
+
+// Temperature oversampling recommended for a pressure oversampling
+static uint8_t BMP280_TemperatureFor(uint8_t osrs_p)
+{
+	return (osrs_p == BMP280_ULTRAHIGHRES) ? BMP280_TEMPERATURE_17BIT : BMP280_TEMPERATURE_16BIT;
+}
+
+uint32_t BMP280_SetRate(uint32_t period_ms, uint16_t noise_cpa)
+{
+	uint32_t period_us = period_ms * 1000;
+	uint8_t osrs_p = BMP280_ULTRALOWPOWER, filter = BME280_FILTER_OFF, found = 0;
+
+	// The filter delays the output by several samples, so as little of it
+	// as possible, then the least oversampling that fits into the period.
+	// Without a match the lowest noise that fits is kept.
+	for(uint8_t f = BME280_FILTER_OFF; f <= BME280_FILTER_X16 && !found; f++)
+	{
+		for(uint8_t p = BMP280_ULTRALOWPOWER; p <= BMP280_ULTRAHIGHRES; p++)
+		{
+			if(BMP280_MeasureUs(BMP280_TemperatureFor(p), p) > period_us)
+				break;
+			osrs_p = p;
+			filter = f;
+			if((uint32_t)BMP280_NoiseCpa[p - 1] * BMP280_FilterGain[f] <= (uint32_t)noise_cpa * 1000)
+			{
+				found = 1;
+				break;
+			}
+		}
+	}
+
+	uint8_t osrs_t = BMP280_TemperatureFor(osrs_p);
+	uint32_t meas_us = BMP280_MeasureUs(osrs_t, osrs_p);
+
+	// Longest standby that still gives a new result every period
+	uint8_t standby = BME280_STANDBY_MS_0_5;
+	for(uint8_t sb = 0; sb < 8; sb++)
+	{
+		if(meas_us + BMP280_StandbyUs[sb] <= period_us)
+			standby = sb;
+	}
+
+	// The config register may ignore writes outside sleep mode
+	BMP280_Write8(BMP280_CONTROL, (osrs_t<<5) | (osrs_p<<2) | BMP280_SLEEPMODE);
+	BMP280_SetConfig(standby, filter);
+	BMP280_Write8(BMP280_CONTROL, (osrs_t<<5) | (osrs_p<<2) | BMP280_NORMALMODE);
+
+	_temperature_res = osrs_t;
+	_pressure_oversampling = osrs_p;
+	_mode = BMP280_NORMALMODE;
+
+	return meas_us + BMP280_StandbyUs[standby];
+}
 #if(BMP_I2C == 1)
 void BMP280_Init(I2C_HandleTypeDef *i2c_handler, uint8_t temperature_resolution, uint8_t pressure_oversampling, uint8_t mode)
 {
@@ -336,9 +437,11 @@ void BMP280_Init(I2C_HandleTypeDef *i2c_handler, uint8_t temperature_resolution,
 void BMP280_Init(SPI_HandleTypeDef *spi_handler, uint8_t temperature_resolution, uint8_t pressure_oversampling, uint8_t mode)
 {
 	spi_h = spi_handler;
-	HAL_GPIO_WritePin(BMP_CS_GPIO_Port, BMP_CS_Pin, GPIO_PIN_RESET);
+	SPIbus_Lock(SPIBUS_BMP280);
+	SPIbus_Select(SPIBUS_BMP280);
 	HAL_Delay(5);
-	HAL_GPIO_WritePin(BMP_CS_GPIO_Port, BMP_CS_Pin, GPIO_PIN_SET);
+	SPIbus_Deselect(SPIBUS_BMP280);
+	SPIbus_Unlock();
 #endif
 	if (mode > BMP280_NORMALMODE)
 	    mode = BMP280_NORMALMODE;
@@ -358,20 +461,23 @@ void BMP280_Init(SPI_HandleTypeDef *spi_handler, uint8_t temperature_resolution,
 
 	while(BMP280_Read8(BMP280_CHIPID) != 0x58);
 
-	/* read calibration data */
-	t1 = BMP280_Read16LE(BMP280_DIG_T1);
-	t2 = BMP280_Read16LE(BMP280_DIG_T2);
-	t3 = BMP280_Read16LE(BMP280_DIG_T3);
-
-	p1 = BMP280_Read16LE(BMP280_DIG_P1);
-	p2 = BMP280_Read16LE(BMP280_DIG_P2);
-	p3 = BMP280_Read16LE(BMP280_DIG_P3);
-	p4 = BMP280_Read16LE(BMP280_DIG_P4);
-	p5 = BMP280_Read16LE(BMP280_DIG_P5);
-	p6 = BMP280_Read16LE(BMP280_DIG_P6);
-	p7 = BMP280_Read16LE(BMP280_DIG_P7);
-	p8 = BMP280_Read16LE(BMP280_DIG_P8);
-	p9 = BMP280_Read16LE(BMP280_DIG_P9);
+	/* read calibration data, the whole block in one transaction */
+	uint8_t cal[BMP280_CALIB_LEN];
+	BMP280_ReadBurst(BMP280_DIG_T1, cal, BMP280_CALIB_LEN);
+
+	t1 = BMP280_CAL16(cal, BMP280_DIG_T1);
+	t2 = BMP280_CAL16(cal, BMP280_DIG_T2);
+	t3 = BMP280_CAL16(cal, BMP280_DIG_T3);
+
+	p1 = BMP280_CAL16(cal, BMP280_DIG_P1);
+	p2 = BMP280_CAL16(cal, BMP280_DIG_P2);
+	p3 = BMP280_CAL16(cal, BMP280_DIG_P3);
+	p4 = BMP280_CAL16(cal, BMP280_DIG_P4);
+	p5 = BMP280_CAL16(cal, BMP280_DIG_P5);
+	p6 = BMP280_CAL16(cal, BMP280_DIG_P6);
+	p7 = BMP280_CAL16(cal, BMP280_DIG_P7);
+	p8 = BMP280_CAL16(cal, BMP280_DIG_P8);
+	p9 = BMP280_CAL16(cal, BMP280_DIG_P9);
 
 	BMP280_Write8(BMP280_CONTROL, ((temperature_resolution<<5) | (pressure_oversampling<<2) | mode));
 }
@@ -398,9 +504,11 @@ void BME280_Init(I2C_HandleTypeDef *i2c_handler, uint8_t temperature_resolution,
 void BME280_Init(SPI_HandleTypeDef *spi_handler, uint8_t temperature_resolution, uint8_t pressure_oversampling, uint8_t huminidity_oversampling, uint8_t mode)
 {
 	spi_h = spi_handler;
-	HAL_GPIO_WritePin(BMP_CS_GPIO_Port, BMP_CS_Pin, GPIO_PIN_RESET);
+	SPIbus_Lock(SPIBUS_BMP280);
+	SPIbus_Select(SPIBUS_BMP280);
 	HAL_Delay(5);
-	HAL_GPIO_WritePin(BMP_CS_GPIO_Port, BMP_CS_Pin, GPIO_PIN_SET);
+	SPIbus_Deselect(SPIBUS_BMP280);
+	SPIbus_Unlock();
 #endif
 	uint8_t HumReg, i;
 
@@ -485,9 +593,12 @@ float BMP180_ReadTemperature(void)
 }
 #endif
 #ifdef BMP280
-float BMP280_ReadTemperature(void)
+// In forced mode start a conversion and wait for it. 0 when there are results
+// to read, in normal mode the latest without waiting
+static uint8_t BMP280_Measure(void)
 {
-  int32_t var1, var2;
+  if(_mode == BMP280_SLEEPMODE)
+	  return 1;
 
   if(_mode == BMP280_FORCEDMODE)
   {
@@ -500,34 +611,91 @@ float BMP280_ReadTemperature(void)
 	  mode = BMP280_Read8(BMP280_CONTROL); 	// Read written mode
 	  mode &= 0x03;							// Do not work without it...
 
-	  if(mode == BMP280_FORCEDMODE)
+	  if(mode != BMP280_FORCEDMODE)
+		  return 1;
+
+	  // Wait for end of conversion, at most the datasheet maximum
+	  uint32_t start = HAL_GetTick();
+	  uint32_t timeout = BMP280_MeasureUs(_temperature_res, _pressure_oversampling) / 1000 + 2;
+	  while(1)
 	  {
-		  while(1) // Wait for end of conversion
-		  {
-			  mode = BMP280_Read8(BMP280_CONTROL);
-			  mode &= 0x03;
-			  if(mode == BMP280_SLEEPMODE)
-				  break;
-		  }
+		  mode = BMP280_Read8(BMP280_CONTROL);
+		  mode &= 0x03;
+		  if(mode == BMP280_SLEEPMODE)
+			  break;
+		  if(BusStatus != HAL_OK || HAL_GetTick() - start > timeout)
+			  return 1;
+	  }
+  }
+  return 0;
+}
+
+// Raw value of a skipped measurement, also there until the first conversion ends
+#define BMP280_RAW_NONE 0x80000
+
+// 20 bit reading out of its msb, lsb and xlsb registers
+static int32_t BMP280_Raw20(const uint8_t *data)
+{
+  return ((int32_t)data[0] << 12) | ((int32_t)data[1] << 4) | (data[2] >> 4);
+}
 
-		  int32_t adc_T = BMP280_Read24(BMP280_TEMPDATA);
-		  adc_T >>= 4;
+// Temperature in 0.01 degC, also sets t_fine for the pressure
+static int32_t BMP280_CompensateTemperature(int32_t adc_T)
+{
+  int32_t var1, var2;
 
-		  var1  = ((((adc_T>>3) - ((int32_t)t1 <<1))) *
-				  ((int32_t)t2)) >> 11;
+  var1  = ((((adc_T>>3) - ((int32_t)t1 <<1))) *
+		  ((int32_t)t2)) >> 11;
 
-		  var2  = (((((adc_T>>4) - ((int32_t)t1)) *
-				  ((adc_T>>4) - ((int32_t)t1))) >> 12) *
-				  ((int32_t)t3)) >> 14;
+  var2  = (((((adc_T>>4) - ((int32_t)t1)) *
+		  ((adc_T>>4) - ((int32_t)t1))) >> 12) *
+		  ((int32_t)t3)) >> 14;
 
-		  t_fine = var1 + var2;
+  t_fine = var1 + var2;
 
-		  float T  = (t_fine * 5 + 128) >> 8;
-		  return T/100;
-	  }
+  return (t_fine * 5 + 128) >> 8;
+}
+
+// Pressure in Pa, t_fine from the temperature of the same conversion
+static int32_t BMP280_CompensatePressure(int32_t adc_P)
+{
+  int64_t var1, var2, p;
+
+  var1 = ((int64_t)t_fine) - 128000;
+  var2 = var1 * var1 * (int64_t)p6;
+  var2 = var2 + ((var1*(int64_t)p5)<<17);
+  var2 = var2 + (((int64_t)p4)<<35);
+  var1 = ((var1 * var1 * (int64_t)p3)>>8) +
+    ((var1 * (int64_t)p2)<<12);
+  var1 = (((((int64_t)1)<<47)+var1))*((int64_t)p1)>>33;
+
+  if (var1 == 0) {
+    return 0;  // avoid exception caused by division by zero
   }
+  p = 1048576 - adc_P;
+  p = (((p<<31) - var2)*3125) / var1;
+  var1 = (((int64_t)p9) * (p>>13) * (p>>13)) >> 25;
+  var2 = (((int64_t)p8) * p) >> 19;
 
-  return -99;
+  p = ((p + var1 + var2) >> 8) + (((int64_t)p7)<<4);
+  return (int32_t)p/256;
+}
+
+float BMP280_ReadTemperature(void)
+{
+  uint8_t data[3];
+
+  BusStatus = HAL_OK;
+  if(BMP280_Measure())
+	  return -99;
+
+  if(BMP280_ReadBurst(BMP280_TEMPDATA, data, 3) != HAL_OK || BusStatus != HAL_OK)
+	  return -99;
+  if(BMP280_Raw20(data) == BMP280_RAW_NONE)
+	  return -99;
+
+  float T = BMP280_CompensateTemperature(BMP280_Raw20(data));
+  return T/100;
 }
 #endif
 #ifdef BME280
@@ -625,32 +793,12 @@ int32_t BMP180_ReadPressure(void)
 #ifdef BMP280
 int32_t BMP280_ReadPressure(void)
 {
-	  int64_t var1, var2, p;
-
-	  // Must be done first to get the t_fine variable set up
-	  BMP280_ReadTemperature();
-
-	  int32_t adc_P = BMP280_Read24(BMP280_PRESSUREDATA);
-	  adc_P >>= 4;
-
-	  var1 = ((int64_t)t_fine) - 128000;
-	  var2 = var1 * var1 * (int64_t)p6;
-	  var2 = var2 + ((var1*(int64_t)p5)<<17);
-	  var2 = var2 + (((int64_t)p4)<<35);
-	  var1 = ((var1 * var1 * (int64_t)p3)>>8) +
-	    ((var1 * (int64_t)p2)<<12);
-	  var1 = (((((int64_t)1)<<47)+var1))*((int64_t)p1)>>33;
+	  float temperature;
+	  int32_t pressure = 0;
 
-	  if (var1 == 0) {
-	    return 0;  // avoid exception caused by division by zero
-	  }
-	  p = 1048576 - adc_P;
-	  p = (((p<<31) - var2)*3125) / var1;
-	  var1 = (((int64_t)p9) * (p>>13) * (p>>13)) >> 25;
-	  var2 = (((int64_t)p8) * p) >> 19;
-
-	  p = ((p + var1 + var2) >> 8) + (((int64_t)p7)<<4);
-	  return (int32_t)p/256;
+	  // Pressure needs the temperature of the same conversion anyway
+	  BMP280_ReadTemperatureAndPressure(&temperature, &pressure);
+	  return pressure;
 }
 #endif
 #ifdef BME280
@@ -729,35 +877,29 @@ float BMP180_SeaLevelForAltitude(float altitude, float atmospheric)
 #ifdef BMP280
 uint8_t BMP280_ReadTemperatureAndPressure(float *temperature, int32_t *pressure)
 {
-	  int64_t var1, var2, p;
-
-	  // Must be done first to get the t_fine variable set up
-	  *temperature = BMP280_ReadTemperature();
+	  uint8_t data[BMP280_DATA_LEN];
 
-	  if(*temperature == -99)
+	  // a failed access anywhere in the measurement fails the reading
+	  BusStatus = HAL_OK;
+	  if(BMP280_Measure())
+	  {
+		  *temperature = -99;
 		  return -1;
+	  }
 
-	  int32_t adc_P = BMP280_Read24(BMP280_PRESSUREDATA);
-	  adc_P >>= 4;
-
-	  var1 = ((int64_t)t_fine) - 128000;
-	  var2 = var1 * var1 * (int64_t)p6;
-	  var2 = var2 + ((var1*(int64_t)p5)<<17);
-	  var2 = var2 + (((int64_t)p4)<<35);
-	  var1 = ((var1 * var1 * (int64_t)p3)>>8) +
-	    ((var1 * (int64_t)p2)<<12);
-	  var1 = (((((int64_t)1)<<47)+var1))*((int64_t)p1)>>33;
-
-	  if (var1 == 0) {
-	    return 0;  // avoid exception caused by division by zero
+	  // 0xF7..0xFC in one burst, the chip keeps them from one conversion
+	  // until the read ends
+	  if(BMP280_ReadBurst(BMP280_PRESSUREDATA, data, BMP280_DATA_LEN) != HAL_OK || BusStatus != HAL_OK ||
+		 BMP280_Raw20(&data[3]) == BMP280_RAW_NONE)
+	  {
+		  *temperature = -99;
+		  return -1;
 	  }
-	  p = 1048576 - adc_P;
-	  p = (((p<<31) - var2)*3125) / var1;
-	  var1 = (((int64_t)p9) * (p>>13) * (p>>13)) >> 25;
-	  var2 = (((int64_t)p8) * p) >> 19;
 
-	  p = ((p + var1 + var2) >> 8) + (((int64_t)p7)<<4);
-	  *pressure = (int32_t)p/256;
+	  // Temperature first, it sets t_fine for the pressure
+	  float T = BMP280_CompensateTemperature(BMP280_Raw20(&data[3]));
+	  *temperature = T/100;
+	  *pressure = BMP280_CompensatePressure(BMP280_Raw20(&data[0]));
 
 	  return 0;
 }
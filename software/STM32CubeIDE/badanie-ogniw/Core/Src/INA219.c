@@ -9,6 +9,7 @@
 
 #include "main.h"
 #include "INA219.h"
+#include "i2c_bus.h"
 enum BatteryState batteryState;
 
 bool isFirst;
@@ -27,7 +28,8 @@ uint16_t Read16(INA219_t *ina219, uint8_t Register)
 {
 	uint8_t Value[2];
 
-	HAL_I2C_Mem_Read(ina219->ina219_i2c, (INA219_ADDRESS<<1), Register, 1, Value, 2, 1000);
+	if (I2Cbus_MemRead(ina219->Address, Register, Value, 2) != HAL_OK)
+		return 0;
 
 	return ((Value[0] << 8) | Value[1]);
 }
@@ -52,7 +54,7 @@ HAL_StatusTypeDef Write16(INA219_t *ina219, uint8_t Register, uint16_t Value)
 	uint8_t addr[2];
 	addr[0] = (Value >> 8) & 0xff;  // upper byte
 	addr[1] = (Value >> 0) & 0xff; // lower byte
-	return HAL_I2C_Mem_Write(ina219->ina219_i2c, (INA219_ADDRESS<<1), Register, 1, (uint8_t*)addr, 2, 1000);
+	return I2Cbus_MemWrite(ina219->Address, Register, (uint8_t*)addr, 2);
 }
 
 /*
@@ -399,3 +401,82 @@ uint8_t INA219_Init(INA219_t *ina219, I2C_HandleTypeDef *i2c, uint8_t Address)
 		return 0;
 	}
 }
+
+static void INA219_SampleDone(I2Cbus_Xfer *xfer)
+{
+	INA219_Sample_t *sample = xfer->ctx;
+
+	if (xfer->state != I2CBUS_DONE)
+		sample->errors++;
+	sample->pending--;
+}
+
+/*
+ * @brief:		Queue reads of the bus voltage, current and power registers and return
+ * 				at once. The transfers run from the I2C interrupt, e.g. while the SGP30
+ * 				is measuring.
+ * @param:		Pointer to the device object that was made from the struct. EX:  (&ina219)
+ * @param:		Sample buffer, valid until INA219_SampleReady returns true
+ */
+void INA219_StartSample(INA219_t *ina219, INA219_Sample_t *sample)
+{
+	static const uint8_t regs[3] = { INA219_REG_BUSVOLTAGE, INA219_REG_CURRENT, INA219_REG_POWER };
+
+	sample->pending = 3;
+	sample->errors = 0;
+
+	for (int i = 0; i < 3; i++)
+	{
+		I2Cbus_Xfer *x = &sample->xfer[i];
+
+		x->op = I2CBUS_MEM_READ;
+		x->addr = ina219->Address;
+		x->reg = regs[i];
+		x->buf = sample->raw[i];
+		x->len = 2;
+		x->done = INA219_SampleDone;
+		x->ctx = sample;
+		I2Cbus_Submit(x);
+	}
+}
+
+bool INA219_SampleReady(INA219_Sample_t *sample)
+{
+	return sample->pending == 0;
+}
+
+// Same scaling as INA219_ReadBusVoltage / INA219_ReadCurrent_raw / INA219_ReadPower
+uint16_t INA219_SampleBusVoltage(const INA219_Sample_t *sample)
+{
+	uint16_t result = (sample->raw[0][0] << 8) | sample->raw[0][1];
+
+	return ((result >> 3) * 4);
+}
+
+int16_t INA219_SampleCurrent_raw(const INA219_Sample_t *sample)
+{
+	return (int16_t)((sample->raw[1][0] << 8) | sample->raw[1][1]);
+}
+
+// In mA like INA219_ReadCurrent, 0 until a calibration sets the current LSB
+int16_t INA219_SampleCurrent_mA(const INA219_Sample_t *sample)
+{
+	if(!ina219_currentDivider_mA)
+		return 0;
+	return INA219_SampleCurrent_raw(sample) / ina219_currentDivider_mA;
+}
+
+// In uA, keeps the resolution of the current LSB for integrating
+int32_t INA219_SampleCurrent_uA(const INA219_Sample_t *sample)
+{
+	if(!ina219_currentDivider_mA)
+		return 0;
+	return (int32_t)INA219_SampleCurrent_raw(sample) * 1000 / ina219_currentDivider_mA;
+}
+
+uint16_t INA219_SamplePower(const INA219_Sample_t *sample)
+{
+	uint16_t result = (sample->raw[2][0] << 8) | sample->raw[2][1];
+
+	return result * ina219_powerMultiplier_mW;
+}
@@ -0,0 +1,221 @@
+/*
+ * adc_sampler.c
+ *
+ *  Timer triggered ADC1 channel 0 acquisition.
+ *
+ *  TIM6 update events drive TRGO, each one starts a single conversion and
+ *  DMA2 stream 0 moves the result into a circular buffer of two halves.
+ *  The half and full transfer interrupts reduce the half just written to
+ *  a block (average, min/max, oversampled value) while the DMA fills the
+ *  other half, so no CPU time is spent per conversion.
+ *  Blocks are also accumulated until the main loop collects them with
+ *  ADCsampler_Read, one result per sample period at any ADC rate.
+ */
+
+#include "adc.h"
+#include "adc_sampler.h"
+
+typedef struct {
+  uint64_t sum;
+  uint32_t n;
+  uint16_t min;
+  uint16_t max;
+} ADCsampler_Acc;
+
+static uint16_t Buffer[2 * ADCSAMPLER_HALF_LEN];
+static TIM_HandleTypeDef Trigger;
+
+static ADCsampler_Result Block;
+static volatile uint8_t BlockFresh;
+static ADCsampler_Acc Acc = { .min = 0xFFFF };
+static ADCsampler_Stats Stats;
+
+/* Interrupt context, one half buffer */
+static void ADCsampler_Process(const uint16_t *p)
+{
+  uint32_t sum = 0;
+  uint16_t min = 0xFFFF;
+  uint16_t max = 0;
+
+  for (uint32_t i = 0; i < ADCSAMPLER_HALF_LEN; i++)
+  {
+    uint16_t v = p[i];
+
+    sum += v;
+    if (v < min)
+      min = v;
+    if (v > max)
+      max = v;
+  }
+
+  /* 4^n samples summed and shifted right by n give n extra bits, over the
+     whole half that is sum * 2^n / ADCSAMPLER_HALF_LEN */
+  Block.n = ADCSAMPLER_HALF_LEN;
+  Block.avg = (uint16_t)((sum + ADCSAMPLER_HALF_LEN / 2) >> ADCSAMPLER_HALF_LOG2);
+  Block.min = min;
+  Block.max = max;
+  Block.oversampled = sum >> (ADCSAMPLER_HALF_LOG2 - ADCSAMPLER_OVERSAMPLE_BITS);
+  BlockFresh = 1;
+
+  Acc.sum += sum;
+  Acc.n += ADCSAMPLER_HALF_LEN;
+  if (min < Acc.min)
+    Acc.min = min;
+  if (max > Acc.max)
+    Acc.max = max;
+
+  Stats.blocks++;
+}
+
+void HAL_ADC_ConvHalfCpltCallback(ADC_HandleTypeDef *hadc)
+{
+  if (hadc == &hadc1)
+    ADCsampler_Process(&Buffer[0]);
+}
+
+void HAL_ADC_ConvCpltCallback(ADC_HandleTypeDef *hadc)
+{
+  if (hadc == &hadc1)
+    ADCsampler_Process(&Buffer[ADCSAMPLER_HALF_LEN]);
+}
+
+/* Overrun stops the DMA requests, start over with a clean buffer */
+void HAL_ADC_ErrorCallback(ADC_HandleTypeDef *hadc)
+{
+  if (hadc != &hadc1)
+    return;
+
+  Stats.errors++;
+  HAL_ADC_Stop_DMA(&hadc1);
+  HAL_ADC_Start_DMA(&hadc1, (uint32_t *)Buffer, 2 * ADCSAMPLER_HALF_LEN);
+}
+
+/* APB1 timers run at twice PCLK1 unless APB1 is undivided */
+static uint32_t ADCsampler_TimerClock(void)
+{
+  RCC_ClkInitTypeDef clk;
+  uint32_t latency;
+
+  HAL_RCC_GetClockConfig(&clk, &latency);
+  if (clk.APB1CLKDivider == RCC_HCLK_DIV1)
+    return HAL_RCC_GetPCLK1Freq();
+  return 2 * HAL_RCC_GetPCLK1Freq();
+}
+
+/* Change the TIM6 period, returns the rate actually set */
+uint32_t ADCsampler_SetRate(uint32_t rate_hz)
+{
+  uint32_t clock = ADCsampler_TimerClock();
+  uint32_t ticks, psc, arr;
+
+  if (rate_hz == 0)
+    rate_hz = 1;
+  ticks = clock / rate_hz;
+  if (ticks < 2)
+    ticks = 2;
+
+  psc = (ticks - 1) / 65536;
+  arr = ticks / (psc + 1) - 1;
+
+  __HAL_TIM_SET_PRESCALER(&Trigger, psc);
+  __HAL_TIM_SET_AUTORELOAD(&Trigger, arr);
+  /* load the prescaler now rather than at the next update */
+  Trigger.Instance->EGR = TIM_EGR_UG;
+
+  Stats.rate_hz = clock / ((psc + 1) * (arr + 1));
+  return Stats.rate_hz;
+}
+
+HAL_StatusTypeDef ADCsampler_Start(uint32_t rate_hz)
+{
+  TIM_MasterConfigTypeDef master = {0};
+  ADC_ChannelConfTypeDef channel = {0};
+
+  /* TIM6: update event on TRGO, no interrupt */
+  __HAL_RCC_TIM6_CLK_ENABLE();
+  Trigger.Instance = TIM6;
+  Trigger.Init.Prescaler = 0;
+  Trigger.Init.CounterMode = TIM_COUNTERMODE_UP;
+  Trigger.Init.Period = 0xFFFF;
+  Trigger.Init.AutoReloadPreload = TIM_AUTORELOAD_PRELOAD_ENABLE;
+  if (HAL_TIM_Base_Init(&Trigger) != HAL_OK)
+    return HAL_ERROR;
+
+  master.MasterOutputTrigger = TIM_TRGO_UPDATE;
+  master.MasterSlaveMode = TIM_MASTERSLAVEMODE_DISABLE;
+  if (HAL_TIMEx_MasterConfigSynchronization(&Trigger, &master) != HAL_OK)
+    return HAL_ERROR;
+
+  ADCsampler_SetRate(rate_hz);
+
+  /* ADC1: one conversion per trigger edge, a DMA request after each */
+  hadc1.Init.ContinuousConvMode = DISABLE;
+  hadc1.Init.ExternalTrigConvEdge = ADC_EXTERNALTRIGCONVEDGE_RISING;
+  hadc1.Init.ExternalTrigConv = ADC_EXTERNALTRIGCONV_T6_TRGO;
+  hadc1.Init.DMAContinuousRequests = ENABLE;
+  hadc1.Init.EOCSelection = ADC_EOC_SINGLE_CONV;
+  if (HAL_ADC_Init(&hadc1) != HAL_OK)
+    return HAL_ERROR;
+
+  channel.Channel = ADC_CHANNEL_0;
+  channel.Rank = ADC_REGULAR_RANK_1;
+  channel.SamplingTime = ADCSAMPLER_SAMPLETIME;
+  if (HAL_ADC_ConfigChannel(&hadc1, &channel) != HAL_OK)
+    return HAL_ERROR;
+
+  if (HAL_ADC_Start_DMA(&hadc1, (uint32_t *)Buffer, 2 * ADCSAMPLER_HALF_LEN) != HAL_OK)
+    return HAL_ERROR;
+
+  return HAL_TIM_Base_Start(&Trigger);
+}
+
+void ADCsampler_Stop(void)
+{
+  HAL_TIM_Base_Stop(&Trigger);
+  HAL_ADC_Stop_DMA(&hadc1);
+}
+
+/* Last half buffer, returns 0 if no new block since the previous call */
+uint8_t ADCsampler_GetBlock(ADCsampler_Result *result)
+{
+  uint32_t primask = __get_PRIMASK();
+  uint8_t fresh;
+
+  __disable_irq();
+  *result = Block;
+  fresh = BlockFresh;
+  BlockFresh = 0;
+  __set_PRIMASK(primask);
+
+  return fresh;
+}
+
+/* Everything since the previous call, returns 0 if no block completed */
+uint8_t ADCsampler_Read(ADCsampler_Result *result)
+{
+  uint32_t primask = __get_PRIMASK();
+  ADCsampler_Acc acc;
+
+  __disable_irq();
+  acc = Acc;
+  Acc.sum = 0;
+  Acc.n = 0;
+  Acc.min = 0xFFFF;
+  Acc.max = 0;
+  __set_PRIMASK(primask);
+
+  if (acc.n == 0)
+    return 0;
+
+  result->n = acc.n;
+  result->avg = (uint16_t)((acc.sum + acc.n / 2) / acc.n);
+  result->min = acc.min;
+  result->max = acc.max;
+  result->oversampled = (uint32_t)((acc.sum << ADCSAMPLER_OVERSAMPLE_BITS) / acc.n);
+  return 1;
+}
+
+void ADCsampler_GetStats(ADCsampler_Stats *stats)
+{
+  *stats = Stats;
+}
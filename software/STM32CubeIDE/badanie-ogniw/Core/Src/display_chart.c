@@ -0,0 +1,162 @@
+/*
+ * display_chart.c
+ *
+ *  Scrolling trace (display_chart.h). The band is the panel's vertical
+ *  scroll area and the ring of lines maps one to one onto its memory
+ *  lines: a finished line overwrites the oldest memory line and the
+ *  scroll start moves one past it, so the controller shows the ring from
+ *  oldest to newest. Adding a line costs one line write and one
+ *  VSCRSADD, the rest of the trace is never sent again.
+ *
+ *  Scrolling runs along memory lines, which are screen rows, or screen
+ *  columns with MADCTL MV. MY numbers them from the other end of the
+ *  screen.
+ */
+
+#include "main.h"
+#include "st7735.h"
+#include "display_chart.h"
+
+#if ST7735_ROTATION & ST7735_MADCTL_MV
+#define CHART_LENGTH  ST7735_WIDTH      /* along the scroll */
+#define CHART_SPAN    ST7735_HEIGHT     /* value axis */
+#else
+#define CHART_LENGTH  ST7735_HEIGHT
+#define CHART_SPAN    ST7735_WIDTH
+#endif
+
+#if ST7735_ROTATION & ST7735_MADCTL_MY
+#define CHART_SCREEN(line)  (CHART_LENGTH - 1 - (line))
+#else
+#define CHART_SCREEN(line)  (line)
+#endif
+
+#define CHART_SWAP(c)  ((uint16_t)(((c) >> 8) | ((c) << 8)))
+
+static Chart_Point Ring[CHART_HISTORY];
+static uint16_t Head;           /* next slot to fill */
+static uint16_t Count;          /* filled slots */
+static uint16_t Pending;        /* filled, not drawn yet */
+
+static Chart_Point Bucket;
+static uint16_t BucketSamples;
+
+static uint16_t Top;            /* memory line of slot 0 */
+static uint8_t Active;
+
+static uint16_t Line[CHART_SPAN];
+
+static uint16_t Chart_Scale(int32_t value, int32_t lo, int32_t hi)
+{
+  if (value <= lo)
+    return 0;
+  if (value >= hi)
+    return CHART_SPAN - 1;
+  return (uint16_t)((value - lo) * (CHART_SPAN - 1) / (hi - lo));
+}
+
+static void Chart_Span(uint16_t from, uint16_t to, uint16_t color)
+{
+  color = CHART_SWAP(color);
+  while (from <= to)
+    Line[from++] = color;
+}
+
+static void Chart_WriteLine(uint16_t slot)
+{
+  uint16_t pos = CHART_SCREEN(Top + slot);
+
+#if ST7735_ROTATION & ST7735_MADCTL_MV
+  ST7735_DrawImage(pos, 0, 1, CHART_SPAN, Line);
+#else
+  ST7735_DrawImage(0, pos, CHART_SPAN, 1, Line);
+#endif
+}
+
+static void Chart_DrawSlot(uint16_t slot)
+{
+  const Chart_Point *p = &Ring[slot];
+  uint16_t zero = Chart_Scale(0, CHART_I_MIN_MA, CHART_I_MAX_MA);
+
+  /* the previous line is sent from Line */
+  ST7735_Wait();
+  Chart_Span(0, CHART_SPAN - 1, CHART_BG_COLOR);
+  Line[zero] = CHART_SWAP(CHART_ZERO_COLOR);
+  Chart_Span(Chart_Scale(p->v_min, CHART_V_MIN_MV, CHART_V_MAX_MV),
+             Chart_Scale(p->v_max, CHART_V_MIN_MV, CHART_V_MAX_MV), CHART_V_COLOR);
+  Chart_Span(Chart_Scale(p->i_min, CHART_I_MIN_MA, CHART_I_MAX_MA),
+             Chart_Scale(p->i_max, CHART_I_MIN_MA, CHART_I_MAX_MA), CHART_I_COLOR);
+  Chart_WriteLine(slot);
+}
+
+void Chart_Init(uint16_t first)
+{
+  /* lowest memory line of the band */
+#if ST7735_ROTATION & ST7735_MADCTL_MY
+  Top = CHART_LENGTH - first - CHART_HISTORY;
+#else
+  Top = first;
+#endif
+
+  Head = Count = Pending = BucketSamples = 0;
+
+#if ST7735_ROTATION & ST7735_MADCTL_MV
+  ST7735_FillRectangle(first, 0, CHART_HISTORY, CHART_SPAN, CHART_BG_COLOR);
+#else
+  ST7735_FillRectangle(0, first, CHART_SPAN, CHART_HISTORY, CHART_BG_COLOR);
+#endif
+
+  ST7735_SetScrollArea(Top, CHART_HISTORY, CHART_PANEL_LINES - Top - CHART_HISTORY);
+  ST7735_SetScrollStart(Top);
+  Active = 1;
+}
+
+void Chart_Add(uint16_t voltage_mV, int16_t current_mA)
+{
+  if (!BucketSamples)
+  {
+    Bucket.v_min = Bucket.v_max = voltage_mV;
+    Bucket.i_min = Bucket.i_max = current_mA;
+  }
+  else
+  {
+    if (voltage_mV < Bucket.v_min)
+      Bucket.v_min = voltage_mV;
+    if (voltage_mV > Bucket.v_max)
+      Bucket.v_max = voltage_mV;
+    if (current_mA < Bucket.i_min)
+      Bucket.i_min = current_mA;
+    if (current_mA > Bucket.i_max)
+      Bucket.i_max = current_mA;
+  }
+
+  if (++BucketSamples < CHART_SAMPLES_PER_LINE)
+    return;
+
+  BucketSamples = 0;
+  Ring[Head] = Bucket;
+  Head = (Head + 1) % CHART_HISTORY;
+  if (Count < CHART_HISTORY)
+    Count++;
+  /* a stalled display only has to draw the lines still in the ring */
+  if (Pending < CHART_HISTORY)
+    Pending++;
+}
+
+void Chart_Update(void)
+{
+  if (!Active || !Pending)
+    return;
+
+  for (uint16_t n = Pending; n; n--)
+    Chart_DrawSlot((Head + CHART_HISTORY - n) % CHART_HISTORY);
+  Pending = 0;
+
+  /* oldest line first, the newest lands on the last line of the band */
+  ST7735_SetScrollStart(Top + Head);
+}
+
+void Chart_Redraw(void)
+{
+  Pending = Count;
+}
@@ -0,0 +1,47 @@
+/*
+ * display_fields.c
+ *
+ *  Incremental text fields (display_fields.h). A new text is compared
+ *  with the rendered one character by character and only the differing
+ *  cells go into the framebuffer, so the dirty area and the SPI traffic
+ *  of a refresh follow what changed rather than the screen size. A text
+ *  shorter than the last one blanks the leftover cells once.
+ */
+
+#include "st7735_fb.h"
+#include "display_fields.h"
+
+/* Returns the number of characters redrawn */
+uint8_t Field_Set(Field *field, const char *text)
+{
+  uint8_t max = FIELD_MAX_CHARS;
+  uint8_t changed = 0;
+  uint8_t i;
+
+  if (field->x < FB_WIDTH && (FB_WIDTH - field->x) / field->font->width < max)
+    max = (FB_WIDTH - field->x) / field->font->width;
+
+  for (i = 0; i < max && (*text || i < field->len); i++)
+  {
+    char ch = *text ? *text++ : ' ';
+
+    if (!field->drawn || i >= field->len || field->text[i] != ch)
+    {
+      FB_WriteChar(field->x + i * field->font->width, field->y, ch, *field->font,
+                   field->color, field->bgcolor);
+      field->text[i] = ch;
+      changed++;
+    }
+  }
+
+  if (i > field->len)
+    field->len = i;
+  field->drawn = 1;
+  return changed;
+}
+
+/* Redraw everything on the next Field_Set, e.g. after a screen clear */
+void Field_Invalidate(Field *field)
+{
+  field->drawn = 0;
+}
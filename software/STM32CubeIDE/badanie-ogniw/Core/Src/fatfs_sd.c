@@ -2,10 +2,12 @@
 #define FALSE 0
 #define bool BYTE
 
+#include <string.h>
 #include "stm32f7xx_hal.h"
 
 #include "diskio.h"
 #include "fatfs_sd.h"
+#include "spi_bus.h"
 
 extern SPI_HandleTypeDef hspi1;
 extern volatile uint8_t Timer1, Timer2;
@@ -14,26 +16,76 @@ static volatile DSTATUS Stat = STA_NOINIT;
 static uint8_t CardType;
 static uint8_t PowerFlag = 0;
 
-#define SD_CS_GPIO_Port GPIOE
-#define SD_CS_Pin GPIO_PIN_11
+static SD_BusStats BusStats;
 
-/* SPI Chip Select */
+/* SPI clock for data transfer, stepped down on CRC / token errors */
+static uint32_t DataPrescaler = SPIBUS_SD_DATA_PRESCALER;
+
+#if SD_CHECK_CRC
+static BYTE TestBlock[512];
+#endif
+
+/* SPI Chip Select, CS is on PE11 (spi_bus.c). The bus stays locked for
+   the SD card until SD_Release so queued transfers cannot cut in. */
 static void SELECT(void)
 {
-  HAL_GPIO_WritePin(SD_CS_GPIO_Port, SD_CS_Pin, GPIO_PIN_RESET);
+  SPIbus_Lock(SPIBUS_SD);
+  SPIbus_Select(SPIBUS_SD);
 }
 
 /* SPI Chip Deselect */
 static void DESELECT(void)
 {
-  HAL_GPIO_WritePin(SD_CS_GPIO_Port, SD_CS_Pin, GPIO_PIN_SET);
+  SPIbus_Deselect(SPIBUS_SD);
+}
+
+/* Next slower data clock, FALSE when already at SPIBUS_SD_MIN_PRESCALER */
+static bool SD_ClockStepDown(void)
+{
+  if (DataPrescaler >= SPIBUS_SD_MIN_PRESCALER)
+    return FALSE;
+
+  DataPrescaler += SPI_CR1_BR_0;  /* BR field n -> fPCLK / 2^(n+1) */
+  SPIbus_SetPrescaler(SPIBUS_SD, DataPrescaler);
+  BusStats.clock_steps++;
+
+  return TRUE;
+}
+
+/* Data block errors so far. Only these point at a too fast clock, a busy
+   timeout or a command without R1 is retried at the same speed. */
+static uint32_t SD_DataErrors(void)
+{
+  return BusStats.crc_errors + BusStats.token_errors;
 }
 
+#if SD_CHECK_CRC
+/* CRC-16/XMODEM of a data block, as sent by the card */
+static uint16_t SD_Crc16(const BYTE *buff, UINT len)
+{
+  static const uint16_t table[16] = {
+    0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+    0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF
+  };
+  uint16_t crc = 0;
+
+  while (len--)
+  {
+    crc = (uint16_t)((crc << 4) ^ table[(crc >> 12) ^ (*buff >> 4)]);
+    crc = (uint16_t)((crc << 4) ^ table[(crc >> 12) ^ (*buff & 0x0F)]);
+    buff++;
+  }
+
+  return crc;
+}
+#endif
+
 
 static void SPI_TxByte(BYTE data)
 {
   while (HAL_SPI_GetState(&hspi1) != HAL_SPI_STATE_READY);
   HAL_SPI_Transmit(&hspi1, &data, 1, SPI_TIMEOUT);
+  BusStats.spi_transfers++;
 }
 
 
@@ -45,14 +97,53 @@ static uint8_t SPI_RxByte(void)
 
   while ((HAL_SPI_GetState(&hspi1) != HAL_SPI_STATE_READY));
   HAL_SPI_TransmitReceive(&hspi1, &dummy, &data, 1, SPI_TIMEOUT);
+  BusStats.spi_transfers++;
 
   return data;
 }
 
+/* Deselect, clock out one byte so the card releases MISO, free the bus */
+static void SD_Release(void)
+{
+  DESELECT();
+  SPI_RxByte();
+  SPIbus_Unlock();
+}
 
-static void SPI_RxBytePtr(uint8_t *buff)
+/* Send a whole buffer in one SPI transfer */
+static bool SPI_TxBuffer(const BYTE *buff, UINT len)
 {
-  *buff = SPI_RxByte();
+#if SD_USE_DMA
+  BusStats.spi_transfers++;
+  return (SPIbus_LockedDma(buff, NULL, len, SPI_TIMEOUT) == HAL_OK) ? TRUE : FALSE;
+#else
+  do
+  {
+    SPI_TxByte(*buff++);
+  } while (--len);
+
+  return TRUE;
+#endif
+}
+
+/* Receive a whole buffer in one SPI transfer, clocking out 0xFF */
+static bool SPI_RxBuffer(BYTE *buff, UINT len)
+{
+#if SD_USE_DMA
+  /* The card expects MOSI high while it streams data: the buffer itself is
+     the 0xFF source, each byte is sent before its slot is overwritten */
+  memset(buff, 0xFF, len);
+
+  BusStats.spi_transfers++;
+  return (SPIbus_LockedDma(buff, buff, len, SPI_TIMEOUT) == HAL_OK) ? TRUE : FALSE;
+#else
+  do
+  {
+    *buff++ = SPI_RxByte();
+  } while (--len);
+
+  return TRUE;
+#endif
 }
 
 
@@ -76,6 +167,11 @@ static uint8_t SD_ReadyWait(void)
   uint8_t cmd_arg[6];
   uint32_t Count = 0x1FFF;
 
+  /* card identification runs at <= 400 kHz */
+  SPIbus_Lock(SPIBUS_SD);
+  SPIbus_SetPrescaler(SPIBUS_SD, SPIBUS_SD_INIT_PRESCALER);
+  SPIbus_Configure(SPIBUS_SD);
+
    DESELECT();
 
   for(int i = 0; i < 10; i++)
@@ -83,8 +179,8 @@ static uint8_t SD_ReadyWait(void)
     SPI_TxByte(0xFF);
   }
 
-  /* SPI Chips Select */
-  SELECT();
+  /* SPI Chips Select, the bus is already locked above */
+  SPIbus_Select(SPIBUS_SD);
 
    cmd_arg[0] = (CMD0 | 0x40);
   cmd_arg[1] = 0;
@@ -105,6 +201,7 @@ static uint8_t SD_ReadyWait(void)
 
   DESELECT();
   SPI_TxByte(0XFF);
+  SPIbus_Unlock();
 
   PowerFlag = 1;
 }
@@ -133,16 +230,26 @@ static uint8_t SD_ReadyWait(void)
 
 
   if(token != 0xFE)
+  {
+    BusStats.token_errors++;
     return FALSE;
+  }
 
-  do
-  {
-    SPI_RxBytePtr(buff++);
-    SPI_RxBytePtr(buff++);
-  } while(btr -= 2);
+  if (!SPI_RxBuffer(buff, btr))
+    return FALSE;
 
-  SPI_RxByte();
-  SPI_RxByte();
+  uint16_t crc = (uint16_t)(SPI_RxByte() << 8);
+  crc |= SPI_RxByte();
+
+#if SD_CHECK_CRC
+  if (crc != SD_Crc16(buff, btr))
+  {
+    BusStats.crc_errors++;
+    return FALSE;
+  }
+#else
+  (void)crc;
+#endif
 
   return TRUE;
 }
@@ -151,7 +258,7 @@ static uint8_t SD_ReadyWait(void)
 #if _READONLY == 0
 static bool SD_TxDataBlock(const BYTE *buff, BYTE token)
 {
-  uint8_t resp, wc;
+  uint8_t resp = 0;
   uint8_t i = 0;
 
   if (SD_ReadyWait() != 0xFF)
@@ -159,36 +266,35 @@ static bool SD_TxDataBlock(const BYTE *buff, BYTE token)
 
   SPI_TxByte(token);
 
-  if (token != 0xFD)
-  {
-    wc = 0;
-
-    do
-    {
-      SPI_TxByte(*buff++);
-      SPI_TxByte(*buff++);
-    } while (--wc);
+  /* Stop Tran token carries no data and gets no data response */
+  if (token == 0xFD)
+    return TRUE;
 
-    SPI_RxByte();
-    SPI_RxByte();
+  if (!SPI_TxBuffer(buff, 512))
+    return FALSE;
 
-    while (i <= 64)
-    {
-      resp = SPI_RxByte();
+  /* dummy CRC */
+  SPI_RxByte();
+  SPI_RxByte();
 
-      if ((resp & 0x1F) == 0x05)
-        break;
+  while (i <= 64)
+  {
+    resp = SPI_RxByte();
 
-      i++;
-    }
+    if ((resp & 0x1F) == 0x05)
+      break;
 
-    while (SPI_RxByte() == 0);
+    i++;
   }
 
+  while (SPI_RxByte() == 0);
+
   if ((resp & 0x1F) == 0x05)
     return TRUE;
-  else
-    return FALSE;
+
+  /* 0x0B: CRC error, 0x0D: write error, else no valid response */
+  BusStats.token_errors++;
+  return FALSE;
 }
 #endif /* _READONLY */
 
@@ -228,6 +334,32 @@ static BYTE SD_SendCmd(BYTE cmd, DWORD arg)
 }
 
 
+static UINT SD_ReadSectors(BYTE* buff, DWORD sector, UINT count);
+
+/* Start at SPIBUS_SD_DATA_PRESCALER and step down until SD_SELFTEST_READS
+   reads of sector 0 pass the token and CRC checks */
+static void SD_SelfTest(void)
+{
+  DataPrescaler = SPIBUS_SD_DATA_PRESCALER;
+  SPIbus_SetPrescaler(SPIBUS_SD, DataPrescaler);
+
+#if SD_CHECK_CRC
+  for (;;)
+  {
+    uint8_t n;
+
+    for (n = 0; n < SD_SELFTEST_READS; n++)
+    {
+      if (SD_ReadSectors(TestBlock, 0, 1) != 0)
+        break;
+    }
+
+    if (n == SD_SELFTEST_READS || !SD_ClockStepDown())
+      break;
+  }
+#endif
+}
+
 DSTATUS SD_disk_initialize(BYTE drv)
 {
   uint8_t n, type, ocr[4];
@@ -302,14 +434,15 @@ DSTATUS SD_disk_initialize(BYTE drv)
 
   CardType = type;
 
-  DESELECT();
-
-  SPI_RxByte();
+  SD_Release();
 
   if (type)
   {
     /* Clear STA_NOINIT */
     Stat &= ~STA_NOINIT;
+
+    /* fastest data clock that passes the self-test */
+    SD_SelfTest();
   }
   else
   {
@@ -328,14 +461,9 @@ DSTATUS SD_disk_status(BYTE drv)
   return Stat;
 }
 
-DRESULT SD_disk_read(BYTE pdrv, BYTE* buff, DWORD sector, UINT count)
+/* One read attempt, returns the number of sectors not read */
+static UINT SD_ReadSectors(BYTE* buff, DWORD sector, UINT count)
 {
-  if (pdrv || !count)
-    return RES_PARERR;
-
-  if (Stat & STA_NOINIT)
-    return RES_NOTRDY;
-
   if (!(CardType & 4))
     sector *= 512;
 
@@ -362,14 +490,12 @@ DRESULT SD_disk_read(BYTE pdrv, BYTE* buff, DWORD sector, UINT count)
     }
   }
 
-  DESELECT();
-  SPI_RxByte();
+  SD_Release();
 
-  return count ? RES_ERROR : RES_OK;
+  return count;
 }
 
-#if _READONLY == 0
-DRESULT SD_disk_write(BYTE pdrv, const BYTE* buff, DWORD sector, UINT count)
+DRESULT SD_disk_read(BYTE pdrv, BYTE* buff, DWORD sector, UINT count)
 {
   if (pdrv || !count)
     return RES_PARERR;
@@ -377,9 +503,30 @@ DRESULT SD_disk_write(BYTE pdrv, const BYTE* buff, DWORD sector, UINT count)
   if (Stat & STA_NOINIT)
     return RES_NOTRDY;
 
-  if (Stat & STA_PROTECT)
-    return RES_WRPRT;
+  for (uint8_t attempt = 0; attempt <= SD_RETRIES; attempt++)
+  {
+    uint32_t errors = SD_DataErrors();
+
+    if (attempt)
+      BusStats.retries++;
+
+    if (SD_ReadSectors(buff, sector, count) == 0)
+    {
+      BusStats.sectors_read += count;
+      return RES_OK;
+    }
+
+    if (SD_DataErrors() != errors)
+      SD_ClockStepDown();
+  }
+
+  return RES_ERROR;
+}
 
+#if _READONLY == 0
+/* One write attempt, returns the number of sectors not written */
+static UINT SD_WriteSectors(const BYTE* buff, DWORD sector, UINT count)
+{
   if (!(CardType & 4))
     sector *= 512;
 
@@ -414,10 +561,40 @@ DRESULT SD_disk_write(BYTE pdrv, const BYTE* buff, DWORD sector, UINT count)
     }
   }
 
-  DESELECT();
-  SPI_RxByte();
+  SD_Release();
 
-  return count ? RES_ERROR : RES_OK;
+  return count;
+}
+
+DRESULT SD_disk_write(BYTE pdrv, const BYTE* buff, DWORD sector, UINT count)
+{
+  if (pdrv || !count)
+    return RES_PARERR;
+
+  if (Stat & STA_NOINIT)
+    return RES_NOTRDY;
+
+  if (Stat & STA_PROTECT)
+    return RES_WRPRT;
+
+  for (uint8_t attempt = 0; attempt <= SD_RETRIES; attempt++)
+  {
+    uint32_t errors = SD_DataErrors();
+
+    if (attempt)
+      BusStats.retries++;
+
+    if (SD_WriteSectors(buff, sector, count) == 0)
+    {
+      BusStats.sectors_written += count;
+      return RES_OK;
+    }
+
+    if (SD_DataErrors() != errors)
+      SD_ClockStepDown();
+  }
+
+  return RES_ERROR;
 }
 #endif /* _READONLY */
 
@@ -518,9 +695,23 @@ DRESULT SD_disk_ioctl(BYTE drv, BYTE ctrl, void *buff)
       res = RES_PARERR;
     }
 
-    DESELECT();
-    SPI_RxByte();
+    SD_Release();
   }
 
   return res;
 }
+
+void SD_GetBusStats(SD_BusStats *stats)
+{
+  *stats = BusStats;
+}
+
+uint32_t SD_GetClockHz(void)
+{
+  return SPIbus_GetClockHz(SPIBUS_SD);
+}
+
+void SD_ResetBusStats(void)
+{
+  memset(&BusStats, 0, sizeof(BusStats));
+}
@@ -1,6 +1,9 @@
 /* vim: set ai et ts=4 sw=4: */
+#include <stddef.h>
 #include "fonts.h"
 
+#ifdef FONTS_RAW
+
 static const uint16_t Font7x10 [] = {
 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000,  // sp
 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x1000, 0x0000, 0x1000, 0x0000, 0x0000,  // !
@@ -295,7 +298,11 @@ static const uint16_t Font16x26 [] = {
 0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x3F07,0x7FC7,0x73E7,0xF1FF,0xF07E,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000,0x0000, // Ascii = [~]
 };
 
+#define FONT_ROWS(rows) rows
+#else
+#define FONT_ROWS(rows) NULL
+#endif
 
-FontDef Font_7x10 = {7,10,Font7x10};
-FontDef Font_11x18 = {11,18,Font11x18};
-FontDef Font_16x26 = {16,26,Font16x26};
+FontDef Font_7x10 = {7,10,FONT_ROWS(Font7x10),Font7x10_Runs,Font7x10_Offsets};
+FontDef Font_11x18 = {11,18,FONT_ROWS(Font11x18),Font11x18_Runs,Font11x18_Offsets};
+FontDef Font_16x26 = {16,26,FONT_ROWS(Font16x26),Font16x26_Runs,Font16x26_Offsets};
@@ -0,0 +1,343 @@
+/*
+ * fonts_packed.c
+ *
+ *  Generated by software/tools/fontgen from fonts.c and checked in,
+ *  do not edit. Run fontgen again after changing fonts.c.
+ *
+ *  Runs of each glyph from the top left, row after row: background
+ *  pixels in the high nibble, foreground in the low one. Background
+ *  after the last run is implied. Glyph c is
+ *  Runs[Offsets[c - 32]] .. Runs[Offsets[c - 31] - 1].
+ */
+
+#include "fonts.h"
+
+/* 7x10, 974 bytes of runs, 1900 of rows in fonts.c */
+const uint8_t Font7x10_Runs[] = {
+    // sp
+    0x31, 0x61, 0x61, 0x61, 0x61, 0x61, 0xD1, // !
+    0x21, 0x11, 0x41, 0x11, 0x41, 0x11, // "
+    0x21, 0x21, 0x31, 0x21, 0x25, 0x31, 0x21, 0x21, 0x21, 0x35, 0x21, 0x21, 0x31, 0x21, // #
+    0x23, 0x31, 0x11, 0x11, 0x21, 0x11, 0x53, 0x51, 0x11, 0x21, 0x11, 0x11, 0x21, 0x11, 0x11, 0x33, 0x51, // $
+    0x21, 0x51, 0x11, 0x11, 0x21, 0x12, 0x42, 0x51, 0x11, 0x31, 0x11, 0x11, 0x41, 0x11, 0x51, // %
+    0x31, 0x51, 0x11, 0x41, 0x11, 0x51, 0x52, 0x11, 0x21, 0x21, 0x31, 0x21, 0x42, 0x11, // &
+    0x31, 0x61, 0x61, // '
+    0x41, 0x51, 0x51, 0x61, 0x61, 0x61, 0x61, 0x61, 0x71, 0x71, // (
+    0x21, 0x71, 0x71, 0x61, 0x61, 0x61, 0x61, 0x61, 0x51, 0x51, // )
+    0x31, 0x53, 0x51, 0x51, 0x11, // *
+    0xF0, 0x21, 0x61, 0x45, 0x41, 0x61, // +
+    0xF0, 0xF0, 0xF0, 0x71, 0x61, 0x61, // ,
+    0xF0, 0xF0, 0x73, // -
+    0xF0, 0xF0, 0xF0, 0x71, // .
+    0x41, 0x61, 0x51, 0x61, 0x61, 0x61, 0x51, 0x61, // /
+    0x23, 0x31, 0x31, 0x21, 0x31, 0x21, 0x11, 0x11, 0x21, 0x31, 0x21, 0x31, 0x21, 0x31, 0x33, // 0
+    0x31, 0x52, 0x41, 0x11, 0x61, 0x61, 0x61, 0x61, 0x61, // 1
+    0x23, 0x31, 0x31, 0x21, 0x31, 0x61, 0x51, 0x51, 0x51, 0x55, // 2
+    0x23, 0x31, 0x31, 0x61, 0x42, 0x71, 0x61, 0x21, 0x31, 0x33, // 3
+    0x41, 0x52, 0x41, 0x11, 0x41, 0x11, 0x31, 0x21, 0x35, 0x51, 0x61, // 4
+    0x15, 0x21, 0x61, 0x64, 0x71, 0x61, 0x21, 0x31, 0x33, // 5
+    0x23, 0x31, 0x31, 0x21, 0x64, 0x31, 0x31, 0x21, 0x31, 0x21, 0x31, 0x33, // 6
+    0x15, 0x61, 0x51, 0x51, 0x61, 0x51, 0x61, 0x61, // 7
+    0x23, 0x31, 0x31, 0x21, 0x31, 0x33, 0x31, 0x31, 0x21, 0x31, 0x21, 0x31, 0x33, // 8
+    0x23, 0x31, 0x31, 0x21, 0x31, 0x21, 0x31, 0x34, 0x61, 0x21, 0x31, 0x33, // 9
+    0xF0, 0x21, 0xF0, 0xF0, 0x41, // :
+    0xF0, 0x91, 0xF0, 0xC1, 0x61, 0x61, // ;
+    0xF0, 0x32, 0x32, 0x41, 0x72, 0x72, // <
+    0xF0, 0x75, 0x95, // =
+    0xF2, 0x72, 0x71, 0x42, 0x32, // >
+    0x23, 0x31, 0x31, 0x61, 0x51, 0x51, 0x61, 0xD1, // ?
+    0x23, 0x31, 0x31, 0x21, 0x22, 0x21, 0x11, 0x11, 0x21, 0x13, 0x21, 0x61, 0x73, // @
+    0x31, 0x51, 0x11, 0x41, 0x11, 0x41, 0x11, 0x41, 0x11, 0x35, 0x21, 0x31, 0x21, 0x31, // A
+    0x14, 0x31, 0x31, 0x21, 0x31, 0x24, 0x31, 0x31, 0x21, 0x31, 0x21, 0x31, 0x24, // B
+    0x23, 0x31, 0x31, 0x21, 0x61, 0x61, 0x61, 0x61, 0x31, 0x33, // C
+    0x13, 0x41, 0x21, 0x31, 0x31, 0x21, 0x31, 0x21, 0x31, 0x21, 0x31, 0x21, 0x21, 0x33, // D
+    0x15, 0x21, 0x61, 0x65, 0x21, 0x61, 0x61, 0x65, // E
+    0x15, 0x21, 0x61, 0x64, 0x31, 0x61, 0x61, 0x61, // F
+    0x23, 0x31, 0x31, 0x21, 0x61, 0x61, 0x13, 0x21, 0x31, 0x21, 0x31, 0x33, // G
+    0x11, 0x31, 0x21, 0x31, 0x21, 0x31, 0x25, 0x21, 0x31, 0x21, 0x31, 0x21, 0x31, 0x21, 0x31, // H
+    0x23, 0x51, 0x61, 0x61, 0x61, 0x61, 0x61, 0x53, // I
+    0x51, 0x61, 0x61, 0x61, 0x61, 0x61, 0x21, 0x31, 0x33, // J
+    0x11, 0x31, 0x21, 0x21, 0x31, 0x11, 0x42, 0x51, 0x11, 0x41, 0x21, 0x31, 0x21, 0x31, 0x31, // K
+    0x11, 0x61, 0x61, 0x61, 0x61, 0x61, 0x61, 0x65, // L
+    0x11, 0x31, 0x22, 0x12, 0x22, 0x12, 0x21, 0x11, 0x11, 0x21, 0x31, 0x21, 0x31, 0x21, 0x31, 0x21, 0x31, // M
+    0x11, 0x31, 0x22, 0x21, 0x22, 0x21, 0x21, 0x11, 0x11, 0x21, 0x11, 0x11, 0x21, 0x22, 0x21, 0x22, 0x21, 0x31, // N
+    0x23, 0x31, 0x31, 0x21, 0x31, 0x21, 0x31, 0x21, 0x31, 0x21, 0x31, 0x21, 0x31, 0x33, // O
+    0x14, 0x31, 0x31, 0x21, 0x31, 0x21, 0x31, 0x24, 0x31, 0x61, 0x61, // P
+    0x23, 0x31, 0x31, 0x21, 0x31, 0x21, 0x31, 0x21, 0x31, 0x21, 0x31, 0x21, 0x11, 0x11, 0x33, 0x71, // Q
+    0x14, 0x31, 0x31, 0x21, 0x31, 0x21, 0x31, 0x24, 0x31, 0x21, 0x31, 0x21, 0x31, 0x31, // R
+    0x23, 0x31, 0x31, 0x21, 0x72, 0x71, 0x71, 0x21, 0x31, 0x33, // S
+    0x15, 0x41, 0x61, 0x61, 0x61, 0x61, 0x61, 0x61, // T
+    0x11, 0x31, 0x21, 0x31, 0x21, 0x31, 0x21, 0x31, 0x21, 0x31, 0x21, 0x31, 0x21, 0x31, 0x33, // U
+    0x11, 0x31, 0x21, 0x31, 0x21, 0x31, 0x31, 0x11, 0x41, 0x11, 0x41, 0x11, 0x51, 0x61, // V
+    0x11, 0x31, 0x21, 0x31, 0x21, 0x11, 0x11, 0x21, 0x11, 0x11, 0x21, 0x11, 0x11, 0x22, 0x12, 0x31, 0x11, 0x41, 0x11, // W
+    0x11, 0x31, 0x31, 0x11, 0x41, 0x11, 0x51, 0x61, 0x51, 0x11, 0x41, 0x11, 0x31, 0x31, // X
+    0x11, 0x31, 0x21, 0x31, 0x31, 0x11, 0x41, 0x11, 0x51, 0x61, 0x61, 0x61, // Y
+    0x15, 0x61, 0x51, 0x51, 0x61, 0x51, 0x51, 0x65, // Z
+    0x32, 0x51, 0x61, 0x61, 0x61, 0x61, 0x61, 0x61, 0x61, 0x62, // [
+    0x21, 0x61, 0x71, 0x61, 0x61, 0x61, 0x71, 0x61, // backslash
+    0x22, 0x61, 0x61, 0x61, 0x61, 0x61, 0x61, 0x61, 0x61, 0x52, // ]
+    0x31, 0x51, 0x11, 0x41, 0x11, 0x31, 0x31, // ^
+    0xF0, 0xF0, 0xF0, 0xF0, 0x37, // _
+    0x21, 0x71, // `
+    0xF0, 0x13, 0x31, 0x31, 0x34, 0x21, 0x31, 0x21, 0x22, 0x32, 0x11, // a
+    0x11, 0x61, 0x61, 0x12, 0x32, 0x21, 0x21, 0x31, 0x21, 0x31, 0x22, 0x21, 0x21, 0x12, // b
+    0xF0, 0x13, 0x31, 0x31, 0x21, 0x61, 0x61, 0x31, 0x33, // c
+    0x51, 0x61, 0x32, 0x11, 0x21, 0x22, 0x21, 0x31, 0x21, 0x31, 0x21, 0x22, 0x32, 0x11, // d
+    0xF0, 0x13, 0x31, 0x31, 0x25, 0x21, 0x61, 0x31, 0x33, // e
+    0x42, 0x41, 0x45, 0x41, 0x61, 0x61, 0x61, 0x61, // f
+    0xF0, 0x12, 0x11, 0x21, 0x22, 0x21, 0x31, 0x21, 0x31, 0x21, 0x22, 0x32, 0x11, 0x61, 0x24, // g
+    0x11, 0x61, 0x61, 0x12, 0x32, 0x21, 0x21, 0x31, 0x21, 0x31, 0x21, 0x31, 0x21, 0x31, // h
+    0x31, 0xB3, 0x61, 0x61, 0x61, 0x61, 0x61, // i
+    0x31, 0xB3, 0x61, 0x61, 0x61, 0x61, 0x61, 0x61, 0x33, // j
+    0x11, 0x61, 0x61, 0x21, 0x31, 0x11, 0x42, 0x51, 0x11, 0x41, 0x21, 0x31, 0x31, // k
+    0x13, 0x61, 0x61, 0x61, 0x61, 0x61, 0x61, 0x61, // l
+    0xF4, 0x31, 0x11, 0x11, 0x21, 0x11, 0x11, 0x21, 0x11, 0x11, 0x21, 0x11, 0x11, 0x21, 0x11, 0x11, // m
+    0xF1, 0x12, 0x32, 0x21, 0x21, 0x31, 0x21, 0x31, 0x21, 0x31, 0x21, 0x31, // n
+    0xF0, 0x13, 0x31, 0x31, 0x21, 0x31, 0x21, 0x31, 0x21, 0x31, 0x33, // o
+    0xF1, 0x12, 0x32, 0x21, 0x21, 0x31, 0x21, 0x31, 0x22, 0x21, 0x21, 0x12, 0x31, 0x61, // p
+    0xF0, 0x12, 0x11, 0x21, 0x22, 0x21, 0x31, 0x21, 0x31, 0x21, 0x22, 0x32, 0x11, 0x61, 0x61, // q
+    0xF1, 0x12, 0x32, 0x21, 0x21, 0x61, 0x61, 0x61, // r
+    0xF0, 0x13, 0x31, 0x31, 0x32, 0x71, 0x31, 0x31, 0x33, // s
+    0x21, 0x61, 0x54, 0x41, 0x61, 0x61, 0x61, 0x72, // t
+    0xF1, 0x31, 0x21, 0x31, 0x21, 0x31, 0x21, 0x31, 0x21, 0x22, 0x32, 0x11, // u
+    0xF1, 0x31, 0x21, 0x31, 0x31, 0x11, 0x41, 0x11, 0x41, 0x11, 0x51, // v
+    0xF1, 0x11, 0x11, 0x21, 0x11, 0x11, 0x21, 0x11, 0x11, 0x22, 0x12, 0x31, 0x11, 0x41, 0x11, // w
+    0xF1, 0x31, 0x31, 0x11, 0x51, 0x61, 0x51, 0x11, 0x31, 0x31, // x
+    0xF1, 0x31, 0x21, 0x31, 0x31, 0x11, 0x41, 0x11, 0x51, 0x61, 0x61, 0x42, // y
+    0xF5, 0x51, 0x51, 0x51, 0x51, 0x65, // z
+    0x32, 0x51, 0x61, 0x61, 0x51, 0x61, 0x71, 0x61, 0x61, 0x62, // {
+    0x31, 0x61, 0x61, 0x61, 0x61, 0x61, 0x61, 0x61, 0x61, 0x61, // |
+    0x22, 0x61, 0x61, 0x61, 0x71, 0x61, 0x51, 0x61, 0x61, 0x52, // }
+    0xF0, 0x73, 0x11, 0x21, 0x22, // ~
+};
+
+const uint16_t Font7x10_Offsets[96] = {
+    0, 0, 7, 13, 27, 44, 59, 73, 76, 86, 96, 101,
+    107, 113, 116, 120, 128, 143, 152, 162, 172, 183, 192, 204,
+    212, 225, 237, 242, 248, 254, 257, 262, 270, 283, 297, 310,
+    320, 334, 342, 350, 362, 377, 385, 394, 409, 417, 434, 452,
+    466, 477, 493, 507, 517, 525, 540, 554, 573, 587, 599, 607,
+    617, 625, 635, 642, 647, 649, 660, 674, 683, 697, 706, 714,
+    729, 743, 750, 759, 772, 780, 796, 808, 819, 833, 848, 856,
+    865, 873, 885, 896, 911, 921, 933, 939, 949, 959, 969, 974
+};
+
+/* 11x18, 1768 bytes of runs, 3420 of rows in fonts.c */
+const uint8_t Font11x18_Runs[] = {
+    // sp
+    0xF2, 0x92, 0x92, 0x92, 0x92, 0x92, 0x92, 0x92, 0x92, 0x92, 0x92, 0xF0, 0x52, 0x92, // !
+    0xE2, 0x12, 0x62, 0x12, 0x62, 0x12, 0x62, 0x12, 0x62, 0x12, // "
+    0xE2, 0x22, 0x52, 0x22, 0x52, 0x22, 0x52, 0x22, 0x39, 0x29, 0x42, 0x22, 0x42, 0x22, 0x49, 0x29, 0x32, 0x22, 0x52, 0x22, 0x52, 0x22, 0x52, 0x22, // #
+    0xE4, 0x66, 0x43, 0x11, 0x12, 0x32, 0x21, 0x12, 0x33, 0x11, 0x74, 0x84, 0x93, 0x81, 0x12, 0x32, 0x21, 0x12, 0x32, 0x21, 0x12, 0x33, 0x11, 0x12, 0x46, 0x64, 0x91, 0xA1, // $
+    0xC3, 0x72, 0x12, 0x62, 0x12, 0x41, 0x12, 0x12, 0x32, 0x12, 0x12, 0x22, 0x33, 0x22, 0x82, 0x82, 0x82, 0x13, 0x42, 0x12, 0x12, 0x22, 0x22, 0x12, 0x21, 0x32, 0x12, 0x62, 0x12, 0x73, // %
+    0xE4, 0x66, 0x52, 0x22, 0x52, 0x22, 0x52, 0x22, 0x64, 0x82, 0x74, 0x22, 0x22, 0x22, 0x12, 0x22, 0x33, 0x32, 0x42, 0x32, 0x33, 0x45, 0x12, 0x43, 0x21, // &
+    0xF2, 0x92, 0x92, 0x92, 0x92, // '
+    0x81, 0x91, 0x92, 0x82, 0x92, 0x91, 0x92, 0x92, 0x92, 0x92, 0x92, 0x92, 0xA1, 0xA2, 0x92, 0xA2, 0xA1, 0xB1, // (
+    0x21, 0xB1, 0xA2, 0xA2, 0x92, 0xA1, 0xA2, 0x92, 0x92, 0x92, 0x92, 0x92, 0x91, 0x92, 0x92, 0x82, 0x91, 0x91, // )
+    0xF2, 0x71, 0x12, 0x11, 0x56, 0x64, 0x62, 0x22, // *
+    0xF0, 0xF0, 0x72, 0x92, 0x92, 0x92, 0x5A, 0x1A, 0x52, 0x92, 0x92, 0x92, // +
+    0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xC2, 0x92, 0xA1, 0xA1, 0x91, // ,
+    0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xC4, 0x74, // -
+    0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xC2, 0x92, // .
+    0xF0, 0x22, 0x92, 0x92, 0x82, 0x92, 0x92, 0x92, 0x82, 0x92, 0x92, 0x92, 0x82, 0x92, 0x92, // /
+    0xE4, 0x66, 0x52, 0x22, 0x42, 0x42, 0x32, 0x42, 0x32, 0x42, 0x32, 0x12, 0x12, 0x32, 0x12, 0x12, 0x32, 0x42, 0x32, 0x42, 0x32, 0x42, 0x42, 0x22, 0x56, 0x64, // 0
+    0xF0, 0x12, 0x83, 0x74, 0x62, 0x12, 0x61, 0x22, 0x92, 0x92, 0x92, 0x92, 0x92, 0x92, 0x92, 0x92, 0x92, // 1
+    0xE4, 0x66, 0x43, 0x23, 0x32, 0x42, 0x32, 0x42, 0x92, 0x82, 0x82, 0x82, 0x82, 0x82, 0x82, 0x98, 0x38, // 2
+    0xE3, 0x75, 0x52, 0x32, 0x42, 0x32, 0x92, 0x73, 0x83, 0xA2, 0xA2, 0x92, 0x32, 0x42, 0x33, 0x23, 0x46, 0x64, // 3
+    0xF0, 0x12, 0x83, 0x83, 0x74, 0x74, 0x71, 0x12, 0x62, 0x12, 0x62, 0x12, 0x52, 0x22, 0x58, 0x38, 0x72, 0x92, 0x92, // 4
+    0xC7, 0x47, 0x42, 0x92, 0x92, 0x92, 0x13, 0x57, 0x42, 0x33, 0x92, 0x92, 0x32, 0x42, 0x33, 0x23, 0x46, 0x64, // 5
+    0xE4, 0x66, 0x52, 0x23, 0x32, 0x42, 0x32, 0x92, 0x13, 0x57, 0x43, 0x23, 0x32, 0x42, 0x32, 0x42, 0x32, 0x42, 0x42, 0x23, 0x46, 0x64, // 6
+    0xC8, 0x38, 0x92, 0x82, 0x92, 0x82, 0x92, 0x82, 0x92, 0x92, 0x91, 0x92, 0x92, 0x92, // 7
+    0xE4, 0x66, 0x42, 0x33, 0x32, 0x42, 0x32, 0x42, 0x41, 0x41, 0x64, 0x66, 0x42, 0x42, 0x32, 0x42, 0x32, 0x42, 0x32, 0x42, 0x46, 0x64, // 8
+    0xE4, 0x66, 0x43, 0x22, 0x42, 0x42, 0x32, 0x42, 0x32, 0x42, 0x33, 0x23, 0x47, 0x53, 0x12, 0x92, 0x32, 0x42, 0x33, 0x22, 0x56, 0x64, // 9
+    0xF0, 0xF0, 0xF0, 0xE2, 0x92, 0xF0, 0xF0, 0xF0, 0xF0, 0xF2, 0x92, // :
+    0xF0, 0xF0, 0xF0, 0xF0, 0xA2, 0x92, 0xF0, 0xF0, 0xF0, 0xF0, 0x42, 0x92, 0xA1, 0xA1, 0x91, // ;
+    0xF0, 0xF0, 0xF0, 0x71, 0x83, 0x63, 0x63, 0x72, 0xA3, 0xA3, 0xA3, 0xA1, // <
+    0xF0, 0xF0, 0xF0, 0xB8, 0x38, 0xF0, 0xA8, 0x38, // =
+    0xF0, 0xF0, 0xF1, 0xA3, 0xA3, 0xA3, 0xA2, 0x73, 0x63, 0x63, 0x81, // >
+    0xE5, 0x57, 0x33, 0x33, 0x22, 0x52, 0x92, 0x83, 0x73, 0x73, 0x73, 0x82, 0x92, 0xF0, 0x52, 0x92, // ?
+    0xE4, 0x66, 0x52, 0x32, 0x33, 0x32, 0x32, 0x33, 0x32, 0x15, 0x32, 0x12, 0x12, 0x32, 0x12, 0x12, 0x32, 0x15, 0x32, 0x24, 0x32, 0xA2, 0x21, 0x65, 0x73, // @
+    0xF3, 0x83, 0x72, 0x12, 0x62, 0x12, 0x62, 0x12, 0x62, 0x12, 0x52, 0x32, 0x42, 0x32, 0x47, 0x47, 0x42, 0x32, 0x32, 0x52, 0x22, 0x52, 0x22, 0x52, // A
+    0xC5, 0x66, 0x52, 0x32, 0x42, 0x32, 0x42, 0x32, 0x42, 0x32, 0x46, 0x56, 0x52, 0x32, 0x42, 0x42, 0x32, 0x42, 0x32, 0x33, 0x37, 0x46, // B
+    0xE4, 0x66, 0x52, 0x32, 0x32, 0x42, 0x32, 0x92, 0x92, 0x92, 0x92, 0x92, 0x92, 0x42, 0x42, 0x32, 0x46, 0x64, // C
+    0xC5, 0x67, 0x42, 0x32, 0x42, 0x33, 0x32, 0x42, 0x32, 0x42, 0x32, 0x42, 0x32, 0x42, 0x32, 0x42, 0x32, 0x42, 0x32, 0x32, 0x42, 0x32, 0x46, 0x55, // D
+    0xC8, 0x38, 0x32, 0x92, 0x92, 0x92, 0x97, 0x47, 0x42, 0x92, 0x92, 0x92, 0x98, 0x38, // E
+    0xC8, 0x38, 0x32, 0x92, 0x92, 0x92, 0x97, 0x47, 0x42, 0x92, 0x92, 0x92, 0x92, 0x92, // F
+    0xE4, 0x66, 0x52, 0x32, 0x32, 0x42, 0x32, 0x92, 0x92, 0x92, 0x33, 0x32, 0x33, 0x32, 0x42, 0x32, 0x42, 0x42, 0x32, 0x47, 0x54, // G
+    0xC2, 0x42, 0x32, 0x42, 0x32, 0x42, 0x32, 0x42, 0x32, 0x42, 0x32, 0x42, 0x38, 0x38, 0x32, 0x42, 0x32, 0x42, 0x32, 0x42, 0x32, 0x42, 0x32, 0x42, 0x32, 0x42, // H
+    0xD6, 0x56, 0x72, 0x92, 0x92, 0x92, 0x92, 0x92, 0x92, 0x92, 0x92, 0x92, 0x76, 0x56, // I
+    0xF0, 0x32, 0x92, 0x92, 0x92, 0x92, 0x92, 0x92, 0x92, 0x92, 0x32, 0x42, 0x32, 0x42, 0x33, 0x23, 0x46, 0x64, // J
+    0xC2, 0x52, 0x22, 0x42, 0x32, 0x32, 0x42, 0x22, 0x52, 0x22, 0x52, 0x12, 0x64, 0x75, 0x62, 0x22, 0x52, 0x22, 0x52, 0x32, 0x42, 0x42, 0x32, 0x42, 0x32, 0x52, // K
+    0xC2, 0x92, 0x92, 0x92, 0x92, 0x92, 0x92, 0x92, 0x92, 0x92, 0x92, 0x92, 0x98, 0x38, // L
+    0xC3, 0x33, 0x23, 0x33, 0x24, 0x14, 0x24, 0x11, 0x12, 0x22, 0x11, 0x11, 0x12, 0x22, 0x11, 0x11, 0x12, 0x22, 0x13, 0x12, 0x22, 0x21, 0x22, 0x22, 0x52, 0x22, 0x52, 0x22, 0x52, 0x22, 0x52, 0x22, 0x52, 0x22, 0x52, // M
+    0xC3, 0x32, 0x33, 0x32, 0x34, 0x22, 0x34, 0x22, 0x34, 0x22, 0x32, 0x12, 0x12, 0x32, 0x12, 0x12, 0x32, 0x12, 0x12, 0x32, 0x21, 0x12, 0x32, 0x24, 0x32, 0x24, 0x32, 0x24, 0x32, 0x33, 0x32, 0x33, // N
+    0xE4, 0x66, 0x52, 0x22, 0x42, 0x42, 0x32, 0x42, 0x32, 0x42, 0x32, 0x42, 0x32, 0x42, 0x32, 0x42, 0x32, 0x42, 0x32, 0x42, 0x42, 0x22, 0x56, 0x64, // O
+    0xC6, 0x57, 0x42, 0x33, 0x32, 0x42, 0x32, 0x42, 0x32, 0x42, 0x32, 0x33, 0x37, 0x46, 0x52, 0x92, 0x92, 0x92, 0x92, // P
+    0xE4, 0x66, 0x52, 0x22, 0x42, 0x42, 0x32, 0x42, 0x32, 0x42, 0x32, 0x42, 0x32, 0x42, 0x32, 0x42, 0x32, 0x21, 0x12, 0x32, 0x24, 0x42, 0x22, 0x57, 0x54, 0x21, // Q
+    0xC6, 0x57, 0x42, 0x33, 0x32, 0x42, 0x32, 0x42, 0x32, 0x33, 0x37, 0x46, 0x52, 0x22, 0x52, 0x32, 0x42, 0x32, 0x42, 0x42, 0x32, 0x42, 0x32, 0x52, // R
+    0xF3, 0x75, 0x52, 0x32, 0x42, 0x32, 0x42, 0x93, 0x94, 0x93, 0x93, 0x32, 0x42, 0x32, 0x42, 0x42, 0x32, 0x46, 0x64, // S
+    0xBA, 0x1A, 0x52, 0x92, 0x92, 0x92, 0x92, 0x92, 0x92, 0x92, 0x92, 0x92, 0x92, 0x92, // T
+    0xC2, 0x42, 0x32, 0x42, 0x32, 0x42, 0x32, 0x42, 0x32, 0x42, 0x32, 0x42, 0x32, 0x42, 0x32, 0x42, 0x32, 0x42, 0x32, 0x42, 0x32, 0x42, 0x33, 0x23, 0x46, 0x64, // U
+    0xC2, 0x52, 0x22, 0x52, 0x22, 0x52, 0x32, 0x32, 0x42, 0x32, 0x42, 0x32, 0x52, 0x12, 0x62, 0x12, 0x62, 0x12, 0x62, 0x12, 0x73, 0x83, 0x83, 0x91, // V
+    0xB2, 0x62, 0x12, 0x62, 0x12, 0x62, 0x12, 0x62, 0x12, 0x62, 0x12, 0x22, 0x22, 0x21, 0x22, 0x21, 0x31, 0x22, 0x21, 0x31, 0x14, 0x11, 0x31, 0x11, 0x21, 0x11, 0x31, 0x11, 0x21, 0x11, 0x33, 0x23, 0x32, 0x42, 0x32, 0x42, // W
+    0xB2, 0x62, 0x22, 0x51, 0x32, 0x42, 0x42, 0x22, 0x53, 0x12, 0x64, 0x82, 0x92, 0x84, 0x75, 0x53, 0x12, 0x43, 0x32, 0x32, 0x42, 0x22, 0x62, // X
+    0xB2, 0x62, 0x22, 0x42, 0x32, 0x42, 0x42, 0x22, 0x52, 0x22, 0x64, 0x74, 0x82, 0x92, 0x92, 0x92, 0x92, 0x92, 0x92, // Y
+    0xD7, 0x47, 0x92, 0x82, 0x92, 0x82, 0x82, 0x92, 0x82, 0x92, 0x82, 0x82, 0x98, 0x38, // Z
+    0x44, 0x74, 0x72, 0x92, 0x92, 0x92, 0x92, 0x92, 0x92, 0x92, 0x92, 0x92, 0x92, 0x92, 0x92, 0x92, 0x94, 0x74, // [
+    0xE2, 0x92, 0x92, 0xA2, 0x92, 0x92, 0x92, 0xA2, 0x92, 0x92, 0x92, 0xA2, 0x92, 0x92, // backslash
+    0x34, 0x74, 0x92, 0x92, 0x92, 0x92, 0x92, 0x92, 0x92, 0x92, 0x92, 0x92, 0x92, 0x92, 0x92, 0x92, 0x74, 0x74, // ]
+    0xF2, 0x92, 0x84, 0x71, 0x21, 0x62, 0x22, 0x52, 0x22, 0x42, 0x42, 0x32, 0x42, // ^
+    0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xBB, // _
+    0xD3, 0x92, 0xA2, // `
+    0xF0, 0xF0, 0xF0, 0xD5, 0x57, 0x32, 0x42, 0x92, 0x56, 0x47, 0x32, 0x42, 0x32, 0x33, 0x38, 0x43, 0x32, // a
+    0xC2, 0x92, 0x92, 0x92, 0x92, 0x13, 0x57, 0x43, 0x23, 0x32, 0x42, 0x32, 0x42, 0x32, 0x42, 0x32, 0x42, 0x33, 0x23, 0x37, 0x42, 0x13, // b
+    0xF0, 0xF0, 0xF0, 0xD4, 0x66, 0x43, 0x23, 0x32, 0x42, 0x32, 0x92, 0x92, 0x42, 0x33, 0x23, 0x46, 0x64, // c
+    0xF0, 0x32, 0x92, 0x92, 0x92, 0x53, 0x12, 0x47, 0x33, 0x23, 0x32, 0x42, 0x32, 0x42, 0x32, 0x42, 0x32, 0x42, 0x33, 0x23, 0x47, 0x53, 0x12, // d
+    0xF0, 0xF0, 0xF0, 0xD4, 0x66, 0x43, 0x22, 0x42, 0x42, 0x38, 0x38, 0x32, 0x93, 0x32, 0x46, 0x64, // e
+    0xF0, 0x15, 0x56, 0x52, 0x92, 0x68, 0x38, 0x62, 0x92, 0x92, 0x92, 0x92, 0x92, 0x92, 0x92, // f
+    0xF0, 0xF0, 0xF0, 0x23, 0x12, 0x47, 0x33, 0x23, 0x32, 0x42, 0x32, 0x42, 0x32, 0x42, 0x32, 0x42, 0x33, 0x23, 0x47, 0x53, 0x12, 0x92, 0x32, 0x33, 0x37, 0x55, // g
+    0xC2, 0x92, 0x92, 0x92, 0x92, 0x14, 0x48, 0x33, 0x32, 0x32, 0x42, 0x32, 0x42, 0x32, 0x42, 0x32, 0x42, 0x32, 0x42, 0x32, 0x42, 0x32, 0x42, // h
+    0xF0, 0x12, 0x92, 0xF0, 0xD5, 0x65, 0x92, 0x92, 0x92, 0x92, 0x92, 0x92, 0x92, 0x92, // i
+    0x52, 0x92, 0xF0, 0xD5, 0x65, 0x92, 0x92, 0x92, 0x92, 0x92, 0x92, 0x92, 0x92, 0x92, 0x51, 0x32, 0x56, 0x64, // j
+    0xC2, 0x92, 0x92, 0x92, 0x92, 0x42, 0x32, 0x32, 0x42, 0x22, 0x52, 0x12, 0x65, 0x63, 0x12, 0x52, 0x32, 0x42, 0x32, 0x42, 0x42, 0x32, 0x52, // k
+    0xD5, 0x65, 0x92, 0x92, 0x92, 0x92, 0x92, 0x92, 0x92, 0x92, 0x92, 0x92, 0x92, 0x92, // l
+    0xF0, 0xF0, 0xF0, 0xA2, 0x13, 0x12, 0x2A, 0x12, 0x23, 0x12, 0x12, 0x22, 0x22, 0x12, 0x22, 0x22, 0x12, 0x22, 0x22, 0x12, 0x22, 0x22, 0x12, 0x22, 0x22, 0x12, 0x22, 0x22, 0x12, 0x22, 0x22, // m
+    0xF0, 0xF0, 0xF0, 0xB2, 0x14, 0x48, 0x33, 0x32, 0x32, 0x42, 0x32, 0x42, 0x32, 0x42, 0x32, 0x42, 0x32, 0x42, 0x32, 0x42, 0x32, 0x42, // n
+    0xF0, 0xF0, 0xF0, 0xD4, 0x66, 0x43, 0x23, 0x32, 0x42, 0x32, 0x42, 0x32, 0x42, 0x32, 0x42, 0x33, 0x23, 0x46, 0x64, // o
+    0xF0, 0xF0, 0xF2, 0x13, 0x57, 0x43, 0x23, 0x32, 0x42, 0x32, 0x42, 0x32, 0x42, 0x32, 0x42, 0x33, 0x23, 0x37, 0x42, 0x13, 0x52, 0x92, 0x92, 0x92, // p
+    0xF0, 0xF0, 0xF0, 0x23, 0x12, 0x47, 0x33, 0x23, 0x32, 0x42, 0x32, 0x42, 0x32, 0x42, 0x32, 0x42, 0x33, 0x23, 0x47, 0x53, 0x12, 0x92, 0x92, 0x92, 0x92, // q
+    0xF0, 0xF0, 0xF0, 0xB2, 0x23, 0x57, 0x43, 0x21, 0x52, 0x92, 0x92, 0x92, 0x92, 0x92, 0x92, // r
+    0xF0, 0xF0, 0xF0, 0xD4, 0x67, 0x32, 0x42, 0x32, 0x97, 0x57, 0x92, 0x32, 0x42, 0x37, 0x64, // s
+    0xF0, 0xB1, 0x92, 0x92, 0x77, 0x47, 0x62, 0x92, 0x92, 0x92, 0x92, 0x92, 0x96, 0x65, // t
+    0xF0, 0xF0, 0xF0, 0xB2, 0x42, 0x32, 0x42, 0x32, 0x42, 0x32, 0x42, 0x32, 0x42, 0x32, 0x42, 0x32, 0x42, 0x32, 0x33, 0x38, 0x44, 0x12, // u
+    0xF0, 0xF0, 0xF0, 0xB2, 0x52, 0x32, 0x32, 0x42, 0x32, 0x42, 0x32, 0x52, 0x12, 0x62, 0x12, 0x62, 0x12, 0x73, 0x83, 0x92, // v
+    0xF0, 0xF0, 0xF0, 0xA2, 0x13, 0x12, 0x22, 0x13, 0x12, 0x22, 0x13, 0x12, 0x31, 0x11, 0x11, 0x11, 0x41, 0x11, 0x11, 0x11, 0x41, 0x11, 0x11, 0x11, 0x43, 0x13, 0x43, 0x13, 0x51, 0x31, 0x61, 0x31, // w
+    0xF0, 0xF0, 0xF0, 0xB2, 0x42, 0x42, 0x22, 0x52, 0x22, 0x64, 0x82, 0x92, 0x84, 0x62, 0x22, 0x52, 0x22, 0x42, 0x42, // x
+    0xF0, 0xF0, 0xF2, 0x42, 0x32, 0x42, 0x42, 0x32, 0x42, 0x22, 0x52, 0x22, 0x62, 0x12, 0x62, 0x12, 0x62, 0x12, 0x73, 0x83, 0x83, 0x73, 0x65, 0x63, // y
+    0xF0, 0xF0, 0xF0, 0xB9, 0x29, 0x82, 0x82, 0x82, 0x82, 0x82, 0x82, 0x89, 0x29, // z
+    0x63, 0x74, 0x72, 0x92, 0x92, 0x92, 0x92, 0x83, 0x73, 0x83, 0x93, 0x92, 0x92, 0x92, 0x92, 0x92, 0x94, 0x83, // {
+    0x52, 0x92, 0x92, 0x92, 0x92, 0x92, 0x92, 0x92, 0x92, 0x92, 0x92, 0x92, 0x92, 0x92, 0x92, 0x92, 0x92, 0x92, // |
+    0x23, 0x84, 0x92, 0x92, 0x92, 0x92, 0x92, 0x93, 0x93, 0x83, 0x73, 0x82, 0x92, 0x92, 0x92, 0x92, 0x74, 0x73, // }
+    0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0x43, 0x31, 0x38, 0x31, 0x33, // ~
+};
+
+const uint16_t Font11x18_Offsets[96] = {
+    0, 0, 14, 24, 48, 76, 106, 131, 136, 154, 172, 180,
+    192, 206, 214, 225, 240, 266, 283, 300, 318, 337, 355, 377,
+    391, 413, 435, 446, 461, 473, 481, 492, 508, 533, 557, 579,
+    597, 621, 635, 649, 670, 696, 710, 728, 754, 768, 803, 835,
+    859, 878, 904, 928, 947, 961, 987, 1011, 1047, 1070, 1089, 1103,
+    1121, 1135, 1153, 1166, 1178, 1181, 1198, 1220, 1237, 1260, 1276, 1291,
+    1317, 1340, 1354, 1372, 1395, 1409, 1440, 1462, 1481, 1505, 1530, 1545,
+    1560, 1574, 1596, 1616, 1648, 1667, 1691, 1704, 1722, 1740, 1758, 1768
+};
+
+/* 16x26, 2567 bytes of runs, 4940 of rows in fonts.c */
+const uint8_t Font16x26_Runs[] = {
+    // sp
+    0x65, 0xB5, 0xB5, 0xB5, 0xB5, 0xB5, 0xB5, 0xB5, 0xB4, 0xC4, 0xD3, 0xD3, 0xD3, 0xD3, 0xD3, 0xF0, 0xF0, 0xF0, 0xF5, 0xB5, 0xB5, // !
+    0x34, 0x34, 0x54, 0x34, 0x54, 0x34, 0x54, 0x34, 0x54, 0x34, 0x54, 0x34, 0x54, 0x34, // "
+    0x73, 0x23, 0x74, 0x23, 0x74, 0x14, 0x73, 0x24, 0x73, 0x23, 0x74, 0x23, 0x4E, 0x1F, 0x53, 0x23, 0x74, 0x23, 0x74, 0x14, 0x74, 0x14, 0x73, 0x24, 0x3F, 0x0F, 0x02, 0x34, 0x14, 0x73, 0x24, 0x73, 0x23, 0x74, 0x23, 0x74, 0x14, 0x73, 0x24, // #
+    0x68, 0x6B, 0x48, 0x13, 0x44, 0x13, 0x84, 0x13, 0x84, 0x13, 0x84, 0x13, 0x88, 0x97, 0xA6, 0xB6, 0xB7, 0x98, 0x88, 0x88, 0x88, 0x88, 0x88, 0x34, 0x18, 0x3C, 0x68, 0xB4, 0xC4, // $
+    0x25, 0x76, 0x13, 0x56, 0x24, 0x37, 0x24, 0x33, 0x13, 0x33, 0x24, 0x13, 0x33, 0x14, 0x23, 0x24, 0x13, 0x33, 0x28, 0x34, 0x17, 0x69, 0xC3, 0xCA, 0x5B, 0x57, 0x22, 0x48, 0x22, 0x34, 0x14, 0x22, 0x24, 0x24, 0x22, 0x23, 0x34, 0x22, 0x14, 0x34, 0x26, 0x5A, 0x76, // %
+    0x56, 0x99, 0x74, 0x14, 0x65, 0x14, 0x65, 0x14, 0x65, 0x14, 0x74, 0x14, 0x78, 0x87, 0x86, 0x89, 0x47, 0x14, 0x46, 0x25, 0x27, 0x35, 0x17, 0x44, 0x17, 0x4C, 0x5C, 0x55, 0x25, 0x37, 0x2E, 0x38, 0x14, // &
+    0x65, 0xB5, 0xB5, 0xB5, 0xB5, 0xB4, 0xD3, // '
+    0xA6, 0x95, 0x95, 0xB4, 0xB4, 0xB5, 0xB4, 0xC4, 0xB5, 0xB4, 0xC4, 0xC4, 0xC4, 0xC4, 0xC4, 0xC5, 0xC4, 0xC4, 0xC5, 0xC4, 0xD4, 0xC5, 0xD5, 0xC6, 0xC4, // (
+    0x16, 0xC5, 0xD5, 0xC4, 0xD4, 0xC5, 0xC4, 0xC4, 0xC5, 0xC4, 0xC4, 0xC4, 0xC4, 0xC4, 0xC4, 0xB5, 0xB4, 0xC4, 0xB5, 0xB4, 0xB4, 0xB5, 0x95, 0x96, 0xA4, // )
+    0x65, 0xB4, 0xD3, 0x83, 0x23, 0x23, 0x3E, 0x26, 0x17, 0x62, 0x21, 0xB2, 0x13, 0x98, 0x74, 0x14, 0x65, 0x24, 0x72, 0x33, // *
+    0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xD3, 0xD3, 0xD3, 0xD3, 0xD3, 0xD3, 0xD3, 0x6F, 0x0F, 0x02, 0x73, 0xD3, 0xD3, 0xD3, 0xD3, 0xD3, // +
+    0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0x85, 0xB5, 0xB5, 0xB5, 0xC4, 0xC4, 0xC4, 0xC3, 0xC3, // ,
+    0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xDD, 0x3D, // -
+    0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0x85, 0xB5, 0xB5, 0xB5, // .
+    0xC4, 0xC4, 0xB4, 0xC4, 0xB4, 0xC4, 0xB4, 0xC4, 0xB4, 0xC4, 0xB4, 0xC4, 0xB4, 0xC4, 0xB4, 0xC4, 0xB4, 0xC4, 0xB4, 0xC4, 0xB4, 0xC4, 0xB4, 0xC4, 0xB4, // /
+    0x57, 0x89, 0x65, 0x15, 0x45, 0x35, 0x34, 0x54, 0x25, 0x55, 0x15, 0x55, 0x14, 0x74, 0x14, 0x74, 0x14, 0x74, 0x14, 0x74, 0x14, 0x74, 0x14, 0x74, 0x14, 0x74, 0x15, 0x55, 0x15, 0x55, 0x24, 0x54, 0x35, 0x35, 0x45, 0x15, 0x69, 0x87, // 0
+    0x84, 0x97, 0x6A, 0x6A, 0xB5, 0xB5, 0xB5, 0xB5, 0xB5, 0xB5, 0xB5, 0xB5, 0xB5, 0xB5, 0xB5, 0xB5, 0xB5, 0xB5, 0xB5, 0x6E, 0x2E, // 1
+    0x47, 0x7B, 0x54, 0x35, 0xC4, 0xC5, 0xB5, 0xB5, 0xB4, 0xC4, 0xB5, 0xA5, 0xA5, 0xA5, 0xA5, 0xB4, 0xB4, 0xB4, 0xB5, 0xB4, 0xCD, 0x3D, // 2
+    0x48, 0x7A, 0x63, 0x35, 0xC5, 0xB5, 0xB5, 0xB4, 0xC4, 0xA5, 0x78, 0x89, 0xC5, 0xC5, 0xC4, 0xC4, 0xC4, 0xC4, 0xB5, 0x43, 0x35, 0x5A, 0x68, // 3
+    0x94, 0xB5, 0xB5, 0xA6, 0x97, 0x88, 0x88, 0x74, 0x14, 0x64, 0x24, 0x64, 0x24, 0x54, 0x34, 0x44, 0x44, 0x44, 0x44, 0x3F, 0x0F, 0x02, 0x94, 0xC4, 0xC4, 0xC4, 0xC4, 0xC4, // 4
+    0x3B, 0x5B, 0x5B, 0x54, 0xC4, 0xC4, 0xC4, 0xC4, 0xC8, 0x8A, 0xB6, 0xB5, 0xC5, 0xB5, 0xC4, 0xB5, 0xB5, 0xB4, 0x53, 0x35, 0x5A, 0x68, // 5
+    0x77, 0x7A, 0x55, 0x33, 0x45, 0xB4, 0xB5, 0xB4, 0xC4, 0xC4, 0x16, 0x5C, 0x37, 0x25, 0x26, 0x45, 0x24, 0x64, 0x24, 0x64, 0x24, 0x64, 0x24, 0x64, 0x25, 0x54, 0x34, 0x45, 0x35, 0x25, 0x5A, 0x86, // 6
+    0x2E, 0x2E, 0x2E, 0xC4, 0xB4, 0xC4, 0xB4, 0xC3, 0xC4, 0xB4, 0xC4, 0xB4, 0xC4, 0xB4, 0xC4, 0xB4, 0xB5, 0xB5, 0xB4, 0xB5, 0xB5, // 7
+    0x58, 0x7A, 0x55, 0x25, 0x44, 0x44, 0x35, 0x44, 0x35, 0x44, 0x44, 0x44, 0x45, 0x24, 0x69, 0x87, 0x89, 0x64, 0x16, 0x45, 0x35, 0x34, 0x55, 0x15, 0x55, 0x15, 0x64, 0x15, 0x64, 0x24, 0x55, 0x26, 0x25, 0x4B, 0x77, // 8
+    0x57, 0x89, 0x64, 0x25, 0x44, 0x45, 0x34, 0x54, 0x25, 0x55, 0x15, 0x55, 0x15, 0x55, 0x15, 0x55, 0x24, 0x55, 0x25, 0x36, 0x3D, 0x56, 0x14, 0xB5, 0xB4, 0xC4, 0xB5, 0xB4, 0x43, 0x35, 0x5A, 0x78, // 9
+    0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xC5, 0xB5, 0xB5, 0xB5, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0x35, 0xB5, 0xB5, 0xB5, // :
+    0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xC5, 0xB5, 0xB5, 0xB5, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0x35, 0xB5, 0xB5, 0xB5, 0xC4, 0xC4, 0xC4, 0xB4, 0xC3, // ;
+    0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0x52, 0xC4, 0xA6, 0x86, 0x86, 0x86, 0x86, 0x87, 0xB6, 0xC6, 0xC6, 0xC6, 0xC6, 0xC4, 0xE2, // <
+    0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xAF, 0x0F, 0x02, 0xF0, 0xF0, 0xF0, 0x3F, 0x0F, 0x02, // =
+    0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0x63, 0xD5, 0xC6, 0xC6, 0xC6, 0xC6, 0xC6, 0xC5, 0x96, 0x86, 0x86, 0x86, 0x86, 0x95, 0xB3, // >
+    0x39, 0x6C, 0x43, 0x55, 0x33, 0x65, 0x23, 0x65, 0xB4, 0xC4, 0xB4, 0xB4, 0xB4, 0xB4, 0xB4, 0xC4, 0xB5, 0xB5, 0xF0, 0xF0, 0xF0, 0xE5, 0xB5, 0xB5, // ?
+    0x67, 0x7B, 0x45, 0x34, 0x35, 0x54, 0x24, 0x37, 0x14, 0x38, 0x14, 0x24, 0x14, 0x13, 0x24, 0x37, 0x24, 0x37, 0x23, 0x38, 0x23, 0x38, 0x23, 0x38, 0x23, 0x29, 0x23, 0x25, 0x13, 0x2A, 0x14, 0x1A, 0x14, 0x25, 0x13, 0x24, 0xD5, 0x33, 0x6A, 0x87, // @
+    0xF0, 0xF0, 0xF0, 0x95, 0xB5, 0xA7, 0x97, 0x97, 0x84, 0x14, 0x74, 0x14, 0x73, 0x25, 0x54, 0x34, 0x54, 0x34, 0x44, 0x45, 0x3D, 0x3E, 0x14, 0x65, 0x14, 0x78, 0x88, 0x97, 0x93, // A
+    0xF0, 0xF0, 0xF0, 0x5B, 0x5C, 0x44, 0x45, 0x34, 0x54, 0x34, 0x54, 0x34, 0x54, 0x34, 0x45, 0x34, 0x35, 0x4A, 0x6B, 0x54, 0x36, 0x34, 0x55, 0x24, 0x55, 0x24, 0x64, 0x24, 0x64, 0x24, 0x55, 0x2D, 0x3B, // B
+    0xF0, 0xF0, 0xF0, 0xA9, 0x5B, 0x36, 0x43, 0x25, 0xB4, 0xB5, 0xB4, 0xC4, 0xC4, 0xC4, 0xC4, 0xC5, 0xB5, 0xC5, 0xB6, 0xB6, 0x52, 0x5B, 0x79, // C
+    0xF0, 0xF0, 0xF0, 0x4B, 0x5D, 0x34, 0x46, 0x24, 0x65, 0x14, 0x65, 0x14, 0x74, 0x14, 0x74, 0x14, 0x74, 0x14, 0x74, 0x14, 0x74, 0x14, 0x74, 0x14, 0x74, 0x14, 0x74, 0x14, 0x65, 0x14, 0x64, 0x24, 0x46, 0x2C, 0x4A, // D
+    0xF0, 0xF0, 0xF0, 0x5E, 0x2E, 0x25, 0xB5, 0xB5, 0xB5, 0xB5, 0xB5, 0xBD, 0x3D, 0x35, 0xB5, 0xB5, 0xB5, 0xB5, 0xB5, 0xBE, 0x2E, // E
+    0xF0, 0xF0, 0xF0, 0x6D, 0x3D, 0x34, 0xC4, 0xC4, 0xC4, 0xC4, 0xC4, 0xCD, 0x3D, 0x34, 0xC4, 0xC4, 0xC4, 0xC4, 0xC4, 0xC4, 0xC4, // F
+    0xF0, 0xF0, 0xF0, 0x99, 0x5C, 0x36, 0x43, 0x25, 0xA5, 0xB5, 0xB4, 0xB5, 0xB5, 0xB5, 0x4C, 0x47, 0x14, 0x74, 0x15, 0x64, 0x15, 0x64, 0x25, 0x54, 0x36, 0x34, 0x4C, 0x69, // G
+    0xF0, 0xF0, 0xF0, 0x45, 0x55, 0x15, 0x55, 0x15, 0x55, 0x15, 0x55, 0x15, 0x55, 0x15, 0x55, 0x15, 0x55, 0x15, 0x55, 0x1F, 0x1F, 0x15, 0x55, 0x15, 0x55, 0x15, 0x55, 0x15, 0x55, 0x15, 0x55, 0x15, 0x55, 0x15, 0x55, 0x15, 0x55, // H
+    0xF0, 0xF0, 0xF0, 0x5E, 0x2E, 0x65, 0xB5, 0xB5, 0xB5, 0xB5, 0xB5, 0xB5, 0xB5, 0xB5, 0xB5, 0xB5, 0xB5, 0xB5, 0xB5, 0x7E, 0x2E, // I
+    0xF0, 0xF0, 0xF0, 0x6B, 0x5B, 0xB5, 0xB5, 0xB5, 0xB5, 0xB5, 0xB5, 0xB5, 0xB5, 0xB5, 0xB5, 0xB5, 0xB4, 0xC4, 0x53, 0x35, 0x5A, 0x68, // J
+    0xF0, 0xF0, 0xF0, 0x54, 0x55, 0x24, 0x54, 0x34, 0x44, 0x44, 0x34, 0x54, 0x24, 0x64, 0x14, 0x79, 0x78, 0x87, 0x98, 0x89, 0x74, 0x15, 0x64, 0x24, 0x64, 0x34, 0x54, 0x35, 0x44, 0x45, 0x34, 0x55, 0x24, 0x64, // K
+    0xF0, 0xF0, 0xF0, 0x55, 0xB5, 0xB5, 0xB5, 0xB5, 0xB5, 0xB5, 0xB5, 0xB5, 0xB5, 0xB5, 0xB5, 0xB5, 0xB5, 0xB5, 0xB5, 0xBE, 0x2E, // L
+    0xF0, 0xF0, 0xF0, 0x35, 0x6B, 0x5B, 0x5C, 0x3D, 0x3D, 0x3E, 0x1F, 0x13, 0x1B, 0x13, 0x17, 0x17, 0x17, 0x16, 0x27, 0x25, 0x27, 0x25, 0x27, 0x24, 0x37, 0x97, 0x97, 0x97, 0x93, // M
+    0xF0, 0xF0, 0xF0, 0x45, 0x64, 0x15, 0x64, 0x16, 0x54, 0x17, 0x44, 0x17, 0x44, 0x18, 0x34, 0x18, 0x34, 0x19, 0x24, 0x14, 0x15, 0x14, 0x14, 0x24, 0x14, 0x14, 0x29, 0x14, 0x38, 0x14, 0x38, 0x14, 0x47, 0x14, 0x56, 0x14, 0x56, 0x14, 0x65, 0x14, 0x65, // N
+    0xF0, 0xF0, 0xF0, 0x87, 0x7B, 0x45, 0x35, 0x25, 0x55, 0x14, 0x74, 0x14, 0x79, 0x79, 0x79, 0x79, 0x79, 0x79, 0x74, 0x14, 0x74, 0x14, 0x74, 0x15, 0x55, 0x25, 0x35, 0x4B, 0x77, // O
+    0xF0, 0xF0, 0xF0, 0x5C, 0x4E, 0x25, 0x45, 0x25, 0x54, 0x25, 0x54, 0x25, 0x54, 0x25, 0x54, 0x25, 0x45, 0x25, 0x36, 0x2C, 0x4A, 0x65, 0xB5, 0xB5, 0xB5, 0xB5, 0xB5, 0xB5, // P
+    0xF0, 0xF0, 0xF0, 0x87, 0x7B, 0x45, 0x35, 0x25, 0x55, 0x14, 0x74, 0x14, 0x79, 0x79, 0x79, 0x79, 0x79, 0x79, 0x74, 0x14, 0x74, 0x14, 0x74, 0x15, 0x55, 0x25, 0x35, 0x4B, 0x78, 0xC5, 0xC6, 0xC4, 0xE2, // Q
+    0xF0, 0xF0, 0xF0, 0x5A, 0x6C, 0x44, 0x36, 0x34, 0x45, 0x34, 0x54, 0x34, 0x54, 0x34, 0x45, 0x34, 0x44, 0x44, 0x26, 0x4A, 0x69, 0x74, 0x15, 0x64, 0x25, 0x54, 0x35, 0x44, 0x45, 0x34, 0x54, 0x34, 0x55, 0x24, 0x64, // R
+    0xF0, 0xF0, 0xF0, 0x89, 0x5C, 0x35, 0x53, 0x34, 0xC4, 0xC4, 0xC5, 0xC7, 0xA9, 0x99, 0xA7, 0xB5, 0xC4, 0xC4, 0x21, 0x85, 0x24, 0x45, 0x3C, 0x59, // S
+    0xF0, 0xF0, 0xF0, 0x3F, 0x0F, 0x02, 0x65, 0xB5, 0xB5, 0xB5, 0xB5, 0xB5, 0xB5, 0xB5, 0xB5, 0xB5, 0xB5, 0xB5, 0xB5, 0xB5, 0xB5, 0xB5, // T
+    0xF0, 0xF0, 0xF0, 0x45, 0x64, 0x15, 0x64, 0x15, 0x64, 0x15, 0x64, 0x15, 0x64, 0x15, 0x64, 0x15, 0x64, 0x15, 0x64, 0x15, 0x64, 0x15, 0x64, 0x15, 0x64, 0x15, 0x64, 0x15, 0x64, 0x24, 0x54, 0x34, 0x54, 0x35, 0x35, 0x4B, 0x77, // U
+    0xF0, 0xF0, 0xF0, 0x34, 0x97, 0x98, 0x83, 0x14, 0x74, 0x15, 0x64, 0x24, 0x54, 0x34, 0x54, 0x35, 0x44, 0x44, 0x34, 0x55, 0x24, 0x55, 0x14, 0x74, 0x14, 0x79, 0x87, 0x97, 0x97, 0xA5, 0xB5, // V
+    0xF0, 0xF0, 0xF0, 0x33, 0xB6, 0xA6, 0xA6, 0x97, 0x25, 0x27, 0x25, 0x27, 0x25, 0x23, 0x13, 0x25, 0x23, 0x14, 0x16, 0x13, 0x1B, 0x13, 0x1F, 0x17, 0x17, 0x17, 0x17, 0x17, 0x16, 0x36, 0x16, 0x35, 0x35, 0x35, 0x35, 0x35, 0x35, // W
+    0xF0, 0xF0, 0xF0, 0x35, 0x83, 0x15, 0x64, 0x25, 0x44, 0x35, 0x35, 0x45, 0x24, 0x69, 0x87, 0x96, 0xB5, 0xB5, 0xA7, 0x89, 0x74, 0x15, 0x54, 0x25, 0x44, 0x45, 0x24, 0x65, 0x14, 0x78, 0x84, // X
+    0xF0, 0xF0, 0xF0, 0x35, 0x83, 0x14, 0x83, 0x15, 0x64, 0x24, 0x54, 0x35, 0x44, 0x45, 0x24, 0x64, 0x14, 0x79, 0x87, 0xA5, 0xB5, 0xB5, 0xB5, 0xB5, 0xB5, 0xB5, 0xB5, 0xB5, // Y
+    0xF0, 0xF0, 0xF0, 0x4F, 0x1F, 0xC4, 0xB5, 0xA5, 0xA5, 0xA5, 0xB4, 0xB4, 0xB5, 0xA5, 0xA5, 0xB4, 0xB4, 0xB5, 0xA5, 0xBF, 0x1F, // Z
+    0x5B, 0x54, 0xC4, 0xC4, 0xC4, 0xC4, 0xC4, 0xC4, 0xC4, 0xC4, 0xC4, 0xC4, 0xC4, 0xC4, 0xC4, 0xC4, 0xC4, 0xC4, 0xC4, 0xC4, 0xC4, 0xC4, 0xC4, 0xCB, 0x5B, // [
+    0x14, 0xC4, 0xD4, 0xC4, 0xD4, 0xC4, 0xD4, 0xC4, 0xD4, 0xC4, 0xD4, 0xC4, 0xD4, 0xC4, 0xD4, 0xC4, 0xD4, 0xC4, 0xD4, 0xC4, 0xD4, 0xC4, 0xD4, 0xC4, 0xD3, // backslash
+    0x1B, 0xC4, 0xC4, 0xC4, 0xC4, 0xC4, 0xC4, 0xC4, 0xC4, 0xC4, 0xC4, 0xC4, 0xC4, 0xC4, 0xC4, 0xC4, 0xC4, 0xC4, 0xC4, 0xC4, 0xC4, 0xC4, 0xC4, 0x5B, 0x5B, // ]
+    0x82, 0xD3, 0xD3, 0xC5, 0xB5, 0xA7, 0x97, 0x93, 0x14, 0x74, 0x14, 0x74, 0x23, 0x64, 0x34, 0x54, 0x34, 0x44, 0x54, 0x34, 0x54, 0x33, 0x74, 0x14, 0x74, 0x14, 0x83, // ^
+    0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0x6F, 0x0F, 0x02, // _
+    0x84, // `
+    0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xA9, 0x5C, 0x44, 0x35, 0xC5, 0xB5, 0xB5, 0x6A, 0x4C, 0x35, 0x35, 0x25, 0x45, 0x24, 0x55, 0x25, 0x45, 0x25, 0x36, 0x3E, 0x37, 0x24, // a
+    0x24, 0xC4, 0xC4, 0xC4, 0xC4, 0xC4, 0xC4, 0x16, 0x5D, 0x36, 0x25, 0x35, 0x45, 0x24, 0x64, 0x24, 0x64, 0x24, 0x64, 0x24, 0x64, 0x24, 0x64, 0x24, 0x64, 0x24, 0x55, 0x24, 0x54, 0x36, 0x25, 0x3C, 0x43, 0x16, // b
+    0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xC9, 0x5C, 0x36, 0x43, 0x25, 0xB5, 0xB4, 0xB5, 0xB5, 0xB5, 0xC4, 0xC5, 0xB5, 0xC6, 0x43, 0x4C, 0x69, // c
+    0xB5, 0xB5, 0xB5, 0xB5, 0xB5, 0xB5, 0x5B, 0x3D, 0x25, 0x36, 0x24, 0x55, 0x15, 0x55, 0x15, 0x55, 0x15, 0x55, 0x14, 0x65, 0x14, 0x65, 0x15, 0x55, 0x15, 0x55, 0x24, 0x46, 0x25, 0x27, 0x3D, 0x46, 0x15, // d
+    0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xC7, 0x7A, 0x55, 0x25, 0x35, 0x44, 0x34, 0x55, 0x15, 0x55, 0x1F, 0x1F, 0x15, 0xB5, 0xC4, 0xC5, 0xC5, 0x53, 0x4C, 0x69, // e
+    0x79, 0x65, 0x41, 0x64, 0xB5, 0xB5, 0xB5, 0x7F, 0x1F, 0x55, 0xB5, 0xB5, 0xB5, 0xB5, 0xB5, 0xB5, 0xB5, 0xB5, 0xB5, 0xB5, 0xB5, 0xB5, // f
+    0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xB6, 0x14, 0x3D, 0x25, 0x27, 0x24, 0x55, 0x15, 0x55, 0x15, 0x55, 0x14, 0x65, 0x14, 0x65, 0x14, 0x65, 0x15, 0x55, 0x15, 0x55, 0x24, 0x46, 0x25, 0x27, 0x3D, 0x46, 0x15, 0xB4, 0xC4, 0xC4, 0x33, 0x45, 0x4B, // g
+    0x24, 0xC4, 0xC4, 0xC4, 0xC4, 0xC4, 0xC4, 0x17, 0x4D, 0x37, 0x24, 0x36, 0x35, 0x25, 0x45, 0x24, 0x55, 0x24, 0x55, 0x24, 0x55, 0x24, 0x55, 0x24, 0x55, 0x24, 0x55, 0x24, 0x55, 0x24, 0x55, 0x24, 0x55, 0x24, 0x55, // h
+    0x75, 0xB5, 0xF0, 0xF0, 0xF0, 0xF0, 0x9A, 0x6A, 0xC4, 0xC4, 0xC4, 0xC4, 0xC4, 0xC4, 0xC4, 0xC4, 0xC4, 0xC4, 0xC4, 0xC4, 0xC4, // i
+    0x85, 0xB5, 0xF0, 0xF0, 0xF0, 0xF0, 0x9B, 0x5B, 0xB5, 0xB5, 0xB5, 0xB5, 0xB5, 0xB5, 0xB5, 0xB5, 0xB5, 0xB5, 0xB5, 0xB5, 0xB5, 0xB5, 0xB5, 0xB4, 0x53, 0x35, 0x5A, // j
+    0x24, 0xC4, 0xC4, 0xC4, 0xC4, 0xC4, 0xC4, 0x55, 0x24, 0x45, 0x34, 0x35, 0x44, 0x25, 0x54, 0x15, 0x64, 0x14, 0x78, 0x88, 0x89, 0x74, 0x15, 0x64, 0x25, 0x54, 0x35, 0x44, 0x45, 0x34, 0x55, 0x24, 0x55, // k
+    0x1B, 0xB5, 0xB5, 0xB5, 0xB5, 0xB5, 0xB5, 0xB5, 0xB5, 0xB5, 0xB5, 0xB5, 0xB5, 0xB5, 0xB5, 0xB5, 0xB5, 0xB5, 0xB5, 0xB5, 0xB5, // l
+    0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0x64, 0x14, 0x24, 0x1F, 0x0F, 0x0F, 0x08, 0x15, 0x28, 0x24, 0x27, 0x33, 0x37, 0x33, 0x37, 0x33, 0x37, 0x33, 0x37, 0x33, 0x37, 0x33, 0x37, 0x33, 0x37, 0x33, 0x37, 0x33, 0x33, // m
+    0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0x84, 0x17, 0x4D, 0x37, 0x24, 0x36, 0x35, 0x25, 0x45, 0x24, 0x55, 0x24, 0x55, 0x24, 0x55, 0x24, 0x55, 0x24, 0x55, 0x24, 0x55, 0x24, 0x55, 0x24, 0x55, 0x24, 0x55, 0x24, 0x55, // n
+    0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xB7, 0x7B, 0x45, 0x35, 0x34, 0x55, 0x15, 0x55, 0x14, 0x74, 0x14, 0x74, 0x14, 0x74, 0x14, 0x74, 0x14, 0x74, 0x15, 0x55, 0x24, 0x55, 0x25, 0x35, 0x4B, 0x77, // o
+    0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0x84, 0x16, 0x5D, 0x36, 0x25, 0x35, 0x45, 0x24, 0x64, 0x24, 0x64, 0x24, 0x64, 0x24, 0x64, 0x24, 0x64, 0x24, 0x64, 0x24, 0x55, 0x25, 0x44, 0x36, 0x25, 0x3C, 0x4B, 0x54, 0xC4, 0xC4, 0xC4, 0xC4, // p
+    0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xB6, 0x13, 0x4C, 0x35, 0x26, 0x34, 0x54, 0x25, 0x54, 0x24, 0x64, 0x24, 0x64, 0x24, 0x64, 0x24, 0x64, 0x24, 0x64, 0x25, 0x54, 0x25, 0x45, 0x35, 0x26, 0x4C, 0x56, 0x14, 0xC4, 0xC4, 0xC4, 0xC4, 0xC4, // q
+    0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0x95, 0x17, 0x3D, 0x38, 0x23, 0x37, 0x33, 0x36, 0x43, 0x35, 0xB5, 0xB5, 0xB5, 0xB5, 0xB5, 0xB5, 0xB5, 0xB5, 0xB5, // r
+    0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xB9, 0x5C, 0x44, 0x53, 0x35, 0xB5, 0xB6, 0xB8, 0xA9, 0xA7, 0xB5, 0xC4, 0xC4, 0x34, 0x45, 0x3C, 0x59, // s
+    0xF0, 0xF0, 0xF0, 0x84, 0xC4, 0xC4, 0x8F, 0x1F, 0x54, 0xC4, 0xC4, 0xC4, 0xC4, 0xC4, 0xC4, 0xC4, 0xC4, 0xC4, 0xC5, 0xCA, 0x79, // t
+    0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0x84, 0x54, 0x34, 0x54, 0x34, 0x54, 0x34, 0x54, 0x34, 0x54, 0x34, 0x54, 0x34, 0x54, 0x34, 0x54, 0x34, 0x54, 0x34, 0x54, 0x34, 0x45, 0x34, 0x36, 0x35, 0x17, 0x4C, 0x56, 0x14, // u
+    0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0x64, 0x93, 0x14, 0x74, 0x14, 0x74, 0x24, 0x54, 0x34, 0x54, 0x35, 0x44, 0x44, 0x34, 0x54, 0x34, 0x64, 0x14, 0x74, 0x14, 0x78, 0x97, 0x97, 0xA5, 0xB5, // v
+    0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0x64, 0xA6, 0x34, 0x36, 0x25, 0x36, 0x25, 0x27, 0x26, 0x17, 0x26, 0x13, 0x1B, 0x13, 0x17, 0x13, 0x13, 0x17, 0x17, 0x17, 0x17, 0x17, 0x17, 0x25, 0x35, 0x35, 0x35, 0x35, 0x35, 0x35, 0x35, // w
+    0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0x75, 0x64, 0x25, 0x44, 0x35, 0x34, 0x55, 0x24, 0x69, 0x87, 0x97, 0xA5, 0xA7, 0x98, 0x79, 0x64, 0x25, 0x45, 0x35, 0x34, 0x55, 0x14, 0x65, // x
+    0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0x65, 0x83, 0x14, 0x74, 0x15, 0x64, 0x24, 0x54, 0x34, 0x54, 0x44, 0x34, 0x54, 0x34, 0x55, 0x24, 0x64, 0x14, 0x79, 0x87, 0x97, 0xA5, 0xB5, 0xB4, 0xC4, 0xC4, 0xB4, 0xB5, 0x87, // y
+    0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0x8E, 0x2E, 0xB5, 0xA5, 0xA5, 0xA5, 0xA5, 0xA5, 0xA5, 0xA5, 0xA5, 0xB4, 0xB4, 0xBF, 0x1F, // z
+    0x78, 0x75, 0xB4, 0xC4, 0xC4, 0xC4, 0xD4, 0xC4, 0xC4, 0xC3, 0xC4, 0x87, 0x97, 0xD4, 0xD3, 0xD4, 0xC4, 0xC4, 0xB4, 0xC4, 0xC4, 0xC4, 0xC5, 0xC8, 0xA6, // {
+    0x73, 0xD3, 0xD3, 0xD3, 0xD3, 0xD3, 0xD3, 0xD3, 0xD3, 0xD3, 0xD3, 0xD3, 0xD3, 0xD3, 0xD3, 0xD3, 0xD3, 0xD3, 0xD3, 0xD3, 0xD3, 0xD3, 0xD3, 0xD3, 0xD3, // |
+    0x28, 0xC5, 0xC4, 0xC4, 0xC4, 0xC4, 0xC3, 0xC4, 0xC4, 0xD3, 0xD4, 0xD7, 0x97, 0x84, 0xC3, 0xC4, 0xC4, 0xD3, 0xD4, 0xC4, 0xC4, 0xC4, 0xB5, 0x78, 0x86, // }
+    0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xF0, 0xD6, 0x53, 0x19, 0x33, 0x13, 0x25, 0x27, 0x3D, 0x56, // ~
+};
+
+const uint16_t Font16x26_Offsets[96] = {
+    0, 0, 21, 35, 74, 103, 146, 179, 186, 211, 236, 256,
+    278, 305, 318, 340, 365, 403, 424, 446, 469, 497, 519, 551,
+    572, 607, 639, 661, 688, 710, 729, 750, 774, 814, 843, 876,
+    899, 934, 955, 976, 1004, 1041, 1062, 1084, 1118, 1139, 1168, 1209,
+    1238, 1266, 1299, 1334, 1358, 1380, 1417, 1448, 1485, 1516, 1544, 1565,
+    1590, 1615, 1640, 1667, 1692, 1693, 1721, 1755, 1778, 1811, 1837, 1859,
+    1899, 1934, 1955, 1982, 2015, 2036, 2071, 2106, 2138, 2176, 2215, 2240,
+    2263, 2284, 2319, 2350, 2387, 2416, 2451, 2472, 2497, 2522, 2547, 2567
+};
@@ -0,0 +1,211 @@
+/*
+ * gfx2d.c
+ *
+ *  Pixel back end (gfx2d.h).
+ *
+ *  The F746 DMA2D has neither an output byte swap nor 1 bit input, so
+ *  both are folded into what it is given. Colours are swapped to panel
+ *  order on the way in: a register to memory fill writes OCOLR as it is,
+ *  and a blend with alpha 0 or 255 returns one of its two colours
+ *  exactly, RGB565 -> RGB888 -> RGB565 being lossless. Glyphs blend A4
+ *  masks (glyph_cache.h) made once per character: the foreground layer
+ *  is the mask in the text colour, the background layer the same mask
+ *  with its alpha replaced by 255 in the background colour.
+ *
+ *  One transfer runs at a time, the next operation waits for the last.
+ */
+
+#include <string.h>
+#include "gfx2d.h"
+#include "glyph_cache.h"
+
+#if GFX2D_DMA2D && !defined(FB_HOST)
+#include "stm32f7xx_hal.h"
+#endif
+
+/* DMA2D register fields, RM0385 */
+#define GFX2D_MODE_M2M      (0UL << 16)
+#define GFX2D_MODE_BLEND    (2UL << 16)
+#define GFX2D_MODE_R2M      (3UL << 16)
+#define GFX2D_CM_RGB565     2UL
+#define GFX2D_CM_A4         10UL
+#define GFX2D_AM_REPLACE    (1UL << 16)
+#define GFX2D_ALPHA(a)      ((uint32_t)(a) << 24)
+#define GFX2D_NLR(w, h)     ((uint32_t)(w) << 16 | (h))
+
+#define GFX2D_SWAP(c)  ((uint16_t)(((c) >> 8) | ((c) << 8)))
+
+static Gfx2D_Stats Stats;
+
+#if GFX2D_DMA2D && !defined(FB_HOST)
+static volatile uint8_t Busy;
+#endif
+
+#if GFX2D_DMA2D
+/* RGB565 to the RGB888 of FGCOLR / BGCOLR, the way the DMA2D expands it */
+static uint32_t Gfx2D_Rgb888(uint16_t c)
+{
+  uint32_t r = c >> 11, g = (c >> 5) & 0x3F, b = c & 0x1F;
+
+  return (r << 3 | r >> 2) << 16 | (g << 2 | g >> 4) << 8 | (b << 3 | b >> 2);
+}
+
+static void Gfx2D_Start(const Gfx2D_Xfer *x)
+{
+  Gfx2D_Wait();
+  Stats.ops++;
+  Stats.pixels += (x->NLR >> 16) * (x->NLR & 0xFFFF);
+
+#ifdef FB_HOST
+  Gfx2D_HostRun(x);
+#else
+  DMA2D->FGMAR = (uint32_t)x->fg;
+  DMA2D->FGOR = x->FGOR;
+  DMA2D->FGPFCCR = x->FGPFCCR;
+  DMA2D->FGCOLR = x->FGCOLR;
+  DMA2D->BGMAR = (uint32_t)x->bg;
+  DMA2D->BGOR = x->BGOR;
+  DMA2D->BGPFCCR = x->BGPFCCR;
+  DMA2D->BGCOLR = x->BGCOLR;
+  DMA2D->OPFCCR = x->OPFCCR;
+  DMA2D->OCOLR = x->OCOLR;
+  DMA2D->OMAR = (uint32_t)x->out;
+  DMA2D->OOR = x->OOR;
+  DMA2D->NLR = x->NLR;
+  Busy = 1;
+  DMA2D->CR = x->CR | DMA2D_CR_START;
+#endif
+}
+#endif
+
+void Gfx2D_Init(void)
+{
+#if GFX2D_DMA2D && !defined(FB_HOST)
+  __HAL_RCC_DMA2D_CLK_ENABLE();
+#endif
+}
+
+/* START clears itself at the end of a transfer and on a configuration error */
+void Gfx2D_Wait(void)
+{
+#if GFX2D_DMA2D && !defined(FB_HOST)
+  if (!Busy)
+    return;
+
+  while (DMA2D->CR & DMA2D_CR_START);
+  if (DMA2D->ISR & (DMA2D_ISR_TEIF | DMA2D_ISR_CEIF))
+    Stats.errors++;
+  DMA2D->IFCR = DMA2D_IFCR_CTCIF | DMA2D_IFCR_CTEIF | DMA2D_IFCR_CCEIF;
+  Busy = 0;
+#endif
+}
+
+void Gfx2D_Fill(uint16_t *dst, uint16_t pitch, uint16_t w, uint16_t h, uint16_t color)
+{
+#if GFX2D_DMA2D
+  if ((uint32_t)w * h >= GFX2D_MIN_PIXELS)
+  {
+    Gfx2D_Xfer x = {
+      .CR = GFX2D_MODE_R2M,
+      .OPFCCR = GFX2D_CM_RGB565,
+      .OCOLR = GFX2D_SWAP(color),
+      .out = dst,
+      .OOR = pitch - w,
+      .NLR = GFX2D_NLR(w, h),
+    };
+    Gfx2D_Start(&x);
+    return;
+  }
+#endif
+  Gfx2D_Wait();
+  Gfx2D_SoftFill(dst, pitch, w, h, color);
+}
+
+void Gfx2D_Copy(uint16_t *dst, uint16_t dst_pitch, const uint16_t *src, uint16_t src_pitch,
+                uint16_t w, uint16_t h)
+{
+#if GFX2D_DMA2D
+  if ((uint32_t)w * h >= GFX2D_MIN_PIXELS)
+  {
+    Gfx2D_Xfer x = {
+      .CR = GFX2D_MODE_M2M,
+      .fg = src,
+      .FGOR = src_pitch - w,
+      .FGPFCCR = GFX2D_CM_RGB565,
+      .OPFCCR = GFX2D_CM_RGB565,
+      .out = dst,
+      .OOR = dst_pitch - w,
+      .NLR = GFX2D_NLR(w, h),
+    };
+    Gfx2D_Start(&x);
+    return;
+  }
+#endif
+  Gfx2D_Wait();
+  Gfx2D_SoftCopy(dst, dst_pitch, src, src_pitch, w, h);
+}
+
+void Gfx2D_Glyph(uint16_t *dst, uint16_t pitch, const FontDef *font, char ch, uint16_t w, uint16_t h,
+                 uint16_t color, uint16_t bgcolor)
+{
+#if GFX2D_DMA2D
+  if ((uint32_t)w * h >= GFX2D_MIN_PIXELS)
+  {
+    const uint8_t *mask = Glyph_GetMask(font, ch);
+    uint16_t skip = GLYPH_MASK_STRIDE(font->width) - w;
+    Gfx2D_Xfer x = {
+      .CR = GFX2D_MODE_BLEND,
+      .fg = mask,
+      .FGOR = skip,
+      .FGPFCCR = GFX2D_CM_A4,
+      .FGCOLR = Gfx2D_Rgb888(GFX2D_SWAP(color)),
+      .bg = mask,
+      .BGOR = skip,
+      .BGPFCCR = GFX2D_CM_A4 | GFX2D_AM_REPLACE | GFX2D_ALPHA(0xFF),
+      .BGCOLR = Gfx2D_Rgb888(GFX2D_SWAP(bgcolor)),
+      .OPFCCR = GFX2D_CM_RGB565,
+      .out = dst,
+      .OOR = pitch - w,
+      .NLR = GFX2D_NLR(w, h),
+    };
+    Gfx2D_Start(&x);
+    return;
+  }
+#endif
+  Gfx2D_Wait();
+  Gfx2D_SoftGlyph(dst, pitch, font, ch, w, h, color, bgcolor);
+}
+
+void Gfx2D_GetStats(Gfx2D_Stats *stats)
+{
+  *stats = Stats;
+}
+
+void Gfx2D_SoftFill(uint16_t *dst, uint16_t pitch, uint16_t w, uint16_t h, uint16_t color)
+{
+  uint16_t c = GFX2D_SWAP(color);
+
+  Stats.soft_ops++;
+  for (uint16_t j = 0; j < h; j++, dst += pitch)
+  {
+    for (uint16_t i = 0; i < w; i++)
+      dst[i] = c;
+  }
+}
+
+void Gfx2D_SoftCopy(uint16_t *dst, uint16_t dst_pitch, const uint16_t *src, uint16_t src_pitch,
+                    uint16_t w, uint16_t h)
+{
+  Stats.soft_ops++;
+  for (uint16_t j = 0; j < h; j++, dst += dst_pitch, src += src_pitch)
+    memcpy(dst, src, w * sizeof(uint16_t));
+}
+
+/* Copy of the colour expanded glyph (glyph_cache.h) */
+void Gfx2D_SoftGlyph(uint16_t *dst, uint16_t pitch, const FontDef *font, char ch, uint16_t w, uint16_t h,
+                     uint16_t color, uint16_t bgcolor)
+{
+  const uint16_t *glyph = Glyph_Get(font, ch, color, bgcolor);
+
+  Gfx2D_SoftCopy(dst, pitch, glyph, font->width, w, h);
+}
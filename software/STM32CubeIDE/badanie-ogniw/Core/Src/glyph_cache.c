@@ -0,0 +1,156 @@
+/*
+ * glyph_cache.c
+ *
+ *  Glyph expansion cache (glyph_cache.h). A glyph is expanded from its
+ *  runs (fonts_packed.c) once per colour pair, after that drawing it is a
+ *  copy. The display shows the same few digits in the same colours, so a
+ *  small direct mapped table keeps nearly all of them. Expanding writes
+ *  whole runs of one colour instead of testing every bit.
+ */
+
+#include <string.h>
+#include "glyph_cache.h"
+#include "gfx2d.h"
+
+#define GLYPH_SWAP(c)  ((uint16_t)(((c) >> 8) | ((c) << 8)))
+
+typedef struct {
+  const uint8_t *font;      /* font runs, NULL: empty slot */
+  uint16_t color;
+  uint16_t bgcolor;
+  char ch;
+  uint16_t pixels[GLYPH_CACHE_PIXELS];
+} Glyph_Slot;
+
+typedef struct {
+  const uint8_t *font;      /* font runs, NULL: empty slot */
+  char ch;
+  uint8_t mask[GLYPH_MASK_BYTES];
+} Glyph_MaskSlot;
+
+static Glyph_Slot Slots[GLYPH_CACHE_SLOTS];
+static uint16_t Scratch[32 * 32];
+static Glyph_MaskSlot MaskSlots[GLYPH_MASK_SLOTS];
+static uint8_t MaskScratch[32 * 32 / 2];
+static Glyph_Stats Stats;
+
+static void Glyph_Expand(const FontDef *font, char ch, uint16_t color, uint16_t bgcolor, uint16_t *out)
+{
+  const uint8_t *run = &font->runs[font->offsets[ch - 32]];
+  const uint8_t *end = &font->runs[font->offsets[ch - 31]];
+  uint16_t *stop = out + font->width * font->height;
+  uint16_t fg = GLYPH_SWAP(color), bg = GLYPH_SWAP(bgcolor);
+
+  /* runs go on across rows, the glyph is stored without a gap */
+  for (; run < end; run++)
+  {
+    for (uint8_t n = *run >> 4; n; n--)
+      *out++ = bg;
+    for (uint8_t n = *run & 0x0F; n; n--)
+      *out++ = fg;
+  }
+  while (out < stop)
+    *out++ = bg;
+}
+
+const uint16_t *Glyph_Get(const FontDef *font, char ch, uint16_t color, uint16_t bgcolor)
+{
+  uint32_t n = (uint32_t)font->width * font->height;
+
+  if (ch < 32 || ch > 126)
+    ch = '?';
+
+  if (n > GLYPH_CACHE_PIXELS)
+  {
+    Stats.uncached++;
+    Glyph_Expand(font, ch, color, bgcolor, Scratch);
+    return Scratch;
+  }
+
+  /* consecutive characters of one font and colour pair get consecutive slots */
+  uint32_t base = color ^ ((uint32_t)bgcolor * 3) ^ ((uint32_t)(uintptr_t)font->runs >> 2);
+  Glyph_Slot *slot = &Slots[(base + (uint32_t)(ch - 32)) % GLYPH_CACHE_SLOTS];
+
+  if (slot->font == font->runs && slot->ch == ch && slot->color == color && slot->bgcolor == bgcolor)
+  {
+    Stats.hits++;
+    return slot->pixels;
+  }
+
+  Stats.misses++;
+  Glyph_Expand(font, ch, color, bgcolor, slot->pixels);
+  slot->font = font->runs;
+  slot->ch = ch;
+  slot->color = color;
+  slot->bgcolor = bgcolor;
+  return slot->pixels;
+}
+
+static void Glyph_ExpandMask(const FontDef *font, char ch, uint8_t *out)
+{
+  const uint8_t *run = &font->runs[font->offsets[ch - 32]];
+  const uint8_t *end = &font->runs[font->offsets[ch - 31]];
+  uint16_t stride = GLYPH_MASK_STRIDE(font->width);
+  uint16_t x = 0, y = 0;
+
+  /* only the foreground is written, mask rows are padded to the stride */
+  memset(out, 0, stride / 2 * font->height);
+  for (; run < end; run++)
+  {
+    x += *run >> 4;
+    while (x >= font->width)
+    {
+      x -= font->width;
+      y++;
+    }
+    for (uint8_t n = *run & 0x0F; n; n--)
+    {
+      uint32_t i = (uint32_t)y * stride + x;
+
+      out[i / 2] |= (i & 1) ? 0xF0 : 0x0F;
+      if (++x == font->width)
+      {
+        x = 0;
+        y++;
+      }
+    }
+  }
+}
+
+const uint8_t *Glyph_GetMask(const FontDef *font, char ch)
+{
+  uint32_t n = (uint32_t)GLYPH_MASK_STRIDE(font->width) / 2 * font->height;
+
+  if (ch < 32 || ch > 126)
+    ch = '?';
+
+  /* the DMA2D may still be reading the buffer about to be rewritten */
+  if (n > GLYPH_MASK_BYTES)
+  {
+    Stats.uncached++;
+    Gfx2D_Wait();
+    Glyph_ExpandMask(font, ch, MaskScratch);
+    return MaskScratch;
+  }
+
+  uint32_t base = (uint32_t)(uintptr_t)font->runs >> 2;
+  Glyph_MaskSlot *slot = &MaskSlots[(base + (uint32_t)(ch - 32)) % GLYPH_MASK_SLOTS];
+
+  if (slot->font == font->runs && slot->ch == ch)
+  {
+    Stats.hits++;
+    return slot->mask;
+  }
+
+  Stats.misses++;
+  Gfx2D_Wait();
+  Glyph_ExpandMask(font, ch, slot->mask);
+  slot->font = font->runs;
+  slot->ch = ch;
+  return slot->mask;
+}
+
+void Glyph_GetStats(Glyph_Stats *stats)
+{
+  *stats = Stats;
+}
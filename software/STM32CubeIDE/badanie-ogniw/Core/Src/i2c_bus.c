@@ -0,0 +1,294 @@
+/*
+ * i2c_bus.c
+ *
+ *  Interrupt driven transaction queue for hi2c1 (SGP30, INA219).
+ *
+ *  Transfers are queued in submit order and started from the completion
+ *  interrupt of the previous one, so the CPU is free while bytes move.
+ *  A transfer queued while the SGP30 is measuring runs during that wait.
+ *  Bus errors and transfers stuck past I2CBUS_TIMEOUT_MS trigger a
+ *  recovery from I2Cbus_Poll: SCL is clocked by hand until a slave
+ *  holding SDA low lets go, a STOP is generated and I2C1 is reinitialised.
+ *  Transfers are a few bytes long, interrupts cost less than DMA setup.
+ */
+
+#include "i2c.h"
+#include "i2c_bus.h"
+
+#define I2CBUS_SCL_Pin   GPIO_PIN_8
+#define I2CBUS_SDA_Pin   GPIO_PIN_9
+#define I2CBUS_GPIO_Port GPIOB
+
+static I2Cbus_Xfer *Queue;
+static I2Cbus_Xfer *volatile Active;
+static volatile uint8_t RecoverPending;
+
+static I2Cbus_Stats Stats;
+
+static void I2Cbus_Kick(void)
+{
+  for (;;)
+  {
+    uint32_t primask = __get_PRIMASK();
+    I2Cbus_Xfer *x;
+    HAL_StatusTypeDef res = HAL_ERROR;
+    uint16_t addr;
+
+    __disable_irq();
+    if (Active || RecoverPending || !Queue)
+    {
+      __set_PRIMASK(primask);
+      return;
+    }
+    x = Queue;
+    Queue = x->next;
+    x->next = NULL;
+    x->state = I2CBUS_ACTIVE;
+    x->start = HAL_GetTick();
+    Active = x;
+    __set_PRIMASK(primask);
+
+    addr = (uint16_t)(x->addr << 1);
+    switch (x->op)
+    {
+      case I2CBUS_WRITE:
+        res = HAL_I2C_Master_Transmit_IT(&hi2c1, addr, x->buf, x->len);
+        break;
+      case I2CBUS_READ:
+        res = HAL_I2C_Master_Receive_IT(&hi2c1, addr, x->buf, x->len);
+        break;
+      case I2CBUS_MEM_WRITE:
+        res = HAL_I2C_Mem_Write_IT(&hi2c1, addr, x->reg, I2C_MEMADD_SIZE_8BIT, x->buf, x->len);
+        break;
+      case I2CBUS_MEM_READ:
+        res = HAL_I2C_Mem_Read_IT(&hi2c1, addr, x->reg, I2C_MEMADD_SIZE_8BIT, x->buf, x->len);
+        break;
+    }
+
+    if (res == HAL_OK)
+      return;
+
+    /* HAL_BUSY here means BUSY stuck in ISR, the bus needs a recovery */
+    Active = NULL;
+    x->error = hi2c1.ErrorCode;
+    x->state = I2CBUS_ERROR;
+    Stats.errors++;
+    if (res == HAL_BUSY)
+      RecoverPending = 1;
+    if (x->done)
+      x->done(x);
+  }
+}
+
+static void I2Cbus_Finish(uint8_t ok)
+{
+  I2Cbus_Xfer *x = Active;
+
+  if (!x)
+    return;
+
+  Active = NULL;
+  x->error = hi2c1.ErrorCode;
+
+  if (ok)
+  {
+    Stats.xfers++;
+    x->state = I2CBUS_DONE;
+  }
+  else
+  {
+    if (x->error == HAL_I2C_ERROR_AF)
+    {
+      Stats.nacks++;
+    }
+    else
+    {
+      Stats.errors++;
+      if (x->error & (HAL_I2C_ERROR_BERR | HAL_I2C_ERROR_ARLO | HAL_I2C_ERROR_TIMEOUT))
+        RecoverPending = 1;
+    }
+    x->state = I2CBUS_ERROR;
+  }
+
+  if (x->done)
+    x->done(x);
+
+  I2Cbus_Kick();
+}
+
+void HAL_I2C_MasterTxCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+  if (hi2c == &hi2c1)
+    I2Cbus_Finish(1);
+}
+
+void HAL_I2C_MasterRxCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+  if (hi2c == &hi2c1)
+    I2Cbus_Finish(1);
+}
+
+void HAL_I2C_MemTxCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+  if (hi2c == &hi2c1)
+    I2Cbus_Finish(1);
+}
+
+void HAL_I2C_MemRxCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+  if (hi2c == &hi2c1)
+    I2Cbus_Finish(1);
+}
+
+void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c)
+{
+  if (hi2c == &hi2c1)
+    I2Cbus_Finish(0);
+}
+
+/* Queue a transfer, safe from interrupts */
+void I2Cbus_Submit(I2Cbus_Xfer *xfer)
+{
+  uint32_t primask = __get_PRIMASK();
+  I2Cbus_Xfer **p;
+
+  xfer->next = NULL;
+  xfer->error = HAL_I2C_ERROR_NONE;
+  xfer->state = I2CBUS_QUEUED;
+
+  __disable_irq();
+  for (p = &Queue; *p; p = &(*p)->next);
+  *p = xfer;
+  __set_PRIMASK(primask);
+
+  I2Cbus_Kick();
+}
+
+/* Main loop service: transfer timeout and bus recovery */
+void I2Cbus_Poll(void)
+{
+  uint32_t primask = __get_PRIMASK();
+  I2Cbus_Xfer *x = NULL;
+
+  __disable_irq();
+  if (Active && (HAL_GetTick() - Active->start) > I2CBUS_TIMEOUT_MS)
+  {
+    x = Active;
+    Active = NULL;
+    RecoverPending = 1;
+  }
+  __set_PRIMASK(primask);
+
+  if (x)
+  {
+    Stats.timeouts++;
+    x->error = HAL_I2C_ERROR_TIMEOUT;
+    x->state = I2CBUS_ERROR;
+    if (x->done)
+      x->done(x);
+  }
+
+  if (RecoverPending)
+  {
+    I2Cbus_Recover();
+    RecoverPending = 0;
+  }
+
+  I2Cbus_Kick();
+}
+
+/* Queue a transfer and wait for it */
+HAL_StatusTypeDef I2Cbus_Transfer(I2Cbus_Xfer *xfer)
+{
+  I2Cbus_Submit(xfer);
+
+  while (xfer->state == I2CBUS_QUEUED || xfer->state == I2CBUS_ACTIVE)
+    I2Cbus_Poll();
+
+  return (xfer->state == I2CBUS_DONE) ? HAL_OK : HAL_ERROR;
+}
+
+/* About 5 us at 72 MHz, a 100 kHz SCL half period */
+static void I2Cbus_Delay(void)
+{
+  for (volatile uint32_t i = 0; i < 60; i++);
+}
+
+/* Free a bus held by a slave stuck mid byte: up to 9 SCL pulses until SDA
+   is released, then a STOP, then a fresh peripheral init */
+void I2Cbus_Recover(void)
+{
+  GPIO_InitTypeDef gpio = {0};
+
+  HAL_I2C_DeInit(&hi2c1);
+
+  HAL_GPIO_WritePin(I2CBUS_GPIO_Port, I2CBUS_SCL_Pin | I2CBUS_SDA_Pin, GPIO_PIN_SET);
+  gpio.Pin = I2CBUS_SCL_Pin | I2CBUS_SDA_Pin;
+  gpio.Mode = GPIO_MODE_OUTPUT_OD;
+  gpio.Pull = GPIO_NOPULL;
+  gpio.Speed = GPIO_SPEED_FREQ_HIGH;
+  HAL_GPIO_Init(I2CBUS_GPIO_Port, &gpio);
+  I2Cbus_Delay();
+
+  for (uint8_t i = 0; i < 9; i++)
+  {
+    if (HAL_GPIO_ReadPin(I2CBUS_GPIO_Port, I2CBUS_SDA_Pin) == GPIO_PIN_SET)
+      break;
+
+    HAL_GPIO_WritePin(I2CBUS_GPIO_Port, I2CBUS_SCL_Pin, GPIO_PIN_RESET);
+    I2Cbus_Delay();
+    HAL_GPIO_WritePin(I2CBUS_GPIO_Port, I2CBUS_SCL_Pin, GPIO_PIN_SET);
+    I2Cbus_Delay();
+  }
+
+  /* STOP: SDA rises while SCL is high */
+  HAL_GPIO_WritePin(I2CBUS_GPIO_Port, I2CBUS_SCL_Pin, GPIO_PIN_RESET);
+  I2Cbus_Delay();
+  HAL_GPIO_WritePin(I2CBUS_GPIO_Port, I2CBUS_SDA_Pin, GPIO_PIN_RESET);
+  I2Cbus_Delay();
+  HAL_GPIO_WritePin(I2CBUS_GPIO_Port, I2CBUS_SCL_Pin, GPIO_PIN_SET);
+  I2Cbus_Delay();
+  HAL_GPIO_WritePin(I2CBUS_GPIO_Port, I2CBUS_SDA_Pin, GPIO_PIN_SET);
+  I2Cbus_Delay();
+
+  MX_I2C1_Init();
+  Stats.recoveries++;
+}
+
+void I2Cbus_GetStats(I2Cbus_Stats *stats)
+{
+  *stats = Stats;
+}
+
+static HAL_StatusTypeDef I2Cbus_Blocking(I2Cbus_Op op, uint8_t addr, uint8_t reg, uint8_t *data, uint16_t len)
+{
+  I2Cbus_Xfer xfer = {
+    .op = op,
+    .addr = addr,
+    .reg = reg,
+    .buf = data,
+    .len = len,
+  };
+
+  return I2Cbus_Transfer(&xfer);
+}
+
+HAL_StatusTypeDef I2Cbus_Write(uint8_t addr, uint8_t *data, uint16_t len)
+{
+  return I2Cbus_Blocking(I2CBUS_WRITE, addr, 0, data, len);
+}
+
+HAL_StatusTypeDef I2Cbus_Read(uint8_t addr, uint8_t *data, uint16_t len)
+{
+  return I2Cbus_Blocking(I2CBUS_READ, addr, 0, data, len);
+}
+
+HAL_StatusTypeDef I2Cbus_MemWrite(uint8_t addr, uint8_t reg, uint8_t *data, uint16_t len)
+{
+  return I2Cbus_Blocking(I2CBUS_MEM_WRITE, addr, reg, data, len);
+}
+
+HAL_StatusTypeDef I2Cbus_MemRead(uint8_t addr, uint8_t reg, uint8_t *data, uint16_t len)
+{
+  return I2Cbus_Blocking(I2CBUS_MEM_READ, addr, reg, data, len);
+}
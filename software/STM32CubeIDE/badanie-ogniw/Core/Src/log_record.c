@@ -0,0 +1,70 @@
+/*
+ * log_record.c
+ *
+ *  Packing of struct sensors into the binary log format (log_record.h).
+ */
+
+#include <math.h>
+#include <string.h>
+#include "main.h"
+#include "log_record.h"
+
+static const LogChannel Channels[] = {
+  { "pressure",    LOG_TYPE_I32, 0, 1   },
+  { "temperature", LOG_TYPE_I16, 0, 100 },
+  { "tvoc_ppb",    LOG_TYPE_U16, 0, 1   },
+  { "co2_eq_ppm",  LOG_TYPE_U16, 0, 1   },
+  { "ethanol",     LOG_TYPE_U16, 0, 512 },
+  { "h2",          LOG_TYPE_U16, 0, 512 },
+  { "voltage_mV",  LOG_TYPE_U16, 0, 1   },
+  { "current_mA",  LOG_TYPE_I16, 0, 1   },
+  { "power_mW",    LOG_TYPE_U16, 0, 1   },
+};
+
+static uint32_t Sequence;
+
+void LogRecord_InitHeader(LogFileHeader *hdr, uint32_t sample_period_ms)
+{
+  memset(hdr, 0, sizeof(*hdr));
+
+  hdr->magic = LOG_MAGIC;
+  hdr->version = LOG_VERSION;
+  hdr->header_size = sizeof(LogFileHeader);
+  hdr->record_size = sizeof(LogRecord);
+  hdr->channel_count = sizeof(Channels) / sizeof(Channels[0]);
+  hdr->sample_period_ms = sample_period_ms;
+  hdr->first_seq = Sequence;
+  hdr->cpu_clock_hz = SystemCoreClock;
+  memcpy(hdr->channels, Channels, sizeof(Channels));
+  hdr->crc = Log_Crc16(hdr, offsetof(LogFileHeader, crc));
+}
+
+void LogRecord_Pack(LogRecord *rec, const struct sensors *s, uint32_t time_ms)
+{
+  rec->seq = Sequence++;
+  rec->time_ms = time_ms;
+  rec->pressure_Pa = s->BMP280pressure;
+  rec->temperature_cC = (int16_t)lroundf(s->BMP280temperature * 100.0f);
+  rec->tvoc_ppb = s->tvoc_ppb;
+  rec->co2_eq_ppm = s->co2_eq_ppm;
+  rec->ethanol_raw = s->scaled_ethanol_signal;
+  rec->h2_raw = s->scaled_h2_signal;
+  rec->voltage_mV = s->INA219_Voltage;
+  rec->current_mA = s->INA219_Current;
+  rec->power_mW = s->INA219_Power;
+  rec->reserved = 0;
+  rec->crc = Log_Crc16(rec, offsetof(LogRecord, crc));
+}
+
+void LogRecord_InitFooter(LogFileFooter *ftr, const LogTiming *timing, uint32_t time_ms)
+{
+  memset(ftr, 0, sizeof(*ftr));
+
+  ftr->magic = LOG_FOOTER_MAGIC;
+  ftr->version = LOG_VERSION;
+  ftr->footer_size = sizeof(LogFileFooter);
+  ftr->next_seq = Sequence;
+  ftr->time_ms = time_ms;
+  ftr->timing = *timing;
+  ftr->crc = Log_Crc16(ftr, offsetof(LogFileFooter, crc));
+}
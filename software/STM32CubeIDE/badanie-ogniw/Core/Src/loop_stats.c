@@ -0,0 +1,138 @@
+/*
+ * loop_stats.c
+ *
+ *  Sample period overrun and jitter instrumentation.
+ *
+ *  The sample period interrupt timestamps each tick with the DWT cycle
+ *  counter. A tick that finds the previous one not yet started is counted
+ *  as missed, the earlier timestamp is kept so the latency still covers
+ *  the whole delay. Latency runs from the tick to the end of that
+ *  sample's work, start jitter is the distance between consecutive starts
+ *  minus the nominal period. Both go into log2 histograms that end up in
+ *  the log footer (log_record.h).
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "dwt.h"
+#include "loop_stats.h"
+
+static LogTiming Timing;
+static uint32_t PeriodCycles;
+static uint32_t TickCycles;
+static uint32_t LastTickCycles;
+static uint32_t LastStartCycles;
+static volatile uint8_t Pending;
+static uint8_t HaveTick;
+static uint8_t HaveStart;
+
+static uint32_t LoopStats_Bucket(uint32_t us)
+{
+  uint32_t b = 32 - __CLZ(us);
+
+  return b < LOG_HIST_BUCKETS ? b : LOG_HIST_BUCKETS - 1;
+}
+
+void LoopStats_Init(uint32_t period_ms)
+{
+  DWT_Init();
+  PeriodCycles = DWT_UsToCycles(period_ms * 1000);
+  LoopStats_Reset();
+}
+
+void LoopStats_Reset(void)
+{
+  uint32_t primask = __get_PRIMASK();
+
+  __disable_irq();
+  memset(&Timing, 0, sizeof(Timing));
+  Timing.period_min_us = UINT32_MAX;
+  Pending = 0;
+  HaveTick = 0;
+  HaveStart = 0;
+  __set_PRIMASK(primask);
+}
+
+void LoopStats_Tick(void)
+{
+  uint32_t now = DWT_Cycles();
+
+  if (HaveTick)
+  {
+    uint32_t us = DWT_CyclesToUs(now - LastTickCycles);
+
+    if (us < Timing.period_min_us)
+      Timing.period_min_us = us;
+    if (us > Timing.period_max_us)
+      Timing.period_max_us = us;
+  }
+  LastTickCycles = now;
+  HaveTick = 1;
+  Timing.ticks++;
+
+  if (Pending)
+  {
+    Timing.missed_ticks++;
+    return;
+  }
+  TickCycles = now;
+  Pending = 1;
+}
+
+void LoopStats_Start(void)
+{
+  uint32_t now = DWT_Cycles();
+
+  if (HaveStart)
+  {
+    uint32_t delta = now - LastStartCycles;
+    uint32_t us = DWT_CyclesToUs(delta > PeriodCycles ? delta - PeriodCycles : PeriodCycles - delta);
+
+    Timing.jitter_hist[LoopStats_Bucket(us)]++;
+    if (us > Timing.jitter_max_us)
+      Timing.jitter_max_us = us;
+  }
+  LastStartCycles = now;
+  HaveStart = 1;
+}
+
+void LoopStats_End(void)
+{
+  uint32_t us;
+
+  if (!Pending)
+    return;
+
+  us = DWT_CyclesToUs(DWT_Cycles() - TickCycles);
+  Timing.latency_hist[LoopStats_Bucket(us)]++;
+  if (us > Timing.latency_max_us)
+    Timing.latency_max_us = us;
+  Pending = 0;
+}
+
+void LoopStats_Get(LogTiming *timing)
+{
+  uint32_t primask = __get_PRIMASK();
+
+  __disable_irq();
+  *timing = Timing;
+  __set_PRIMASK(primask);
+
+  if (timing->period_min_us == UINT32_MAX)
+    timing->period_min_us = 0;
+}
+
+void LoopStats_Print(void)
+{
+  LogTiming t;
+
+  LoopStats_Get(&t);
+  printf("ticks %lu, missed %lu, period %lu..%lu us, latency max %lu us, jitter max %lu us\r\n",
+         t.ticks, t.missed_ticks, t.period_min_us, t.period_max_us, t.latency_max_us, t.jitter_max_us);
+  printf("us < 2^i   latency   jitter\r\n");
+  for (uint32_t i = 0; i < LOG_HIST_BUCKETS; i++)
+  {
+    if (t.latency_hist[i] || t.jitter_hist[i])
+      printf("%8lu %9lu %8lu\r\n", i, t.latency_hist[i], t.jitter_hist[i]);
+  }
+}
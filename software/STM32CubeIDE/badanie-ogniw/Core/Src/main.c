@@ -52,13 +52,31 @@
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
 #include "st7735.h"
+#include "st7735_fb.h"
+#include "spi_bus.h"
+#include "glyph_cache.h"
+#include "gfx2d.h"
+#include "display_fields.h"
+#include "display_chart.h"
 #include "fonts.h"
 #include "testimg.h"
 #include "BMPXX80.h"
 #include "fatfs_sd.h"
+#include "sd_log.h"
+#include "log_record.h"
 #include "sensirion_common.h"
 #include "sgp30.h"
+#include "sgp30_async.h"
 #include "INA219.h"
+#include "i2c_bus.h"
+#include "adc_sampler.h"
+#include "scheduler.h"
+#include "loop_stats.h"
+#include "profiler.h"
+#include "printf_to_uart.h"
+#include "telemetry.h"
+#include "numfmt.h"
+#include <math.h>
 
 /* USER CODE END Includes */
 
@@ -82,12 +100,13 @@
 
 /* USER CODE BEGIN PV */
 uint8_t isProgramStarted = 0;
-uint8_t _interruptFlag = 0;
+uint8_t isLogging = 0;
 
 uint16_t adcPosition = 0;
 
 struct sensors s = {0};
 INA219_t myina219;
+INA219_Sample_t inaSample;
 
 FATFS fs;
 FIL fil;
@@ -98,9 +117,12 @@ FIL fil;
 void SystemClock_Config(void);
 /* USER CODE BEGIN PFP */
 void SDcardInit(char* folder_name);
+FRESULT SDcardCreateFile(const char *name);
 void SDcardWriteData(struct sensors *s);
 void SDcardClose(void);
 void OLEDdisplay(struct sensors *s);
+void OLEDstatus(const char *msg, uint16_t color);
+static void TaskLog(void *ctx);
 /* USER CODE END PFP */
 
 /* Private user code ---------------------------------------------------------*/
@@ -112,21 +134,26 @@ void SDcardInit(char* folder_name) {
     while (retry_count--) {
         res = f_mount(&fs, "", 1);
         if (res == FR_OK) {
+            printf("SD SPI clock %lu Hz\r\n", SD_GetClockHz());
             break;
         }
         printf("Error mounting filesystem! (%d). Retrying...\r\n", res);
-     	  ST7735_WriteString(10, 140, "Error in file!", Font_7x10, ST7735_RED, ST7735_BLACK);
+     	  OLEDstatus("Error in file!", ST7735_RED);
         HAL_Delay(RETRY_DELAY_MS);
     }
 
     retry_count = 5;
     while (retry_count--) {
-        res = f_open(&fil, "test.txt", FA_OPEN_ALWAYS | FA_WRITE);
+#if LOG_PREALLOC_BYTES
+        res = SDcardCreateFile(folder_name);
+#else
+        res = f_open(&fil, folder_name, FA_OPEN_ALWAYS | FA_WRITE);
+#endif
         if (res == FR_OK) {
             break;
         }
         printf("Error opening SDcard file! (%d). Retrying...\r\n", res);
-     	  ST7735_WriteString(10, 140, "Error in file!", Font_7x10, ST7735_RED, ST7735_BLACK);
+     	  OLEDstatus("Error in file!", ST7735_RED);
         HAL_Delay(RETRY_DELAY_MS);
     }
 
@@ -137,84 +164,480 @@ void SDcardInit(char* folder_name) {
         return;
     }
 
-    f_puts("\n--- Nowy pomiar ---\n", &fil);
-    f_puts("TVOC_ppb,CO2_eq_ppm,Ethanol_signal,H2_signal,Temperatura,Cisnienie,Napiecie_mV,Prad_mA,Moc_mW\n", &fil);
+    // rows are staged in RAM and written in whole chunks
+#if LOG_PREALLOC_BYTES
+    res = SDlog_OpenContiguous(&fil, LOG_PREALLOC_BYTES);
+    if (res != FR_OK) {
+        printf("No contiguous space for the log (%d), appending\r\n", res);
+        SDlog_Open(&fil);
+    }
+#else
+    SDlog_Open(&fil);
+#endif
+
+#if LOG_FORMAT == LOG_FORMAT_BINARY
+    // keep records aligned if a previous session was cut short
+    uint32_t tail = f_size(&fil) % sizeof(LogRecord);
+    if (tail) {
+        static const uint8_t pad[sizeof(LogRecord)];
+        SDlog_Write(pad, sizeof(LogRecord) - tail);
+    }
 
-    f_sync(&fil);
+    LogFileHeader header;
+    LogRecord_InitHeader(&header, SAMPLE_PERIOD_MS);
+    SDlog_Write(&header, sizeof(header));
+#else
+    const char header[] = "\n--- Nowy pomiar ---\n"
+                          "TVOC_ppb,CO2_eq_ppm,Ethanol_signal,H2_signal,Temperatura,Cisnienie,Napiecie_mV,Prad_mA,Moc_mW\n";
+    SDlog_Write(header, sizeof(header) - 1);
+#endif
+    SDlog_Sync();
 
 }
 
-void SDcardWriteData(struct sensors *s) {
-	// ERROR SDcard -> OLED
-	if (f_lseek(&fil, f_size(&fil)) != FR_OK) {
-  	 printf("Error seeking in file!\r\n");
-  	 ST7735_WriteString(10, 140, "Error in file!", Font_7x10, ST7735_RED, ST7735_BLACK);
-  	 return;
-	}
+// New file for every session: name.ext -> name_NNN.ext
+FRESULT SDcardCreateFile(const char *name) {
+    const char *ext = strrchr(name, '.');
+    int base = ext ? (int)(ext - name) : (int)strlen(name);
+    char path[32];
+    FRESULT res = FR_EXIST;
 
-	char buffer[200];
-	snprintf(buffer, sizeof(buffer), "%u,%u,%.2f,%.2f,%.2f,%ld,%u,%d,%u\n",
-			s->tvoc_ppb, s->co2_eq_ppm, s->scaled_ethanol_signal/512.0f, s->scaled_h2_signal/512.0f, s->BMP280temperature, s->BMP280pressure,s->INA219_Voltage, s->INA219_Current, s->INA219_Power);
+    for (unsigned n = 1; n < 1000 && res == FR_EXIST; n++) {
+        snprintf(path, sizeof(path), "%.*s_%03u%s", base, name, n, ext ? ext : "");
+        res = f_open(&fil, path, FA_CREATE_NEW | FA_WRITE);
+    }
+    return res;
+}
 
-	if (f_puts(buffer, &fil) < 0) {
-  	 printf("Error writing to file!\r\n");
+void SDcardWriteData(struct sensors *s) {
+#if LOG_FORMAT == LOG_FORMAT_BINARY
+	LogRecord rec;
+	LogRecord_Pack(&rec, s, HAL_GetTick());
+	const void *buffer = &rec;
+	int len = sizeof(rec);
+#else
+	char buffer[200];
+	CsvRow row;
+	CsvRow_Init(&row, buffer, sizeof(buffer));
+	CsvRow_U32(&row, s->tvoc_ppb);
+	CsvRow_U32(&row, s->co2_eq_ppm);
+	CsvRow_Fixed(&row, s->scaled_ethanol_signal, 512, 2);
+	CsvRow_Fixed(&row, s->scaled_h2_signal, 512, 2);
+	CsvRow_Fixed(&row, lroundf(s->BMP280temperature * 100.0f), 100, 2);
+	CsvRow_I32(&row, s->BMP280pressure);
+	CsvRow_U32(&row, s->INA219_Voltage);
+	CsvRow_I32(&row, s->INA219_Current);
+	CsvRow_U32(&row, s->INA219_Power);
+	int len = CsvRow_End(&row);
+	if (len < 0) {
+		return;
 	}
+#endif
 
-	if (f_sync(&fil) != FR_OK) {
-		printf("Error syncing file!\r\n");
+	// ERROR SDcard -> OLED
+	if (SDlog_Write(buffer, len) != FR_OK) {
+  	 printf("Error writing to file!\r\n");
+  	 OLEDstatus("Error in file!", ST7735_RED);
+  	 // keep whatever reached the card consistent
+  	 SDlog_Sync();
 	}
-	f_sync(&fil);
 }
 
 void SDcardClose(void) {
-    if (f_close(&fil) != FR_OK) {
+    LogTiming timing;
+    LoopStats_Get(&timing);
+
+    // sampling loop timing for the whole session
+#if LOG_FORMAT == LOG_FORMAT_BINARY
+    LogFileFooter footer;
+    LogRecord_InitFooter(&footer, &timing, HAL_GetTick());
+    SDlog_Write(&footer, sizeof(footer));
+#else
+    char buffer[160];
+    int len = snprintf(buffer, sizeof(buffer), "# ticks %lu, missed %lu, period %lu..%lu us, latency max %lu us, jitter max %lu us\n",
+            timing.ticks, timing.missed_ticks, timing.period_min_us, timing.period_max_us, timing.latency_max_us, timing.jitter_max_us);
+    if (len > 0 && len < (int)sizeof(buffer)) {
+        SDlog_Write(buffer, len);
+    }
+#endif
+
+    if (SDlog_Close() != FR_OK) {
         printf("Error closing file!\r\n");
     }
 }
 
+// Measurement lines and the status line, each redraws only changed characters
+#if DISPLAY_CHART
+// ten 10 px lines, the chart band (CHART_HISTORY rows) takes the 60 below
+#define OLED_LINE_Y(row) (10 * (row))
+#define OLED_STATUS_Y    OLED_LINE_Y(9)
+#else
+#define OLED_LINE_Y(row) (5 + 15 * (row))
+#define OLED_STATUS_Y    140
+#endif
+#define OLED_FIELD(row) { .x = 5, .y = OLED_LINE_Y(row), .font = &Font_7x10, .color = ST7735_WHITE, .bgcolor = ST7735_BLACK }
+static Field oledFields[] = {
+    OLED_FIELD(0), OLED_FIELD(1), OLED_FIELD(2), OLED_FIELD(3), OLED_FIELD(4),
+    OLED_FIELD(5), OLED_FIELD(6), OLED_FIELD(7), OLED_FIELD(8),
+};
+static Field statusField = { .x = 10, .y = OLED_STATUS_Y, .font = &Font_7x10, .bgcolor = ST7735_BLACK };
+
+// Status line under the measurements, shown at once
+void OLEDstatus(const char *msg, uint16_t color) {
+    if (statusField.color != color) {
+        statusField.color = color;
+        Field_Invalidate(&statusField);
+    }
+    Field_Set(&statusField, msg);
+    FB_Flush();
+}
+
+// One label and value per line into the framebuffer, fixed point without
+// float printf (numfmt.h). The display task sends what changed.
 void OLEDdisplay(struct sensors *s) {
-    char buffer[100];
-    int tempInt = (int)(s->BMP280temperature * 100);
-    int tempFrac = tempInt % 100;
+    char buffer[32];
+    char *p;
 
     // Temperatura
-    snprintf(buffer, sizeof(buffer), "Temp: %d.%02d C", tempInt / 100, tempFrac);
-    ST7735_WriteString(5,  5, buffer, Font_7x10, ST7735_WHITE, ST7735_BLACK);
+    p = NumFmt_Str(buffer, "Temp: ");
+    p = NumFmt_Fixed(p, lroundf(s->BMP280temperature * 100.0f), 100, 2);
+    p = NumFmt_Str(p, " C");
+    *p = '\0';
+    Field_Set(&oledFields[0], buffer);
 
     // Ciśnienie
-    snprintf(buffer, sizeof(buffer), "Prs:  %ld Pa", s->BMP280pressure);
-    ST7735_WriteString(5,  20, buffer, Font_7x10, ST7735_WHITE, ST7735_BLACK);
+    p = NumFmt_Str(buffer, "Prs:  ");
+    p = NumFmt_I32(p, s->BMP280pressure);
+    p = NumFmt_Str(p, " Pa");
+    *p = '\0';
+    Field_Set(&oledFields[1], buffer);
 
     // TVOC
-    snprintf(buffer, sizeof(buffer), "TVOC: %4u ppb", s->tvoc_ppb);
-    ST7735_WriteString(5,  35, buffer, Font_7x10, ST7735_WHITE, ST7735_BLACK);
+    p = NumFmt_Str(buffer, "TVOC: ");
+    p = NumFmt_Right(p, NumFmt_U32(p, s->tvoc_ppb), 4);
+    p = NumFmt_Str(p, " ppb");
+    *p = '\0';
+    Field_Set(&oledFields[2], buffer);
 
     // CO2eq
-    snprintf(buffer, sizeof(buffer), "CO2:  %4u ppm", s->co2_eq_ppm);
-    ST7735_WriteString(5,  50, buffer, Font_7x10, ST7735_WHITE, ST7735_BLACK);
+    p = NumFmt_Str(buffer, "CO2:  ");
+    p = NumFmt_Right(p, NumFmt_U32(p, s->co2_eq_ppm), 4);
+    p = NumFmt_Str(p, " ppm");
+    *p = '\0';
+    Field_Set(&oledFields[3], buffer);
 
     // Etanol/512.0
-    float ethanol = s->scaled_ethanol_signal / 512.0f;
-    snprintf(buffer, sizeof(buffer), "EtOH: %.2f", ethanol);
-    ST7735_WriteString(5,  65, buffer, Font_7x10, ST7735_WHITE, ST7735_BLACK);
+    p = NumFmt_Str(buffer, "EtOH: ");
+    p = NumFmt_Fixed(p, s->scaled_ethanol_signal, 512, 2);
+    *p = '\0';
+    Field_Set(&oledFields[4], buffer);
 
     // H2/512.0
-    float h2 = s->scaled_h2_signal / 512.0f;
-    snprintf(buffer, sizeof(buffer), "H2:   %.2f", h2);
-    ST7735_WriteString(5,  80, buffer, Font_7x10, ST7735_WHITE, ST7735_BLACK);
+    p = NumFmt_Str(buffer, "H2:   ");
+    p = NumFmt_Fixed(p, s->scaled_h2_signal, 512, 2);
+    *p = '\0';
+    Field_Set(&oledFields[5], buffer);
 
     // INA219_Current
-    snprintf(buffer, sizeof(buffer), "Current:  %4d mA", s->INA219_Current);
-    ST7735_WriteString(5,  95, buffer, Font_7x10, ST7735_WHITE, ST7735_BLACK);
+    p = NumFmt_Str(buffer, "Current:  ");
+    p = NumFmt_Right(p, NumFmt_I32(p, s->INA219_Current), 4);
+    p = NumFmt_Str(p, " mA");
+    *p = '\0';
+    Field_Set(&oledFields[6], buffer);
 
     // INA219_Voltage
-    snprintf(buffer, sizeof(buffer), "Voltage:  %4u mV", s->INA219_Voltage);
-    ST7735_WriteString(5,  110, buffer, Font_7x10, ST7735_WHITE, ST7735_BLACK);
+    p = NumFmt_Str(buffer, "Voltage:  ");
+    p = NumFmt_Right(p, NumFmt_U32(p, s->INA219_Voltage), 4);
+    p = NumFmt_Str(p, " mV");
+    *p = '\0';
+    Field_Set(&oledFields[7], buffer);
 
     // INA219_Power
-    snprintf(buffer, sizeof(buffer), "Power:  %4u mW", s->INA219_Power);
-    ST7735_WriteString(5,  125, buffer, Font_7x10, ST7735_WHITE, ST7735_BLACK);
+    p = NumFmt_Str(buffer, "Power:  ");
+    p = NumFmt_Right(p, NumFmt_U32(p, s->INA219_Power), 4);
+    p = NumFmt_Str(p, " mW");
+    *p = '\0';
+    Field_Set(&oledFields[8], buffer);
+
+}
 
+// Tasks (scheduler.h), each one runs to completion
+static void TaskINA219(void *ctx) {
+    // collect the sample started by the previous run, then start the next one
+    if (!INA219_SampleReady(&inaSample)) {
+        return;
+    }
+    if (!inaSample.errors) {
+        static uint32_t last;
+        static int64_t charge_nAs, energy_uWs;
+        uint32_t now = HAL_GetTick();
+        int32_t current_uA = INA219_SampleCurrent_uA(&inaSample);
+
+        // the register counts current LSBs (0.1 mA with the 32V_2A calibration)
+        s.INA219_Current = INA219_SampleCurrent_mA(&inaSample);
+        s.INA219_Voltage = INA219_SampleBusVoltage(&inaSample);
+        s.INA219_Power = INA219_SamplePower(&inaSample);
+
+        // uA * ms = nAs, mW * ms = uWs
+        if (last) {
+            charge_nAs += (int64_t)current_uA * (now - last);
+            energy_uWs += (int64_t)s.INA219_Power * (now - last);
+            s.charge_uAh = (int32_t)(charge_nAs / 3600000);
+            s.energy_uWh = (int32_t)(energy_uWs / 3600);
+        }
+        last = now;
+#if DISPLAY_CHART
+        Chart_Add(s.INA219_Voltage, s.INA219_Current);
+#endif
+        Telemetry_Mark(TELEM_MASK(TELEM_CH_VOLTAGE) | TELEM_MASK(TELEM_CH_CURRENT) | TELEM_MASK(TELEM_CH_POWER) |
+                       TELEM_MASK(TELEM_CH_CHARGE) | TELEM_MASK(TELEM_CH_ENERGY));
+    }
+    INA219_StartSample(&myina219, &inaSample);
+}
+
+// The sensor converts on its own in normal mode, this only reads the latest result
+static void TaskBMP280(void *ctx) {
+    float temperature;
+    int32_t pressure;
+
+    if (BMP280_ReadTemperatureAndPressure(&temperature, &pressure) != 0)
+        return;
+    s.BMP280temperature = temperature;
+    s.BMP280pressure = pressure;
+    Telemetry_Mark(TELEM_MASK(TELEM_CH_PRESSURE) | TELEM_MASK(TELEM_CH_TEMPERATURE));
+}
+
+static void TaskSGP30(void *ctx) {
+    SGPasync_Result sgp;
+
+    // result of the cycle started one period ago, keep the last values if it failed
+    if (SGPasync_GetResult(&sgp) == STATUS_OK) {
+        s.tvoc_ppb = sgp.tvoc_ppb;
+        s.co2_eq_ppm = sgp.co2_eq_ppm;
+        s.scaled_ethanol_signal = sgp.scaled_ethanol_signal;
+        s.scaled_h2_signal = sgp.scaled_h2_signal;
+        Telemetry_Mark(TELEM_MASK(TELEM_CH_TVOC) | TELEM_MASK(TELEM_CH_CO2_EQ) |
+                       TELEM_MASK(TELEM_CH_ETHANOL) | TELEM_MASK(TELEM_CH_H2));
+    }
+    //sgp_set_absolute_humidity()
+    SGPasync_Start();
+}
+
+static void TaskADC(void *ctx) {
+    ADCsampler_Result adc;
+
+    // average of all conversions since the last run
+    if (ADCsampler_Read(&adc)) {
+        adcPosition = adc.avg;
+        s.ADC_avg = adc.avg;
+        Telemetry_Mark(TELEM_MASK(TELEM_CH_ADC));
+    }
+    __HAL_TIM_SET_COMPARE(&htim3, TIM_CHANNEL_1, (adcPosition / 4095.0f)*1000);
+}
+
+// SPI transactions (command and data writes) of the last and the busiest frame
+static uint32_t displayXfers, displayXfersMax;
+
+static void TaskDisplay(void *ctx) {
+    ST7735_Stats before, after;
+#if DISPLAY_FLUSH_MS
+    static uint32_t lastFlush;
+#endif
+
+    ST7735_GetStats(&before);
+    OLEDdisplay(&s);
+#if DISPLAY_CHART
+    // outside the framebuffer, a new line at most once per CHART_SAMPLES_PER_LINE
+    Chart_Update();
+#endif
+#if DISPLAY_FLUSH_MS
+    // changes pile up in the framebuffer until the next flush
+    if (HAL_GetTick() - lastFlush < DISPLAY_FLUSH_MS) {
+        return;
+    }
+    lastFlush = HAL_GetTick();
+#endif
+    FB_Flush();
+    ST7735_GetStats(&after);
+
+    displayXfers = (after.commands + after.data_writes) - (before.commands + before.data_writes);
+    if (displayXfers > displayXfersMax) {
+        displayXfersMax = displayXfers;
+    }
+}
+
+#if TELEMETRY_PERIOD_MS
+static void TaskTelemetry(void *ctx) {
+    static uint32_t lastFull;
+    uint32_t now = HAL_GetTick();
+    uint8_t full = now - lastFull >= TELEMETRY_FULL_MS;
+
+    if (full) {
+        lastFull = now;
+    }
+    Telemetry_Send(&s, now, full);
+}
+#endif
+
+static void TaskSD(void *ctx) {
+    // group commit policy, writes staged rows when a trigger is met
+    if (isLogging) {
+        SDlog_Poll();
+    }
+}
+
+Sched_Task ina219Task  = { .name = "ina219",  .fn = TaskINA219,  .period_ms = INA219_PERIOD_MS,  .prio = 5 };
+Sched_Task logTask     = { .name = "log",     .fn = TaskLog,     .deadline_ms = SAMPLE_PERIOD_MS, .prio = 4 };
+Sched_Task adcTask     = { .name = "adc",     .fn = TaskADC,     .period_ms = ADC_PERIOD_MS,     .prio = 3 };
+Sched_Task bmp280Task  = { .name = "bmp280",  .fn = TaskBMP280,  .period_ms = BMP280_PERIOD_MS,  .prio = 3 };
+Sched_Task sgp30Task   = { .name = "sgp30",   .fn = TaskSGP30,   .period_ms = SGP30_PERIOD_MS,   .prio = 2 };
+Sched_Task displayTask = { .name = "display", .fn = TaskDisplay, .period_ms = DISPLAY_PERIOD_MS, .prio = 1 };
+Sched_Task sdTask      = { .name = "sd",      .fn = TaskSD,      .deadline_ms = SAMPLE_PERIOD_MS, .prio = 0 };
+#if TELEMETRY_PERIOD_MS
+Sched_Task telemTask   = { .name = "telem",   .fn = TaskTelemetry, .period_ms = TELEMETRY_PERIOD_MS, .prio = 3 };
+#endif
+
+// Released by the TIM7 tick, one log row per sample period
+static void TaskLog(void *ctx) {
+    char line[24];
+    char *p;
+
+    LoopStats_Start();
+    p = NumFmt_Str(line, "ADC: ");
+    p = NumFmt_Fixed(p, adcPosition * 100, 4095, 2);
+    p = NumFmt_Str(p, "%\r\n");
+    UARTtx_Write(line, p - line);
+
+    if (isLogging) {
+        PROFILE_BEGIN(sd_write);
+        SDcardWriteData(&s);
+        PROFILE_END(sd_write);
+        Sched_Release(&sdTask);
+    }
+    LoopStats_End();
+}
+
+#if PROFILER_SD_DUMP_MS
+// Profiler table appended to its own file, the log keeps its format
+static void TaskProfilerDump(void *ctx) {
+    static FIL f;
+    char line[96];
+    UINT bw;
+    int len;
+
+    if (!isLogging || f_open(&f, PROFILER_SD_FILE, FA_OPEN_APPEND | FA_WRITE) != FR_OK) {
+        return;
+    }
+    len = snprintf(line, sizeof(line), "# %lu ms\r\n", HAL_GetTick());
+    f_write(&f, line, len, &bw);
+    for (int8_t id = -1; (len = Profiler_Format(line, sizeof(line), id)) > 0; id++) {
+        f_write(&f, line, len, &bw);
+    }
+    f_close(&f);
+}
+
+Sched_Task profilerTask = { .name = "profdump", .fn = TaskProfilerDump, .period_ms = PROFILER_SD_DUMP_MS, .prio = 0 };
+#endif
+
+// Clear screen time against the wire time of a full frame, then the same
+// frame from RAM through the framebuffer, which also restores the screen.
+// Both go into the profiler table.
+static void DisplayBenchmark(void) {
+    uint32_t wire_us = (uint32_t)(ST7735_WIDTH * ST7735_HEIGHT * 16ULL * 1000000 / SPIbus_GetClockHz(SPIBUS_ST7735));
+    uint32_t t0, fill, flush;
+
+    PROFILE_BEGIN(lcd_fill);
+    t0 = PROFILER_NOW();
+    ST7735_FillScreen(ST7735_BLACK);
+    ST7735_Wait();
+    fill = PROFILER_NOW() - t0;
+    PROFILE_END(lcd_fill);
+
+    PROFILE_BEGIN(lcd_frame);
+    t0 = PROFILER_NOW();
+    FB_Invalidate(0, 0, ST7735_WIDTH, ST7735_HEIGHT);
+    FB_Flush();
+    ST7735_Wait();
+    flush = PROFILER_NOW() - t0;
+    PROFILE_END(lcd_frame);
+#if DISPLAY_CHART
+    Chart_Redraw();
+    Chart_Update();
+#endif
+
+    printf("clear screen %lu us, frame from RAM %lu us, wire time %lu us\r\n",
+           fill / PROFILER_TICKS_PER_US, flush / PROFILER_TICKS_PER_US, wire_us);
+}
+
+// UART console: p profiler table, r profiler reset, t sample loop timing,
+// u UART transmit statistics, d display transactions, c display benchmark
+static void ConsolePoll(void) {
+    if (__HAL_UART_GET_FLAG(&huart3, UART_FLAG_ORE)) {
+        __HAL_UART_CLEAR_OREFLAG(&huart3);
+    }
+    if (!__HAL_UART_GET_FLAG(&huart3, UART_FLAG_RXNE)) {
+        return;
+    }
+    switch ((char)(huart3.Instance->RDR & 0xFF)) {
+    case 'p':
+        Profiler_Dump();
+        Sched_Print();
+        break;
+    case 'r':
+        Profiler_Reset();
+        Sched_ResetStats();
+        break;
+    case 't':
+        LoopStats_Print();
+        break;
+    case 'u': {
+        UARTtx_Stats tx;
+        UARTtx_GetStats(&tx);
+        printf("uart tx %lu bytes, %lu dropped, %lu dma, max used %lu of %u\r\n",
+               tx.bytes, tx.dropped, tx.dma_starts, tx.max_used, UARTTX_BUF_SIZE);
+        break;
+    }
+    case 'd': {
+        ST7735_Stats lcd;
+        Glyph_Stats glyph;
+        Gfx2D_Stats gfx;
+        ST7735_GetStats(&lcd);
+        Glyph_GetStats(&glyph);
+        Gfx2D_GetStats(&gfx);
+        printf("display %lu xfers/frame (max %lu), %lu commands, %lu data writes, %lu bytes, %lu errors, glyphs %lu hit %lu miss\r\n",
+               displayXfers, displayXfersMax, lcd.commands, lcd.data_writes, lcd.bytes, lcd.errors, glyph.hits, glyph.misses);
+        printf("dma2d %lu ops, %lu pixels, %lu errors, %lu on the cpu\r\n", gfx.ops, gfx.pixels, gfx.errors, gfx.soft_ops);
+        break;
+    }
+    case 's': {
+        SDlog_Stats log;
+        SD_BusStats bus;
+        SGPasync_Stats sgp;
+        I2Cbus_Stats i2c;
+        SDlog_GetStats(&log);
+        SD_GetBusStats(&bus);
+        printf("sd log %lu rows, %lu bytes, %lu chunks (%lu sectors), %lu spills, %lu errors\r\n",
+               log.rows, log.bytes, log.chunks, log.chunk_sectors, log.spills, log.errors);
+        printf("sd syncs rows %lu (%lu sectors), time %lu (%lu), bytes %lu (%lu), forced %lu (%lu)\r\n",
+               log.syncs[SDLOG_SYNC_BY_ROWS], log.sync_sectors[SDLOG_SYNC_BY_ROWS],
+               log.syncs[SDLOG_SYNC_BY_TIME], log.sync_sectors[SDLOG_SYNC_BY_TIME],
+               log.syncs[SDLOG_SYNC_BY_BYTES], log.sync_sectors[SDLOG_SYNC_BY_BYTES],
+               log.syncs[SDLOG_SYNC_FORCED], log.sync_sectors[SDLOG_SYNC_FORCED]);
+        printf("sd bus %lu transfers, %lu read, %lu written, %lu crc errors, %lu token errors, %lu retries, %lu clock steps, %lu Hz\r\n",
+               bus.spi_transfers, bus.sectors_read, bus.sectors_written, bus.crc_errors, bus.token_errors,
+               bus.retries, bus.clock_steps, SD_GetClockHz());
+        SGPasync_GetStats(&sgp);
+        printf("sgp30 %lu cycles, %lu missed, max late %lu ms, %lu errors\r\n",
+               sgp.cycles, sgp.missed, sgp.max_late_ms, sgp.errors);
+        I2Cbus_GetStats(&i2c);
+        printf("i2c %lu xfers, %lu nacks, %lu errors, %lu timeouts, %lu recoveries\r\n",
+               i2c.xfers, i2c.nacks, i2c.errors, i2c.timeouts, i2c.recoveries);
+        break;
+    }
+    case 'c':
+        DisplayBenchmark();
+        break;
+    }
 }
 
 /* USER CODE END 0 */
@@ -257,14 +680,27 @@ int main(void)
   MX_ADC1_Init();
   MX_TIM3_Init();
   /* USER CODE BEGIN 2 */
+#if TELEMETRY_PERIOD_MS
+  Telemetry_Init(TELEMETRY_BAUDRATE);
+#endif
   HAL_TIM_Base_Start_IT(&htim7);
   HAL_TIM_PWM_Start(&htim3, TIM_CHANNEL_1);
+  // ADC, TIM6 triggered conversions into a DMA double buffer
+  if (ADCsampler_Start(ADCSAMPLER_RATE_HZ) != HAL_OK) {
+  	printf("ADC sampler error\r\n");
+  }
   // OLED
   ST7735_Init();
-  ST7735_FillScreen(ST7735_BLACK);
+  Gfx2D_Init();
+  FB_Init();
+  FB_Flush();
+#if DISPLAY_CHART
+  Chart_Init(ST7735_HEIGHT - CHART_HISTORY);
+#endif
 
   // BMP
-  BMP280_Init(&hspi1, BMP280_TEMPERATURE_16BIT, BMP280_STANDARD, BMP280_FORCEDMODE);
+  BMP280_Init(&hspi1, BMP280_TEMPERATURE_16BIT, BMP280_STANDARD, BMP280_SLEEPMODE);
+  BMP280_SetRate(BMP280_PERIOD_MS, BMP280_NOISE_CPA);
   // SGP
 	if (sgp_probe() != STATUS_OK) {
 		printf("SGP sensor error\r\n");
@@ -274,7 +710,25 @@ int main(void)
 	//INA219_setCalibration_32V_2A(&myina219);
 
 	// SD
-	SDcardInit("test.txt");
+	SDcardInit(LOG_FILE_NAME);
+	isLogging = 1;
+
+	// Tasks
+	INA219_StartSample(&myina219, &inaSample);
+	Sched_Add(&ina219Task);
+	Sched_Add(&logTask);
+	Sched_Add(&adcTask);
+	Sched_Add(&bmp280Task);
+	Sched_Add(&sgp30Task);
+	Sched_Add(&displayTask);
+	Sched_Add(&sdTask);
+#if TELEMETRY_PERIOD_MS
+	Sched_Add(&telemTask);
+#endif
+#if PROFILER_SD_DUMP_MS
+	Sched_Add(&profilerTask);
+#endif
+	LoopStats_Init(SAMPLE_PERIOD_MS);
 	isProgramStarted = 1;
   /* USER CODE END 2 */
 
@@ -286,43 +740,22 @@ int main(void)
 
     /* USER CODE BEGIN 3 */
 
-  	// stele probkowanie
-  	if (_interruptFlag == 1){
-
-    	// ADC
-    	HAL_ADC_Start(&hadc1);
-    	HAL_ADC_PollForConversion(&hadc1, 1);
-    	adcPosition = HAL_ADC_GetValue(&hadc1) ;
-    	printf("ADC: %.2f%%\r\n", (adcPosition / 4095.0f)*100);
-
-    	__HAL_TIM_SET_COMPARE(&htim3, TIM_CHANNEL_1, (adcPosition / 4095.0f)*1000);
-
-
-  		// BMP
-			BMP280_ReadTemperatureAndPressure(&s.BMP280temperature, &s.BMP280pressure);
-
-			// SGP
-			sgp_measure_iaq_blocking_read(&s.tvoc_ppb, &s.co2_eq_ppm);
-			sgp_measure_signals_blocking_read(&s.scaled_ethanol_signal, &s.scaled_h2_signal);
-			//sgp_set_absolute_humidity()
-
-			// INA219
-			s.INA219_Current = INA219_ReadCurrent_raw(&myina219);
-			s.INA219_Voltage = INA219_ReadBusVoltage(&myina219);
-			s.INA219_Power = INA219_ReadPower(&myina219);
-
-
-			// SD
-			SDcardWriteData(&s);
-
-			// OLED
-			OLEDdisplay(&s);
+  	// USER button: close the log before power off
+  	if (isLogging && HAL_GPIO_ReadPin(USER_Btn_GPIO_Port, USER_Btn_Pin) == GPIO_PIN_SET) {
+  		SDcardClose();
+  		isLogging = 0;
+  		OLEDstatus("SD closed", ST7735_GREEN);
+  		LoopStats_Print();
+  	}
 
-			//printf("{%u,%u,%.2f,%.2f,%.2f,%ld,%u,%d,%u}\r\n",
-			//		s.tvoc_ppb, s.co2_eq_ppm, s.scaled_ethanol_signal/512.0f, s.scaled_h2_signal/512.0f, s.BMP280temperature, s.BMP280pressure, s.INA219_Voltage, s.INA219_Current, s.INA219_Power);
+  	// background services: I2C queue, SGP30 measurement cycle, console
+  	I2Cbus_Poll();
+  	PROFILE_BEGIN(sgp_poll);
+  	SGPasync_Poll();
+  	PROFILE_END(sgp_poll);
+  	ConsolePoll();
 
-			_interruptFlag = 0;
-  	}
+  	Sched_Run();
   }
   /* USER CODE END 3 */
 }
@@ -380,10 +813,9 @@ void SystemClock_Config(void)
 
 void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef *htim){
   if (htim == &htim7 && isProgramStarted == 1){
-  	if (_interruptFlag == 1){
-  		printf("Flaga _interruptFlag jest juz 1");
-  	}
-  	_interruptFlag = 1;
+  	// a release while the log task is still pending counts as an overrun
+  	LoopStats_Tick();
+  	Sched_Release(&logTask);
   }
 }
 
@@ -0,0 +1,152 @@
+/*
+ * numfmt.c
+ *
+ *  Number formatting without newlib's float printf (numfmt.h). Digits
+ *  are produced back to front into a small scratch buffer, fixed point
+ *  values are split into whole and fractional parts with integer
+ *  arithmetic only.
+ */
+
+#include <string.h>
+#include "numfmt.h"
+
+static const uint32_t Pow10[NUMFMT_MAX_DECIMALS + 1] = { 1, 10, 100, 1000, 10000 };
+
+char *NumFmt_U32(char *p, uint32_t v)
+{
+  char tmp[10];
+  uint8_t n = 0;
+
+  do
+  {
+    tmp[n++] = (char)('0' + v % 10);
+    v /= 10;
+  } while (v);
+
+  while (n)
+    *p++ = tmp[--n];
+  return p;
+}
+
+char *NumFmt_I32(char *p, int32_t v)
+{
+  if (v < 0)
+  {
+    *p++ = '-';
+    return NumFmt_U32(p, 0u - (uint32_t)v);
+  }
+  return NumFmt_U32(p, (uint32_t)v);
+}
+
+char *NumFmt_Fixed(char *p, int32_t raw, uint32_t divisor, uint8_t decimals)
+{
+  uint32_t mag = raw < 0 ? 0u - (uint32_t)raw : (uint32_t)raw;
+  uint32_t scale, whole, frac, rem;
+  uint64_t num;
+
+  if (decimals > NUMFMT_MAX_DECIMALS)
+    decimals = NUMFMT_MAX_DECIMALS;
+  if (divisor == 0)
+    divisor = 1;
+  scale = Pow10[decimals];
+
+  /* round half to even on exact ties, as printf does */
+  whole = mag / divisor;
+  num = (uint64_t)(mag % divisor) * scale;
+  frac = (uint32_t)(num / divisor);
+  rem = (uint32_t)(num % divisor);
+  if (rem > divisor - rem || (rem == divisor - rem && (decimals ? frac : whole) & 1))
+    frac++;
+  if (frac >= scale)
+  {
+    whole++;
+    frac -= scale;
+  }
+
+  if (raw < 0)
+    *p++ = '-';
+  p = NumFmt_U32(p, whole);
+  if (decimals)
+  {
+    *p++ = '.';
+    for (uint8_t i = decimals; i; i--)
+    {
+      p[i - 1] = (char)('0' + frac % 10);
+      frac /= 10;
+    }
+    p += decimals;
+  }
+  return p;
+}
+
+char *NumFmt_Str(char *p, const char *s)
+{
+  while (*s)
+    *p++ = *s++;
+  return p;
+}
+
+char *NumFmt_Right(char *start, char *end, uint8_t width)
+{
+  size_t len = (size_t)(end - start);
+
+  if (len >= width)
+    return end;
+  memmove(start + (width - len), start, len);
+  memset(start, ' ', width - len);
+  return start + width;
+}
+
+void CsvRow_Init(CsvRow *row, char *buf, size_t size)
+{
+  row->buf = buf;
+  row->p = buf;
+  row->end = buf + size;
+  row->cols = 0;
+  row->overflow = 0;
+}
+
+/* Room for the separator and len characters, writes the separator */
+static uint8_t CsvRow_Next(CsvRow *row, size_t len)
+{
+  if (row->overflow || (size_t)(row->end - row->p) < len + 1)
+  {
+    row->overflow = 1;
+    return 0;
+  }
+  if (row->cols++)
+    *row->p++ = ',';
+  return 1;
+}
+
+void CsvRow_U32(CsvRow *row, uint32_t v)
+{
+  if (CsvRow_Next(row, NUMFMT_MAX))
+    row->p = NumFmt_U32(row->p, v);
+}
+
+void CsvRow_I32(CsvRow *row, int32_t v)
+{
+  if (CsvRow_Next(row, NUMFMT_MAX))
+    row->p = NumFmt_I32(row->p, v);
+}
+
+void CsvRow_Fixed(CsvRow *row, int32_t raw, uint32_t divisor, uint8_t decimals)
+{
+  if (CsvRow_Next(row, NUMFMT_MAX))
+    row->p = NumFmt_Fixed(row->p, raw, divisor, decimals);
+}
+
+void CsvRow_Str(CsvRow *row, const char *s)
+{
+  if (CsvRow_Next(row, strlen(s)))
+    row->p = NumFmt_Str(row->p, s);
+}
+
+int CsvRow_End(CsvRow *row)
+{
+  if (row->overflow || row->p >= row->end)
+    return -1;
+  *row->p++ = '\n';
+  return (int)(row->p - row->buf);
+}
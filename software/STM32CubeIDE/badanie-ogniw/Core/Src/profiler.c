@@ -0,0 +1,160 @@
+/*
+ * profiler.c
+ *
+ *  Named scope profiler.
+ *
+ *  Each scope keeps its count, min, max and sum plus a log-linear
+ *  histogram: values below 2^PROFILER_SUB_BITS get a bucket each, above
+ *  that every octave is split into 2^PROFILER_SUB_BITS buckets. p99 is
+ *  read from the histogram as the upper edge of the bucket holding the
+ *  99th percentile, capped at the max, so it never under-reports.
+ *  No HAL dependency, the host build compiles this file unchanged.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "profiler.h"
+
+#define PROFILER_SUBS (1u << PROFILER_SUB_BITS)
+
+static Profiler_Scope Scopes[PROFILER_MAX_SCOPES];
+static int8_t ScopeCount;
+
+static uint32_t Profiler_Bucket(uint32_t v)
+{
+  uint32_t msb;
+
+  if (v < PROFILER_SUBS)
+    return v;
+
+  msb = 31 - (uint32_t)__builtin_clz(v);
+  return ((msb - PROFILER_SUB_BITS + 1) << PROFILER_SUB_BITS) |
+         ((v >> (msb - PROFILER_SUB_BITS)) & (PROFILER_SUBS - 1));
+}
+
+/* Smallest value that falls into bucket b */
+static uint64_t Profiler_BucketLow(uint32_t b)
+{
+  uint32_t octave = b >> PROFILER_SUB_BITS;
+
+  if (octave == 0)
+    return b;
+  return (uint64_t)(PROFILER_SUBS | (b & (PROFILER_SUBS - 1))) << (octave - 1);
+}
+
+/* Returns the scope id, the existing one if the name is already known,
+   -1 when the table is full */
+int8_t Profiler_Register(const char *name)
+{
+  for (int8_t i = 0; i < ScopeCount; i++)
+  {
+    if (strcmp(Scopes[i].name, name) == 0)
+      return i;
+  }
+
+  if (ScopeCount >= PROFILER_MAX_SCOPES)
+    return -1;
+
+  memset(&Scopes[ScopeCount], 0, sizeof(Scopes[0]));
+  Scopes[ScopeCount].name = name;
+  Scopes[ScopeCount].min = UINT32_MAX;
+  return ScopeCount++;
+}
+
+void Profiler_Record(int8_t id, uint32_t ticks)
+{
+  Profiler_Scope *p;
+
+  if (id < 0 || id >= ScopeCount)
+    return;
+
+  p = &Scopes[id];
+  p->count++;
+  p->sum += ticks;
+  if (ticks < p->min)
+    p->min = ticks;
+  if (ticks > p->max)
+    p->max = ticks;
+  p->hist[Profiler_Bucket(ticks)]++;
+}
+
+/* permille: 990 for p99 */
+uint32_t Profiler_Percentile(const Profiler_Scope *scope, uint32_t permille)
+{
+  uint64_t rank, seen = 0;
+
+  if (!scope->count)
+    return 0;
+
+  rank = ((uint64_t)scope->count * permille + 999) / 1000;
+  for (uint32_t b = 0; b < PROFILER_BUCKETS; b++)
+  {
+    seen += scope->hist[b];
+    if (seen >= rank)
+    {
+      uint64_t high = Profiler_BucketLow(b + 1) - 1;
+      return high < scope->max ? (uint32_t)high : scope->max;
+    }
+  }
+  return scope->max;
+}
+
+const Profiler_Scope *Profiler_Get(int8_t id)
+{
+  if (id < 0 || id >= ScopeCount)
+    return NULL;
+  return &Scopes[id];
+}
+
+/* Hundredths of a microsecond, printed as us with two decimals */
+static int Profiler_Us(char *buf, size_t size, uint64_t ticks)
+{
+  uint64_t us100 = ticks * 100 / PROFILER_TICKS_PER_US;
+
+  return snprintf(buf, size, " %6lu.%02u", (unsigned long)(us100 / 100), (unsigned)(us100 % 100));
+}
+
+/* One table line per scope, id -1 gives the column names.
+   Returns the length, 0 past the last scope. */
+int Profiler_Format(char *buf, size_t size, int8_t id)
+{
+  const Profiler_Scope *p;
+  int len;
+
+  if (id < 0)
+    return snprintf(buf, size, "%-12s %8s %9s %9s %9s %9s  (us)\r\n",
+                    "scope", "count", "min", "avg", "max", "p99");
+
+  p = Profiler_Get(id);
+  if (!p || size < 64)
+    return 0;
+
+  len = snprintf(buf, size, "%-12s %8lu", p->name, (unsigned long)p->count);
+  len += Profiler_Us(buf + len, size - len, p->count ? p->min : 0);
+  len += Profiler_Us(buf + len, size - len, p->count ? p->sum / p->count : 0);
+  len += Profiler_Us(buf + len, size - len, p->max);
+  len += Profiler_Us(buf + len, size - len, Profiler_Percentile(p, 990));
+  len += snprintf(buf + len, size - len, "\r\n");
+  return len;
+}
+
+void Profiler_Dump(void)
+{
+  char line[96];
+
+  for (int8_t id = -1; Profiler_Format(line, sizeof(line), id) > 0; id++)
+    fputs(line, stdout);
+}
+
+/* Clears the statistics, registered scopes keep their ids */
+void Profiler_Reset(void)
+{
+  for (int8_t i = 0; i < ScopeCount; i++)
+  {
+    const char *name = Scopes[i].name;
+
+    memset(&Scopes[i], 0, sizeof(Scopes[i]));
+    Scopes[i].name = name;
+    Scopes[i].min = UINT32_MAX;
+  }
+}
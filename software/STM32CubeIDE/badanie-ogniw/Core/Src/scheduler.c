@@ -0,0 +1,122 @@
+/*
+ * scheduler.c
+ *
+ *  Cooperative run to completion task scheduler.
+ *
+ *  Each Sched_Run call starts at most one task: the highest priority one
+ *  that is due, so the main loop services (I2C queue, SGP30 cycle, SD
+ *  commit policy) run between any two tasks. Periodic tasks are released
+ *  on a fixed grid of period_ms from HAL_GetTick, a task that falls a
+ *  whole period behind skips the missed releases and counts them as
+ *  overruns instead of running back to back to catch up. Event tasks
+ *  (period_ms 0) are released from anywhere, interrupts included.
+ *  Every task run is also recorded in the profiler under the task name.
+ */
+
+#include <stdio.h>
+#include "stm32f7xx_hal.h"
+#include "profiler.h"
+#include "scheduler.h"
+
+static Sched_Task *Tasks;
+
+/* Tasks are kept in priority order, equal priorities in order of adding */
+void Sched_Add(Sched_Task *task)
+{
+  Sched_Task **p;
+
+  task->release = HAL_GetTick();
+  task->released = 0;
+  task->prof = Profiler_Register(task->name);
+  task->next = NULL;
+
+  for (p = &Tasks; *p && (*p)->prio >= task->prio; p = &(*p)->next);
+  task->next = *p;
+  *p = task;
+}
+
+/* Safe from interrupts */
+void Sched_Release(Sched_Task *task)
+{
+  if (task->released)
+  {
+    task->stats.overruns++;
+    return;
+  }
+  task->release = HAL_GetTick();
+  task->released = 1;
+}
+
+static uint8_t Sched_Due(Sched_Task *t, uint32_t now)
+{
+  if (t->period_ms == 0)
+    return t->released;
+  return (int32_t)(now - t->release) >= 0;
+}
+
+/* Run the most urgent due task, returns 0 if nothing was due */
+uint8_t Sched_Run(void)
+{
+  uint32_t now = HAL_GetTick();
+  uint32_t release, start, end, deadline, t0;
+  Sched_Task *t;
+
+  for (t = Tasks; t && !Sched_Due(t, now); t = t->next);
+  if (!t)
+    return 0;
+
+  /* an event task released again while it runs is run once more */
+  release = t->release;
+  if (t->period_ms == 0)
+    t->released = 0;
+
+  start = now;
+  if (start - release > t->stats.max_latency_ms)
+    t->stats.max_latency_ms = start - release;
+
+  t0 = PROFILER_NOW();
+  t->fn(t->ctx);
+  Profiler_Record(t->prof, PROFILER_NOW() - t0);
+
+  end = HAL_GetTick();
+  t->stats.runs++;
+  if (end - start > t->stats.max_exec_ms)
+    t->stats.max_exec_ms = end - start;
+
+  deadline = t->deadline_ms ? t->deadline_ms : t->period_ms;
+  if (deadline && end - release > deadline)
+    t->stats.deadline_misses++;
+
+  if (t->period_ms)
+  {
+    release += t->period_ms;
+    if ((int32_t)(end - release) >= 0)
+    {
+      uint32_t skipped = (end - release) / t->period_ms + 1;
+
+      t->stats.overruns += skipped;
+      release += skipped * t->period_ms;
+    }
+    t->release = release;
+  }
+
+  return 1;
+}
+
+void Sched_ResetStats(void)
+{
+  for (Sched_Task *t = Tasks; t; t = t->next)
+  {
+    Sched_Stats zero = {0};
+    t->stats = zero;
+  }
+}
+
+/* One line per task in priority order, run times are in the profiler */
+void Sched_Print(void)
+{
+  printf("%-12s %8s %8s %8s %8s %8s  (ms)\r\n", "task", "runs", "overrun", "missed", "latency", "exec");
+  for (Sched_Task *t = Tasks; t; t = t->next)
+    printf("%-12s %8lu %8lu %8lu %8lu %8lu\r\n", t->name, t->stats.runs, t->stats.overruns,
+           t->stats.deadline_misses, t->stats.max_latency_ms, t->stats.max_exec_ms);
+}
@@ -0,0 +1,361 @@
+/*
+ * sd_log.c
+ *
+ *  RAM staged writer for the SD card measurement log.
+ *
+ *  Rows are appended to a static buffer. When the buffer reaches the next
+ *  SDLOG_CHUNK_SIZE boundary of the file it is written with one f_write,
+ *  which FatFs turns into a multi-sector SD_disk_write. Metadata (FAT and
+ *  directory entry) is only synced when the commit policy asks for it.
+ *
+ *  Contiguous mode (SDlog_OpenContiguous) preallocates the file with
+ *  f_expand and writes the chunks with disk_write straight to the sectors
+ *  behind it, so the cost of a chunk does not depend on the file length
+ *  (no FAT chain walk, no cluster allocation). The last partial sector is
+ *  kept in RAM and goes through f_write on each commit, which moves the
+ *  file size up to the logged bytes for f_sync. Close trims the unused
+ *  clusters. When the area is full the log carries on with f_write.
+ */
+
+#include <string.h>
+#include "stm32f7xx_hal.h"
+#include "diskio.h"
+#include "fatfs_sd.h"
+#include "sd_log.h"
+
+/* Contiguous mode sets FIL.obj.objsize by hand after f_expand and before
+   the final f_truncate, check that use on a FatFs upgrade */
+#if _FATFS != 68300
+#error "sd_log.c: FIL internals used for FatFs R0.12c (68300)"
+#endif
+
+static FIL *LogFile;
+static uint8_t Chunk[SDLOG_CHUNK_SIZE] __attribute__((aligned(4)));
+static UINT ChunkFill;
+static UINT ChunkTarget;    /* bytes that bring the file offset to a chunk boundary */
+
+/* Contiguous mode, RawSize == 0 when off */
+static FSIZE_t RawSize;     /* preallocated bytes */
+static FSIZE_t RawOffset;   /* file offset of Chunk[0], sector aligned */
+static DWORD RawSector;     /* first sector of the file */
+
+static SDlog_SyncPolicy Policy = { SDLOG_SYNC_ROWS, SDLOG_SYNC_MS, SDLOG_SYNC_BYTES };
+static uint32_t RowsSinceSync;
+static uint32_t BytesSinceSync;
+static uint32_t LastSyncTick;
+
+static SDlog_Stats Stats;
+
+static uint32_t SDlog_SectorsWritten(void)
+{
+  SD_BusStats bus;
+
+  SD_GetBusStats(&bus);
+  return bus.sectors_written;
+}
+
+/* Write the staged bytes and re-align the next chunk to the file offset */
+static FRESULT SDlog_WriteStaged(void)
+{
+  FRESULT res;
+  UINT bw;
+
+  if (!ChunkFill)
+    return FR_OK;
+
+  res = f_write(LogFile, Chunk, ChunkFill, &bw);
+  if (res == FR_OK && bw != ChunkFill)
+    res = FR_DENIED;  /* volume full */
+
+  if (res != FR_OK)
+    Stats.errors++;
+
+  ChunkFill = 0;
+  ChunkTarget = SDLOG_CHUNK_SIZE - (UINT)(f_tell(LogFile) % SDLOG_CHUNK_SIZE);
+
+  return res;
+}
+
+/* Contiguous mode: write the whole staged sectors, the partial one stays
+   staged */
+static FRESULT SDlog_WriteRaw(void)
+{
+  UINT full = ChunkFill / SDLOG_SECTOR_SIZE;
+  UINT rest = ChunkFill % SDLOG_SECTOR_SIZE;
+
+  if (full && disk_write(LogFile->obj.fs->drv, Chunk,
+                         RawSector + (DWORD)(RawOffset / SDLOG_SECTOR_SIZE), full) != RES_OK)
+  {
+    Stats.errors++;
+    return FR_DISK_ERR;
+  }
+
+  if (full)
+  {
+    memmove(Chunk, &Chunk[full * SDLOG_SECTOR_SIZE], rest);
+    RawOffset += full * SDLOG_SECTOR_SIZE;
+    ChunkFill = rest;
+  }
+  ChunkTarget = SDLOG_CHUNK_SIZE - (UINT)(RawOffset % SDLOG_CHUNK_SIZE);
+
+  return FR_OK;
+}
+
+/* Contiguous mode: the partial sector through FatFs. Seeking past the file
+   size and writing extend it to the logged bytes and mark the directory
+   entry for f_sync, the clusters are already chained. */
+static FRESULT SDlog_SyncRaw(void)
+{
+  FRESULT res;
+  UINT bw;
+
+  res = f_lseek(LogFile, RawOffset);
+  if (res == FR_OK && ChunkFill)
+  {
+    res = f_write(LogFile, Chunk, ChunkFill, &bw);
+    if (res == FR_OK && bw != ChunkFill)
+      res = FR_DENIED;
+  }
+  if (res == FR_OK)
+    res = f_sync(LogFile);
+
+  return res;
+}
+
+/* Group commit: staged rows + f_sync */
+static FRESULT SDlog_Commit(SDlog_SyncReason reason)
+{
+  uint32_t sectors = SDlog_SectorsWritten();
+  FRESULT res, res_sync;
+
+  if (RawSize)
+  {
+    res = SDlog_WriteRaw();
+    res_sync = (res == FR_OK) ? SDlog_SyncRaw() : FR_OK;
+  }
+  else
+  {
+    res = SDlog_WriteStaged();
+    res_sync = f_sync(LogFile);
+  }
+  if (res_sync != FR_OK)
+    Stats.errors++;
+
+  Stats.syncs[reason]++;
+  Stats.sync_sectors[reason] += SDlog_SectorsWritten() - sectors;
+
+  RowsSinceSync = 0;
+  BytesSinceSync = 0;
+  LastSyncTick = HAL_GetTick();
+
+  return (res != FR_OK) ? res : res_sync;
+}
+
+/* Check the commit policy, time based trigger included */
+static FRESULT SDlog_CheckPolicy(void)
+{
+  if (Policy.rows && RowsSinceSync >= Policy.rows)
+    return SDlog_Commit(SDLOG_SYNC_BY_ROWS);
+
+  if (Policy.bytes && BytesSinceSync >= Policy.bytes)
+    return SDlog_Commit(SDLOG_SYNC_BY_BYTES);
+
+  if (Policy.ms && (RowsSinceSync || BytesSinceSync) &&
+      (HAL_GetTick() - LastSyncTick) >= Policy.ms)
+    return SDlog_Commit(SDLOG_SYNC_BY_TIME);
+
+  return FR_OK;
+}
+
+/* Attach to an open file positioned at its end */
+FRESULT SDlog_Open(FIL *fil)
+{
+  LogFile = fil;
+  ChunkFill = 0;
+  ChunkTarget = SDLOG_CHUNK_SIZE - (UINT)(f_tell(fil) % SDLOG_CHUNK_SIZE);
+  RawSize = 0;
+  RowsSinceSync = 0;
+  BytesSinceSync = 0;
+  LastSyncTick = HAL_GetTick();
+  memset(&Stats, 0, sizeof(Stats));
+
+  return FR_OK;
+}
+
+/* Attach to a new, empty file and preallocate 'size' contiguous bytes.
+   Fails with FR_DENIED when the volume has no free block that large,
+   the file is then left empty and can be used with SDlog_Open. */
+FRESULT SDlog_OpenContiguous(FIL *fil, FSIZE_t size)
+{
+  FATFS *fs = fil->obj.fs;
+  FRESULT res;
+
+#if _MAX_SS != _MIN_SS
+  if (fs->ssize != SDLOG_SECTOR_SIZE)
+    return FR_INVALID_PARAMETER;
+#endif
+  if (f_size(fil) != 0)
+    return FR_DENIED;
+
+  size = (size + SDLOG_CHUNK_SIZE - 1) / SDLOG_CHUNK_SIZE * SDLOG_CHUNK_SIZE;
+  res = f_expand(fil, size, 1);
+  if (res != FR_OK)
+    return res;
+
+  SDlog_Open(fil);
+  RawSize = size;
+  RawOffset = 0;
+  RawSector = fs->database + (DWORD)fs->csize * (fil->obj.sclust - 2);
+
+  /* f_expand sets the size to the whole area, the directory entry starts
+     empty instead. Commit the cluster chain now, the hot path never
+     touches the FAT. */
+  fil->obj.objsize = 0;
+  res = f_sync(fil);
+  if (res != FR_OK)
+    RawSize = 0;
+
+  return res;
+}
+
+/* Contiguous mode: the area is full, the staged bytes go out and the log
+   continues with f_write, first into the chained clusters past the file
+   size, then into new ones */
+static FRESULT SDlog_EndContiguous(void)
+{
+  FRESULT res;
+
+  res = SDlog_WriteRaw();
+  if (res == FR_OK)
+    res = SDlog_SyncRaw();
+  if (res != FR_OK)
+  {
+    Stats.errors++;
+    return res;
+  }
+
+  Stats.spills++;
+  RawSize = 0;
+  ChunkFill = 0;
+  ChunkTarget = SDLOG_CHUNK_SIZE - (UINT)(f_tell(LogFile) % SDLOG_CHUNK_SIZE);
+
+  return FR_OK;
+}
+
+/* Append one row */
+FRESULT SDlog_Write(const void *data, UINT len)
+{
+  const uint8_t *src = data;
+  FRESULT res = FR_OK;
+
+  if (!LogFile)
+    return FR_NOT_READY;
+
+  if (RawSize && RawOffset + ChunkFill + len > RawSize)
+  {
+    res = SDlog_EndContiguous();
+    if (res != FR_OK)
+      return res;
+  }
+
+  Stats.rows++;
+  Stats.bytes += len;
+  RowsSinceSync++;
+  BytesSinceSync += len;
+
+  while (len)
+  {
+    UINT n = ChunkTarget - ChunkFill;
+    if (n > len)
+      n = len;
+
+    memcpy(&Chunk[ChunkFill], src, n);
+    ChunkFill += n;
+    src += n;
+    len -= n;
+
+    if (ChunkFill == ChunkTarget)
+    {
+      uint32_t sectors = SDlog_SectorsWritten();
+
+      res = RawSize ? SDlog_WriteRaw() : SDlog_WriteStaged();
+      if (res != FR_OK)
+        return res;
+
+      Stats.chunks++;
+      Stats.chunk_sectors += SDlog_SectorsWritten() - sectors;
+    }
+  }
+
+  return SDlog_CheckPolicy();
+}
+
+/* Run the time based trigger when no rows arrive */
+FRESULT SDlog_Poll(void)
+{
+  if (!LogFile)
+    return FR_NOT_READY;
+
+  return SDlog_CheckPolicy();
+}
+
+/* Forced commit, use on error paths and before power off */
+FRESULT SDlog_Sync(void)
+{
+  if (!LogFile)
+    return FR_NOT_READY;
+
+  return SDlog_Commit(SDLOG_SYNC_FORCED);
+}
+
+FRESULT SDlog_Close(void)
+{
+  FRESULT res, res_close;
+
+  if (!LogFile)
+    return FR_NOT_READY;
+
+  res = SDlog_Commit(SDLOG_SYNC_FORCED);
+
+  /* Contiguous mode: release the clusters past the logged data */
+  if (RawSize && res == FR_OK)
+  {
+    FSIZE_t size = f_size(LogFile);
+
+    LogFile->obj.objsize = RawSize;
+    res = f_lseek(LogFile, size);
+    if (res == FR_OK)
+      res = f_truncate(LogFile);
+  }
+
+  res_close = f_close(LogFile);
+  LogFile = NULL;
+  RawSize = 0;
+
+  return (res != FR_OK) ? res : res_close;
+}
+
+void SDlog_SetSyncPolicy(const SDlog_SyncPolicy *policy)
+{
+  Policy = *policy;
+}
+
+void SDlog_GetSyncPolicy(SDlog_SyncPolicy *policy)
+{
+  *policy = Policy;
+}
+
+UINT SDlog_Pending(void)
+{
+  return ChunkFill;
+}
+
+FSIZE_t SDlog_Free(void)
+{
+  return RawSize ? RawSize - RawOffset - ChunkFill : 0;
+}
+
+void SDlog_GetStats(SDlog_Stats *stats)
+{
+  *stats = Stats;
+}
@@ -31,7 +31,7 @@
 #include "i2c.h"
 #include "stm32f7xx_hal.h"
 #include "sensirion_configuration.h"
-extern I2C_HandleTypeDef hi2c1;
+#include "i2c_bus.h"
 
 /*
  * INSTRUCTIONS
@@ -62,7 +62,7 @@ void sensirion_i2c_init()
  */
 int8_t sensirion_i2c_read(uint8_t address, uint8_t* data, uint16_t count)
 {
-	return HAL_I2C_Master_Receive(&hi2c1, address<<1, data, count, 100);
+	return I2Cbus_Read(address, data, count);
 }
 
 /**
@@ -78,7 +78,7 @@ int8_t sensirion_i2c_read(uint8_t address, uint8_t* data, uint16_t count)
  */
 int8_t sensirion_i2c_write(uint8_t address, uint8_t* data, uint16_t count)
 {
-	return HAL_I2C_Master_Transmit(&hi2c1, address<<1, data, count, 100);  // data is the start pointer of our array
+	return I2Cbus_Write(address, data, count);  // data is the start pointer of our array
 }
 
 /**
@@ -291,6 +291,26 @@ static const struct sgp_profile *sgp_get_profile_by_number(u16 number) {
 }
 
 
+/**
+ * sgp_get_profile_duration_us() - get the measurement duration of a profile
+ * @number      The number that identifies the profile
+ *
+ * Used by callers that issue sgp_measure_* and collect the result later
+ * with sgp_read_* instead of waiting in the driver.
+ *
+ * Return:      The duration in microseconds or 0 if the profile does not exist
+ */
+u32 sgp_get_profile_duration_us(u16 number) {
+    const struct sgp_profile *profile;
+
+    profile = sgp_get_profile_by_number(number);
+    if (profile == NULL)
+        return 0;
+
+    return profile->duration_us;
+}
+
+
 /**
  * sgp_run_profile_by_number() - run a profile by its identifier number
  * @number:     The number that identifies the profile
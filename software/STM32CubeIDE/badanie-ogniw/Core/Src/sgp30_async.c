@@ -0,0 +1,120 @@
+/*
+ * sgp30_async.c
+ *
+ *  Non-blocking SGP30 measurement cycle.
+ *
+ *  The *_blocking_read driver calls wait for the whole profile duration
+ *  in sensirion_sleep_usec (HAL_Delay), 50 ms for IAQ and 200 ms for the
+ *  raw signals. Here the command is issued, the caller goes on with other
+ *  sensors and SGPasync_Poll collects the result once the profile
+ *  duration_us has elapsed, then issues the next command.
+ *  A result collected more than SGPASYNC_LATE_MS past its deadline is
+ *  counted as missed, the IAQ algorithm expects a steady 1 Hz cadence.
+ */
+
+#include "stm32f7xx_hal.h"
+#include "sgp_featureset.h"
+#include "sgp30_async.h"
+
+static SGPasync_State State = SGPASYNC_IDLE;
+static uint32_t Deadline;
+static SGPasync_Result Result;
+static SGPasync_Stats Stats;
+
+/* HAL_GetTick counts whole milliseconds, round up and add one tick so
+   the deadline never falls before the measurement has finished */
+static uint32_t SGPasync_DeadlineFor(u16 profile)
+{
+  return HAL_GetTick() + (sgp_get_profile_duration_us(profile) + 999) / 1000 + 1;
+}
+
+static void SGPasync_Fail(void)
+{
+  Stats.errors++;
+  State = SGPASYNC_ERROR;
+}
+
+/* Start a cycle: measure_iaq now, measure_signals once IAQ is read */
+s16 SGPasync_Start(void)
+{
+  if (SGPasync_Busy())
+  {
+    Stats.missed++;
+    return STATUS_FAIL;
+  }
+
+  if (sgp_measure_iaq() != STATUS_OK)
+  {
+    SGPasync_Fail();
+    return STATUS_FAIL;
+  }
+
+  Deadline = SGPasync_DeadlineFor(PROFILE_NUMBER_IAQ_MEASURE);
+  State = SGPASYNC_IAQ_WAIT;
+  return STATUS_OK;
+}
+
+/* Main loop service, collects a due result and issues the next command */
+void SGPasync_Poll(void)
+{
+  uint32_t late;
+
+  if (!SGPasync_Busy())
+    return;
+
+  late = HAL_GetTick() - Deadline;
+  if ((int32_t)late < 0)
+    return;
+
+  if (late > Stats.max_late_ms)
+    Stats.max_late_ms = late;
+  if (late > SGPASYNC_LATE_MS)
+    Stats.missed++;
+
+  if (State == SGPASYNC_IAQ_WAIT)
+  {
+    if (sgp_read_iaq(&Result.tvoc_ppb, &Result.co2_eq_ppm) != STATUS_OK ||
+        sgp_measure_signals() != STATUS_OK)
+    {
+      SGPasync_Fail();
+      return;
+    }
+    Deadline = SGPasync_DeadlineFor(PROFILE_NUMBER_MEASURE_SIGNALS);
+    State = SGPASYNC_SIGNALS_WAIT;
+  }
+  else
+  {
+    if (sgp_read_signals(&Result.scaled_ethanol_signal, &Result.scaled_h2_signal) != STATUS_OK)
+    {
+      SGPasync_Fail();
+      return;
+    }
+    Stats.cycles++;
+    State = SGPASYNC_DONE;
+  }
+}
+
+SGPasync_State SGPasync_GetState(void)
+{
+  return State;
+}
+
+uint8_t SGPasync_Busy(void)
+{
+  return State == SGPASYNC_IAQ_WAIT || State == SGPASYNC_SIGNALS_WAIT;
+}
+
+/* Result of the last complete cycle, STATUS_FAIL if it did not complete */
+s16 SGPasync_GetResult(SGPasync_Result *result)
+{
+  if (State != SGPASYNC_DONE)
+    return STATUS_FAIL;
+
+  *result = Result;
+  return STATUS_OK;
+}
+
+void SGPasync_GetStats(SGPasync_Stats *stats)
+{
+  *stats = Stats;
+}
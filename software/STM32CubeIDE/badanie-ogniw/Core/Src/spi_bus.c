@@ -0,0 +1,476 @@
+/*
+ * spi_bus.c
+ *
+ *  Per-device configuration of the shared SPI1 bus.
+ *
+ *  The SD card, BMP280 and ST7735 share hspi1, each with its own chip
+ *  select. Selecting a device loads its clock and mode from the profile
+ *  table into CR1 (only when they differ from the current setting) and
+ *  then pulls its CS low. The SD driver changes its own prescaler between
+ *  card identification and data transfer.
+ *
+ *  Transactions are queued (SPIbus_Submit) and run one chunk of at most
+ *  SPIBUS_CHUNK bytes per chip select cycle, over DMA when they are long
+ *  enough or when the next chunk is started from the completion interrupt. When a chunk ends the
+ *  completion interrupt picks the next one by priority, aged by waiting
+ *  time so low priority work still gets through. A long display write is
+ *  split into chunks and a sensor read queued meanwhile runs between two
+ *  of them. The SD driver keeps CS low across a whole command sequence,
+ *  it locks the bus instead (SPIbus_Lock) and the queue waits.
+ *
+ *  A repeat transfer (display fills) switches the bus to 16 bit frames
+ *  and the TX DMA stream to a fixed memory address for its chunks, so one
+ *  colour word fills any number of pixels without a buffer.
+ */
+
+#include "spi.h"
+#include "st7735.h"
+#include "spi_bus.h"
+
+static SPIbus_Device Devices[SPIBUS_DEVICES] = {
+  [SPIBUS_SD]     = { GPIOE, GPIO_PIN_11, SPIBUS_SD_INIT_PRESCALER,
+                      SPI_POLARITY_LOW, SPI_PHASE_1EDGE },
+  [SPIBUS_BMP280] = { GPIOE, GPIO_PIN_9, SPIBUS_BMP280_PRESCALER,
+                      SPI_POLARITY_LOW, SPI_PHASE_1EDGE },
+  [SPIBUS_ST7735] = { ST7735_CS_GPIO_Port, ST7735_CS_Pin, SPIBUS_ST7735_PRESCALER,
+                      SPI_POLARITY_LOW, SPI_PHASE_1EDGE },
+};
+
+static SPIbus_Xfer *Queue;          /* submit order */
+static SPIbus_Xfer *volatile Active;
+static volatile uint8_t Locked;     /* lock depth of Owner */
+static SPIbus_Id Owner;
+static volatile uint8_t LockedDone;
+
+static SPIbus_Stats Stats[SPIBUS_DEVICES];
+
+static void SPIbus_Kick(void);
+
+/* 16 bit frames from a fixed word for repeat transfers, else the spi.c
+   setting. The SPI and its TX stream are idle here. */
+static void SPIbus_RepeatMode(uint8_t on)
+{
+  DMA_HandleTypeDef *dma = hspi1.hdmatx;
+  uint32_t cfg = on ? (DMA_PDATAALIGN_HALFWORD | DMA_MDATAALIGN_HALFWORD)
+                    : (dma->Init.MemInc | dma->Init.PeriphDataAlignment | dma->Init.MemDataAlignment);
+
+  __HAL_SPI_DISABLE(&hspi1);
+  hspi1.Init.DataSize = on ? SPI_DATASIZE_16BIT : SPI_DATASIZE_8BIT;
+  MODIFY_REG(hspi1.Instance->CR2, SPI_CR2_DS, hspi1.Init.DataSize);
+  MODIFY_REG(((DMA_Stream_TypeDef *)dma->Instance)->CR, DMA_SxCR_MINC | DMA_SxCR_PSIZE | DMA_SxCR_MSIZE, cfg);
+}
+
+/* Unlink and return the transfer to run next, call with interrupts off */
+static SPIbus_Xfer *SPIbus_PickNext(void)
+{
+  uint32_t now = HAL_GetTick();
+  SPIbus_Xfer **best = NULL;
+  uint32_t best_prio = 0;
+
+  for (SPIbus_Xfer **p = &Queue; *p; p = &(*p)->next)
+  {
+    uint32_t prio = (*p)->prio + (now - (*p)->queued) / SPIBUS_AGING_MS;
+
+    /* strict compare keeps FIFO order between equals */
+    if (!best || prio > best_prio)
+    {
+      best = p;
+      best_prio = prio;
+    }
+  }
+
+  if (!best)
+    return NULL;
+
+  SPIbus_Xfer *x = *best;
+  *best = x->next;
+  x->next = NULL;
+
+  return x;
+}
+
+static void SPIbus_Append(SPIbus_Xfer *x)
+{
+  SPIbus_Xfer **p = &Queue;
+
+  while (*p)
+    p = &(*p)->next;
+
+  x->next = NULL;
+  x->queued = HAL_GetTick();
+  x->state = SPIBUS_QUEUED;
+  *p = x;
+}
+
+/* End of the active chunk: requeue the rest or complete the transfer */
+static void SPIbus_Finish(SPIbus_Xfer *x, uint8_t ok)
+{
+  uint32_t primask;
+
+  SPIbus_Deselect(x->dev);
+  if (x->repeat)
+    SPIbus_RepeatMode(0);
+  Stats[x->dev].chunks++;
+
+  primask = __get_PRIMASK();
+  __disable_irq();
+
+  Active = NULL;
+  if (ok)
+  {
+    x->pos += x->n;
+    Stats[x->dev].bytes += x->n;
+  }
+
+  if (ok && x->pos < x->len)
+  {
+    SPIbus_Append(x);
+    __set_PRIMASK(primask);
+    return;
+  }
+
+  if (ok)
+    Stats[x->dev].xfers++;
+  else
+    Stats[x->dev].errors++;
+  x->state = ok ? SPIBUS_DONE : SPIBUS_ERROR;
+  __set_PRIMASK(primask);
+
+  if (x->done)
+    x->done(x);
+}
+
+/* Polling needs HAL_GetTick running, so not from an interrupt or with
+   interrupts off. Kicks from the completion interrupt start DMA only. */
+static uint8_t SPIbus_CanPoll(void)
+{
+  return __get_IPSR() == 0 && __get_PRIMASK() == 0;
+}
+
+/* Start queued chunks until one is left running on DMA */
+static void SPIbus_Kick(void)
+{
+  for (;;)
+  {
+    uint32_t primask = __get_PRIMASK();
+    SPIbus_Xfer *x;
+    HAL_StatusTypeDef res;
+
+    __disable_irq();
+    if (Active || Locked || !Queue)
+    {
+      __set_PRIMASK(primask);
+      return;
+    }
+    x = SPIbus_PickNext();
+    Active = x;
+    x->state = SPIBUS_ACTIVE;
+    __set_PRIMASK(primask);
+
+    if (x->pos == 0)
+    {
+      uint32_t wait = HAL_GetTick() - x->queued;
+      if (wait > Stats[x->dev].max_wait_ms)
+        Stats[x->dev].max_wait_ms = wait;
+    }
+
+    uint32_t n = x->len - x->pos;
+    if (x->chunk && n > x->chunk)
+      n = x->chunk;
+    if (n > SPIBUS_CHUNK)
+      n = SPIBUS_CHUNK;
+    x->n = (uint16_t)n;
+
+    const uint8_t *tx = x->tx + x->pos;
+    uint8_t *rx = x->rx ? x->rx + x->pos : NULL;
+
+    if (x->setup)
+      x->setup(x);
+    SPIbus_Select(x->dev);
+
+    if (x->repeat)
+    {
+      /* always DMA, a polled transfer would step through memory */
+      SPIbus_RepeatMode(1);
+      if (HAL_SPI_Transmit_DMA(&hspi1, (uint8_t *)x->tx, x->n / 2) == HAL_OK)
+        return;
+
+      SPIbus_Finish(x, 0);
+      continue;
+    }
+
+    if (n < SPIBUS_DMA_MIN && SPIbus_CanPoll())
+    {
+      if (rx)
+        res = HAL_SPI_TransmitReceive(&hspi1, (uint8_t *)tx, rx, x->n, 10);
+      else
+        res = HAL_SPI_Transmit(&hspi1, (uint8_t *)tx, x->n, 10);
+
+      SPIbus_Finish(x, res == HAL_OK);
+      continue;
+    }
+
+    if (rx)
+      res = HAL_SPI_TransmitReceive_DMA(&hspi1, (uint8_t *)tx, rx, x->n);
+    else
+      res = HAL_SPI_Transmit_DMA(&hspi1, (uint8_t *)tx, x->n);
+
+    if (res == HAL_OK)
+      return;
+
+    SPIbus_Finish(x, 0);
+  }
+}
+
+/* DMA completion of the active chunk or of a locked transfer */
+static void SPIbus_DmaDone(void)
+{
+  SPIbus_Xfer *x = Active;
+
+  if (Locked)
+  {
+    LockedDone = 1;
+    return;
+  }
+
+  if (!x)
+    return;
+
+  SPIbus_Finish(x, hspi1.ErrorCode == HAL_SPI_ERROR_NONE);
+  SPIbus_Kick();
+}
+
+void HAL_SPI_TxCpltCallback(SPI_HandleTypeDef *hspi)
+{
+  if (hspi == &hspi1)
+    SPIbus_DmaDone();
+}
+
+void HAL_SPI_TxRxCpltCallback(SPI_HandleTypeDef *hspi)
+{
+  if (hspi == &hspi1)
+    SPIbus_DmaDone();
+}
+
+void HAL_SPI_ErrorCallback(SPI_HandleTypeDef *hspi)
+{
+  if (hspi == &hspi1)
+    SPIbus_DmaDone();
+}
+
+/* Queue a transfer, safe from interrupts. 'done' reports the result. */
+void SPIbus_Submit(SPIbus_Xfer *xfer)
+{
+  uint32_t primask = __get_PRIMASK();
+
+  xfer->pos = 0;
+
+  __disable_irq();
+  SPIbus_Append(xfer);
+  __set_PRIMASK(primask);
+
+  SPIbus_Kick();
+}
+
+/* Queue a transfer and wait for it */
+HAL_StatusTypeDef SPIbus_Transfer(SPIbus_Xfer *xfer, uint32_t timeout)
+{
+  uint32_t start = HAL_GetTick();
+
+  SPIbus_Submit(xfer);
+
+  while (xfer->state == SPIBUS_QUEUED || xfer->state == SPIBUS_ACTIVE)
+  {
+    if (timeout != HAL_MAX_DELAY && (HAL_GetTick() - start) > timeout)
+    {
+      SPIbus_Cancel(xfer);
+      return HAL_TIMEOUT;
+    }
+  }
+
+  return (xfer->state == SPIBUS_DONE) ? HAL_OK : HAL_ERROR;
+}
+
+/* Drop a queued transfer or abort it when running, 'done' is not called */
+void SPIbus_Cancel(SPIbus_Xfer *xfer)
+{
+  uint32_t primask = __get_PRIMASK();
+
+  __disable_irq();
+  if (xfer->state == SPIBUS_QUEUED)
+  {
+    for (SPIbus_Xfer **p = &Queue; *p; p = &(*p)->next)
+    {
+      if (*p == xfer)
+      {
+        *p = xfer->next;
+        break;
+      }
+    }
+  }
+  else if (Active == xfer)
+  {
+    HAL_SPI_Abort(&hspi1);
+    SPIbus_Deselect(xfer->dev);
+    if (xfer->repeat)
+      SPIbus_RepeatMode(0);
+    Active = NULL;
+  }
+  else
+  {
+    __set_PRIMASK(primask);
+    return;
+  }
+
+  xfer->state = SPIBUS_ERROR;
+  Stats[xfer->dev].errors++;
+  __set_PRIMASK(primask);
+
+  SPIbus_Kick();
+}
+
+/* A queued transfer waits for the running chunk and at most one aged chunk
+   of another device, both at most SPIBUS_CHUNK bytes at the slowest queued
+   clock, then runs at its own clock. The SD card is not counted, it holds
+   the bus through SPIbus_Lock in thread context, never from the queue. */
+uint32_t SPIbus_TimeoutMs(SPIbus_Id id, uint32_t len)
+{
+  uint32_t slowest = SPIbus_GetClockHz(id);
+
+  for (SPIbus_Id i = 0; i < SPIBUS_DEVICES; i++)
+  {
+    if (i != SPIBUS_SD && SPIbus_GetClockHz(i) < slowest)
+      slowest = SPIbus_GetClockHz(i);
+  }
+
+  /* bits * 1000 / Hz, rounded up, plus a tick either side */
+  return (uint32_t)(((2ULL * SPIBUS_CHUNK + len) * 8 * 1000 + slowest - 1) / slowest) + 2;
+}
+
+void SPIbus_GetStats(SPIbus_Id id, SPIbus_Stats *stats)
+{
+  *stats = Stats[id];
+}
+
+/* Wait for the running chunk, then keep the queue stopped until Unlock.
+   The lock is counted: nested calls by the owner need one Unlock each. */
+void SPIbus_Lock(SPIbus_Id id)
+{
+  for (;;)
+  {
+    uint32_t primask = __get_PRIMASK();
+
+    __disable_irq();
+    if (Locked && Owner == id)
+    {
+      Locked++;
+      __set_PRIMASK(primask);
+      return;
+    }
+    if (!Locked && !Active)
+    {
+      Locked = 1;
+      Owner = id;
+      __set_PRIMASK(primask);
+      return;
+    }
+    __set_PRIMASK(primask);
+  }
+}
+
+/* Queued transfers start again when the outermost Lock is undone */
+void SPIbus_Unlock(void)
+{
+  uint32_t primask = __get_PRIMASK();
+  uint8_t held;
+
+  __disable_irq();
+  if (Locked)
+    Locked--;
+  held = Locked;
+  __set_PRIMASK(primask);
+
+  if (!held)
+    SPIbus_Kick();
+}
+
+/* DMA transfer for the lock owner, CS is managed by the caller */
+HAL_StatusTypeDef SPIbus_LockedDma(const uint8_t *tx, uint8_t *rx, uint16_t len, uint32_t timeout)
+{
+  uint32_t start = HAL_GetTick();
+  HAL_StatusTypeDef res;
+
+  while (HAL_SPI_GetState(&hspi1) != HAL_SPI_STATE_READY);
+
+  LockedDone = 0;
+  if (rx)
+    res = HAL_SPI_TransmitReceive_DMA(&hspi1, (uint8_t *)tx, rx, len);
+  else
+    res = HAL_SPI_Transmit_DMA(&hspi1, (uint8_t *)tx, len);
+
+  if (res != HAL_OK)
+    return res;
+
+  while (!LockedDone)
+  {
+    if ((HAL_GetTick() - start) > timeout)
+    {
+      HAL_SPI_Abort(&hspi1);
+      return HAL_TIMEOUT;
+    }
+  }
+
+  return (hspi1.ErrorCode == HAL_SPI_ERROR_NONE) ? HAL_OK : HAL_ERROR;
+}
+
+/* Load the device clock and mode, SPE is left off so the next HAL call
+   enables the peripheral with the new setting */
+void SPIbus_Configure(SPIbus_Id id)
+{
+  const SPIbus_Device *dev = &Devices[id];
+  uint32_t cr1 = hspi1.Instance->CR1;
+  uint32_t mask = SPI_CR1_BR | SPI_CR1_CPOL | SPI_CR1_CPHA;
+  uint32_t want = dev->prescaler | dev->polarity | dev->phase;
+
+  if ((cr1 & mask) == want)
+    return;
+
+  while (HAL_SPI_GetState(&hspi1) != HAL_SPI_STATE_READY);
+  while (hspi1.Instance->SR & SPI_SR_BSY);
+
+  __HAL_SPI_DISABLE(&hspi1);
+  hspi1.Instance->CR1 = (cr1 & ~(mask | SPI_CR1_SPE)) | want;
+
+  hspi1.Init.BaudRatePrescaler = dev->prescaler;
+  hspi1.Init.CLKPolarity = dev->polarity;
+  hspi1.Init.CLKPhase = dev->phase;
+}
+
+void SPIbus_Select(SPIbus_Id id)
+{
+  SPIbus_Configure(id);
+  HAL_GPIO_WritePin(Devices[id].cs_port, Devices[id].cs_pin, GPIO_PIN_RESET);
+}
+
+void SPIbus_Deselect(SPIbus_Id id)
+{
+  HAL_GPIO_WritePin(Devices[id].cs_port, Devices[id].cs_pin, GPIO_PIN_SET);
+}
+
+/* Takes effect on the next Select/Configure of the device */
+void SPIbus_SetPrescaler(SPIbus_Id id, uint32_t prescaler)
+{
+  Devices[id].prescaler = prescaler & SPI_CR1_BR;
+}
+
+uint32_t SPIbus_GetPrescaler(SPIbus_Id id)
+{
+  return Devices[id].prescaler;
+}
+
+uint32_t SPIbus_GetClockHz(SPIbus_Id id)
+{
+  uint32_t br = Devices[id].prescaler >> SPI_CR1_BR_Pos;
+
+  return HAL_RCC_GetPCLK2Freq() >> (br + 1);
+}
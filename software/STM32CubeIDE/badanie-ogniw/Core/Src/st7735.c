@@ -1,7 +1,8 @@
 /* vim: set ai et ts=4 sw=4: */
 #include "stm32f7xx_hal.h"
 #include "st7735.h"
-#include "malloc.h"
+#include "spi_bus.h"
+#include "glyph_cache.h"
 #include "string.h"
 
 #define DELAY 0x80
@@ -85,28 +86,140 @@ static const uint8_t
     ST7735_DISPON ,    DELAY, //  4: Main screen turn on, no args w/delay
       100 };                  //     100 ms delay
 
-static void ST7735_Select() {
-    HAL_GPIO_WritePin(ST7735_CS_GPIO_Port, ST7735_CS_Pin, GPIO_PIN_RESET);
+static ST7735_Stats Stats;
+
+// One string row of glyphs, sent in a single data transfer
+static uint16_t TextRow[ST7735_WIDTH * ST7735_TEXT_MAX_HEIGHT];
+
+enum {
+    ST7735_OP_COMMAND,
+    ST7735_OP_DATA,
+    ST7735_OP_FILL
+};
+
+// A queued command, data write or fill. Short writes and the fill colour
+// live in the op, in 16 bit frames the native word goes out MSB first.
+typedef struct {
+    uint8_t kind;
+    union {
+        uint8_t bytes[ST7735_INLINE_BYTES];
+        uint16_t word;
+    } in;
+    const uint8_t *buff;
+    uint32_t len;
+} ST7735_Op;
+
+static ST7735_Op Ops[ST7735_QUEUE_OPS];
+static volatile uint32_t OpHead;    // next free op, moved by the caller
+static volatile uint32_t OpTail;    // op on the bus, moved on completion
+static volatile uint8_t Running;
+
+// The one display transfer on the bus
+static SPIbus_Xfer Xfer;
+
+// Each command / data write is one transfer on the shared bus with its own
+// CS cycle, long writes are chunked. Only one display op is queued on the
+// bus at a time and it is low priority, so a sensor transfer submitted
+// meanwhile runs before the next chunk. CS high pauses a RAMWR, the next
+// data chunk continues it.
+void ST7735_Unselect() {
+    SPIbus_Deselect(SPIBUS_ST7735);
 }
 
-void ST7735_Unselect() {
-    HAL_GPIO_WritePin(ST7735_CS_GPIO_Port, ST7735_CS_Pin, GPIO_PIN_SET);
+static void ST7735_SetCommand(SPIbus_Xfer *xfer) {
+    HAL_GPIO_WritePin(ST7735_DC_GPIO_Port, ST7735_DC_Pin, GPIO_PIN_RESET);
+}
+
+static void ST7735_SetData(SPIbus_Xfer *xfer) {
+    HAL_GPIO_WritePin(ST7735_DC_GPIO_Port, ST7735_DC_Pin, GPIO_PIN_SET);
+}
+
+static void ST7735_Done(SPIbus_Xfer *xfer);
+
+static void ST7735_Start(const ST7735_Op *op) {
+    Xfer.dev = SPIBUS_ST7735;
+    Xfer.prio = SPIBUS_PRIO_LOW;
+    Xfer.tx = op->buff;
+    Xfer.rx = NULL;
+    Xfer.len = op->len;
+    Xfer.chunk = op->kind == ST7735_OP_FILL ? ST7735_FILL_CHUNK : ST7735_SPI_CHUNK;
+    Xfer.repeat = op->kind == ST7735_OP_FILL;
+    Xfer.setup = op->kind == ST7735_OP_COMMAND ? ST7735_SetCommand : ST7735_SetData;
+    Xfer.done = ST7735_Done;
+    SPIbus_Submit(&Xfer);
+}
+
+// Completion, usually from the SPI interrupt: the next op or idle
+static void ST7735_Done(SPIbus_Xfer *xfer) {
+    if(xfer->state != SPIBUS_DONE)
+        Stats.errors++;
+
+    OpTail++;
+    if(OpTail != OpHead)
+        ST7735_Start(&Ops[OpTail % ST7735_QUEUE_OPS]);
+    else
+        Running = 0;
+}
+
+static void ST7735_Queue(uint8_t kind, const uint8_t* buff, uint32_t len) {
+    uint32_t primask;
+    uint8_t start;
+
+    // a full queue drains on its own
+    while(OpHead - OpTail >= ST7735_QUEUE_OPS)
+        ;
+
+    ST7735_Op *op = &Ops[OpHead % ST7735_QUEUE_OPS];
+    op->kind = kind;
+    op->len = len;
+    if(kind == ST7735_OP_FILL) {
+        // the DMA reads the word from the op until the fill completes
+        op->in.word = *(const uint16_t*)buff;
+        op->buff = op->in.bytes;
+    } else if(len > sizeof(op->in.bytes)) {
+        op->buff = buff;
+    } else {
+        memcpy(op->in.bytes, buff, len);
+        op->buff = op->in.bytes;
+    }
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+    OpHead++;
+    start = !Running;
+    Running = 1;
+    __set_PRIMASK(primask);
+
+    if(start)
+        ST7735_Start(op);
+}
+
+void ST7735_Wait(void) {
+    while(Running)
+        ;
+}
+
+uint8_t ST7735_Busy(void) {
+    return Running;
 }
 
 static void ST7735_Reset() {
+    ST7735_Wait();
     HAL_GPIO_WritePin(ST7735_RES_GPIO_Port, ST7735_RES_Pin, GPIO_PIN_RESET);
     HAL_Delay(5);
     HAL_GPIO_WritePin(ST7735_RES_GPIO_Port, ST7735_RES_Pin, GPIO_PIN_SET);
 }
 
 static void ST7735_WriteCommand(uint8_t cmd) {
-    HAL_GPIO_WritePin(ST7735_DC_GPIO_Port, ST7735_DC_Pin, GPIO_PIN_RESET);
-    HAL_SPI_Transmit(&ST7735_SPI_PORT, &cmd, sizeof(cmd), HAL_MAX_DELAY);
+    ST7735_Queue(ST7735_OP_COMMAND, &cmd, sizeof(cmd));
+    Stats.commands++;
 }
 
-static void ST7735_WriteData(uint8_t* buff, size_t buff_size) {
-    HAL_GPIO_WritePin(ST7735_DC_GPIO_Port, ST7735_DC_Pin, GPIO_PIN_SET);
-    HAL_SPI_Transmit(&ST7735_SPI_PORT, buff, buff_size, HAL_MAX_DELAY);
+// Up to ST7735_INLINE_BYTES are copied, longer data is sent in place
+static void ST7735_WriteData(const uint8_t* buff, size_t buff_size) {
+    ST7735_Queue(ST7735_OP_DATA, buff, buff_size);
+    Stats.data_writes++;
+    Stats.bytes += buff_size;
 }
 
 static void ST7735_ExecuteCommandList(const uint8_t *addr) {
@@ -130,6 +243,8 @@ static void ST7735_ExecuteCommandList(const uint8_t *addr) {
         if(ms) {
             ms = *addr++;
             if(ms == 255) ms = 500;
+            // the delay counts from the end of the command
+            ST7735_Wait();
             HAL_Delay(ms);
         }
     }
@@ -152,44 +267,53 @@ static void ST7735_SetAddressWindow(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t
 }
 
 void ST7735_Init() {
-    ST7735_Select();
     ST7735_Reset();
     ST7735_ExecuteCommandList(init_cmds1);
     ST7735_ExecuteCommandList(init_cmds2);
     ST7735_ExecuteCommandList(init_cmds3);
-    ST7735_Unselect();
 }
 
 void ST7735_DrawPixel(uint16_t x, uint16_t y, uint16_t color) {
     if((x >= ST7735_WIDTH) || (y >= ST7735_HEIGHT))
         return;
 
-    ST7735_Select();
-
     ST7735_SetAddressWindow(x, y, x+1, y+1);
     uint8_t data[] = { color >> 8, color & 0xFF };
     ST7735_WriteData(data, sizeof(data));
-
-    ST7735_Unselect();
 }
 
+// The whole glyph in one transfer, expanded once per colour pair (glyph_cache.h).
+// The cache slot can be reused by the next lookup, so wait for it.
 static void ST7735_WriteChar(uint16_t x, uint16_t y, char ch, FontDef font, uint16_t color, uint16_t bgcolor) {
-    uint32_t i, b, j;
+    const uint16_t *glyph = Glyph_Get(&font, ch, color, bgcolor);
 
     ST7735_SetAddressWindow(x, y, x+font.width-1, y+font.height-1);
+    ST7735_WriteData((const uint8_t*)glyph, sizeof(uint16_t)*font.width*font.height);
+    ST7735_Wait();
+}
 
-    for(i = 0; i < font.height; i++) {
-        b = font.data[(ch - 32) * font.height + i];
-        for(j = 0; j < font.width; j++) {
-            if((b << j) & 0x8000)  {
-                uint8_t data[] = { color >> 8, color & 0xFF };
-                ST7735_WriteData(data, sizeof(data));
-            } else {
-                uint8_t data[] = { bgcolor >> 8, bgcolor & 0xFF };
-                ST7735_WriteData(data, sizeof(data));
-            }
+// n characters side by side, one window and one transfer for the row
+static void ST7735_WriteRow(uint16_t x, uint16_t y, const char* str, uint16_t n, FontDef font, uint16_t color, uint16_t bgcolor) {
+    uint16_t w = n * font.width;
+
+    if(n == 1 || font.height > ST7735_TEXT_MAX_HEIGHT) {
+        while(n--) {
+            ST7735_WriteChar(x, y, *str++, font, color, bgcolor);
+            x += font.width;
         }
+        return;
     }
+
+    // the previous row may still be going out
+    ST7735_Wait();
+    for(uint16_t k = 0; k < n; k++) {
+        const uint16_t *glyph = Glyph_Get(&font, str[k], color, bgcolor);
+        for(uint16_t i = 0; i < font.height; i++)
+            memcpy(&TextRow[i * w + k * font.width], &glyph[i * font.width], sizeof(uint16_t)*font.width);
+    }
+
+    ST7735_SetAddressWindow(x, y, x+w-1, y+font.height-1);
+    ST7735_WriteData((const uint8_t*)TextRow, sizeof(uint16_t)*w*font.height);
 }
 
 /*
@@ -209,15 +333,21 @@ static void ST7735_WriteChar(uint16_t x, uint16_t y, char ch, FontDef font, uint
 }
 */
 
+// Characters up to the wrap point go out as one row
 void ST7735_WriteString(uint16_t x, uint16_t y, const char* str, FontDef font, uint16_t color, uint16_t bgcolor) {
-    ST7735_Select();
+    const char *row = str;
+    uint16_t row_x = x, n = 0;
 
     while(*str) {
         if(x + font.width >= ST7735_WIDTH) {
+            if(n) {
+                ST7735_WriteRow(row_x, y, row, n, font, color, bgcolor);
+                n = 0;
+            }
             x = 0;
             y += font.height;
             if(y + font.height >= ST7735_HEIGHT) {
-                break;
+                return;
             }
 
             if(*str == ' ') {
@@ -227,12 +357,26 @@ void ST7735_WriteString(uint16_t x, uint16_t y, const char* str, FontDef font, u
             }
         }
 
-        ST7735_WriteChar(x, y, *str, font, color, bgcolor);
+        if(!n) {
+            row = str;
+            row_x = x;
+        }
+        n++;
         x += font.width;
         str++;
     }
 
-    ST7735_Unselect();
+    if(n) {
+        ST7735_WriteRow(row_x, y, row, n, font, color, bgcolor);
+    }
+}
+
+// One colour word repeated by the SPI DMA (spi_bus.h repeat transfer),
+// nothing is buffered or allocated and a full screen is one operation
+static void ST7735_WriteRepeat(uint16_t color, uint32_t pixels) {
+    ST7735_Queue(ST7735_OP_FILL, (const uint8_t*)&color, pixels * sizeof(uint16_t));
+    Stats.data_writes++;
+    Stats.bytes += pixels * sizeof(uint16_t);
 }
 
 void ST7735_FillRectangle(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color) {
@@ -241,41 +385,13 @@ void ST7735_FillRectangle(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16
     if((x + w - 1) >= ST7735_WIDTH) w = ST7735_WIDTH - x;
     if((y + h - 1) >= ST7735_HEIGHT) h = ST7735_HEIGHT - y;
 
-    ST7735_Select();
     ST7735_SetAddressWindow(x, y, x+w-1, y+h-1);
-
-    uint8_t data[] = { color >> 8, color & 0xFF };
-    HAL_GPIO_WritePin(ST7735_DC_GPIO_Port, ST7735_DC_Pin, GPIO_PIN_SET);
-    for(y = h; y > 0; y--) {
-        for(x = w; x > 0; x--) {
-            HAL_SPI_Transmit(&ST7735_SPI_PORT, data, sizeof(data), HAL_MAX_DELAY);
-        }
-    }
-
-    ST7735_Unselect();
+    ST7735_WriteRepeat(color, (uint32_t)w * h);
 }
 
+// same engine, kept for existing callers
 void ST7735_FillRectangleFast(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color) {
-    // clipping
-    if((x >= ST7735_WIDTH) || (y >= ST7735_HEIGHT)) return;
-    if((x + w - 1) >= ST7735_WIDTH) w = ST7735_WIDTH - x;
-    if((y + h - 1) >= ST7735_HEIGHT) h = ST7735_HEIGHT - y;
-
-    ST7735_Select();
-    ST7735_SetAddressWindow(x, y, x+w-1, y+h-1);
-
-    // Prepare whole line in a single buffer
-    uint8_t pixel[] = { color >> 8, color & 0xFF };
-    uint8_t *line = malloc(w * sizeof(pixel));
-    for(x = 0; x < w; ++x)
-    	memcpy(line + x * sizeof(pixel), pixel, sizeof(pixel));
-
-    HAL_GPIO_WritePin(ST7735_DC_GPIO_Port, ST7735_DC_Pin, GPIO_PIN_SET);
-    for(y = h; y > 0; y--)
-        HAL_SPI_Transmit(&ST7735_SPI_PORT, line, w * sizeof(pixel), HAL_MAX_DELAY);
-
-    free(line);
-    ST7735_Unselect();
+    ST7735_FillRectangle(x, y, w, h, color);
 }
 
 void ST7735_FillScreen(uint16_t color) {
@@ -291,22 +407,35 @@ void ST7735_DrawImage(uint16_t x, uint16_t y, uint16_t w, uint16_t h, const uint
     if((x + w - 1) >= ST7735_WIDTH) return;
     if((y + h - 1) >= ST7735_HEIGHT) return;
 
-    ST7735_Select();
     ST7735_SetAddressWindow(x, y, x+w-1, y+h-1);
     ST7735_WriteData((uint8_t*)data, sizeof(uint16_t)*w*h);
-    ST7735_Unselect();
 }
 
 void ST7735_InvertColors(bool invert) {
-    ST7735_Select();
     ST7735_WriteCommand(invert ? ST7735_INVON : ST7735_INVOFF);
-    ST7735_Unselect();
+}
+
+// Vertical scroll in panel lines (scan order, not rotated): top fixed,
+// scrolled and bottom fixed lines, the three add up to the panel height
+void ST7735_SetScrollArea(uint16_t top, uint16_t lines, uint16_t bottom) {
+    uint8_t data[] = { top >> 8, top & 0xFF, lines >> 8, lines & 0xFF, bottom >> 8, bottom & 0xFF };
+    ST7735_WriteCommand(ST7735_VSCRDEF);
+    ST7735_WriteData(data, sizeof(data));
+}
+
+// Memory line shown on the first line of the scroll area
+void ST7735_SetScrollStart(uint16_t line) {
+    uint8_t data[] = { line >> 8, line & 0xFF };
+    ST7735_WriteCommand(ST7735_VSCRSADD);
+    ST7735_WriteData(data, sizeof(data));
+}
+
+void ST7735_GetStats(ST7735_Stats *stats) {
+    *stats = Stats;
 }
 
 void ST7735_SetGamma(GammaDef gamma)
 {
-	ST7735_Select();
 	ST7735_WriteCommand(ST7735_GAMSET);
 	ST7735_WriteData((uint8_t *) &gamma, sizeof(gamma));
-	ST7735_Unselect();
 }
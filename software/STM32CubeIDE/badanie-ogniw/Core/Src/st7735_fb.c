@@ -0,0 +1,318 @@
+/*
+ * st7735_fb.c
+ *
+ *  ST7735 framebuffer (st7735_fb.h).
+ *
+ *  The frame is kept in panel byte order (RGB565 big endian), a full
+ *  width rectangle is sent straight from it. Narrower rectangles are
+ *  copied row by row into a staging buffer first, so each one still goes
+ *  out as a single window and data transfer instead of one per row.
+ *  Dirty rectangles that touch are merged as they are added, a full list
+ *  merges the new one where the union grows least.
+ *
+ *  Fills, glyphs and copies go through gfx2d.h and may still be running on
+ *  the DMA2D when a call returns. Anything the CPU does on the frame
+ *  waits for them first.
+ *
+ *  Sends are queued by the display driver. Frame rows may change while
+ *  they go out, the panel then gets the newer pixels, which are dirty
+ *  again anyway. The staging buffer is only refilled once it is sent.
+ */
+
+#include "st7735_fb.h"
+#include "gfx2d.h"
+
+#ifdef FB_HOST
+#define FB_SEND(x, y, w, h, data)   FB_HostSend(x, y, w, h, data)
+#define FB_WAIT()
+#else
+#include "stm32f7xx_hal.h"
+#include "st7735.h"
+#define FB_SEND(x, y, w, h, data)   ST7735_DrawImage(x, y, w, h, data)
+#define FB_WAIT()                   ST7735_Wait()
+#if FB_WIDTH != ST7735_WIDTH || FB_HEIGHT != ST7735_HEIGHT
+#error "FB_WIDTH/FB_HEIGHT do not match the ST7735 configuration"
+#endif
+#endif
+
+#define FB_SWAP(c)  ((uint16_t)(((c) >> 8) | ((c) << 8)))
+
+static uint16_t Frame[FB_HEIGHT][FB_WIDTH];
+static uint16_t Stage[FB_STAGE_PIXELS < FB_WIDTH ? FB_WIDTH : FB_STAGE_PIXELS];
+static FB_Rect Dirty[FB_MAX_DIRTY];
+static uint8_t DirtyCount;
+static FB_Stats Stats;
+
+static uint32_t FB_Area(const FB_Rect *r)
+{
+  return (uint32_t)(r->x1 - r->x0 + 1) * (r->y1 - r->y0 + 1);
+}
+
+static FB_Rect FB_Union(const FB_Rect *a, const FB_Rect *b)
+{
+  FB_Rect u;
+
+  u.x0 = a->x0 < b->x0 ? a->x0 : b->x0;
+  u.y0 = a->y0 < b->y0 ? a->y0 : b->y0;
+  u.x1 = a->x1 > b->x1 ? a->x1 : b->x1;
+  u.y1 = a->y1 > b->y1 ? a->y1 : b->y1;
+  return u;
+}
+
+/* Overlapping or adjacent */
+static uint8_t FB_Touch(const FB_Rect *a, const FB_Rect *b)
+{
+  return a->x0 <= b->x1 + 1 && b->x0 <= a->x1 + 1 &&
+         a->y0 <= b->y1 + 1 && b->y0 <= a->y1 + 1;
+}
+
+static void FB_AddDirty(FB_Rect r)
+{
+  uint8_t i;
+
+  /* merging can make the union touch others, repeat until it settles */
+  for (i = 0; i < DirtyCount; )
+  {
+    if (FB_Touch(&Dirty[i], &r))
+    {
+      r = FB_Union(&Dirty[i], &r);
+      Dirty[i] = Dirty[--DirtyCount];
+      i = 0;
+    }
+    else
+    {
+      i++;
+    }
+  }
+
+  if (DirtyCount < FB_MAX_DIRTY)
+  {
+    Dirty[DirtyCount++] = r;
+    return;
+  }
+
+  uint8_t best = 0;
+  uint32_t best_growth = UINT32_MAX;
+  for (i = 0; i < DirtyCount; i++)
+  {
+    FB_Rect u = FB_Union(&Dirty[i], &r);
+    uint32_t growth = FB_Area(&u) - FB_Area(&Dirty[i]);
+
+    if (growth < best_growth)
+    {
+      best = i;
+      best_growth = growth;
+    }
+  }
+  Dirty[best] = FB_Union(&Dirty[best], &r);
+}
+
+/* Clips to the screen, returns 0 when nothing is left */
+static uint8_t FB_Clip(uint16_t x, uint16_t y, uint16_t *w, uint16_t *h)
+{
+  if (x >= FB_WIDTH || y >= FB_HEIGHT || *w == 0 || *h == 0)
+    return 0;
+  if (*w > FB_WIDTH - x)
+    *w = FB_WIDTH - x;
+  if (*h > FB_HEIGHT - y)
+    *h = FB_HEIGHT - y;
+  return 1;
+}
+
+void FB_Invalidate(uint16_t x, uint16_t y, uint16_t w, uint16_t h)
+{
+  if (!FB_Clip(x, y, &w, &h))
+    return;
+
+  FB_Rect r = { x, y, (uint16_t)(x + w - 1), (uint16_t)(y + h - 1) };
+  FB_AddDirty(r);
+}
+
+void FB_Init(void)
+{
+  DirtyCount = 0;
+  FB_Fill(0x0000);
+}
+
+void FB_Fill(uint16_t color)
+{
+  FB_FillRect(0, 0, FB_WIDTH, FB_HEIGHT, color);
+}
+
+void FB_DrawPixel(uint16_t x, uint16_t y, uint16_t color)
+{
+  if (x >= FB_WIDTH || y >= FB_HEIGHT)
+    return;
+
+  Gfx2D_Wait();
+  Frame[y][x] = FB_SWAP(color);
+  FB_Invalidate(x, y, 1, 1);
+}
+
+void FB_FillRect(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color)
+{
+  if (!FB_Clip(x, y, &w, &h))
+    return;
+
+  Gfx2D_Fill(&Frame[y][x], FB_WIDTH, w, h, color);
+  FB_Invalidate(x, y, w, h);
+}
+
+void FB_DrawRect(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color)
+{
+  if (w == 0 || h == 0)
+    return;
+
+  FB_FillRect(x, y, w, 1, color);
+  FB_FillRect(x, y + h - 1, w, 1, color);
+  FB_FillRect(x, y, 1, h, color);
+  FB_FillRect(x + w - 1, y, 1, h, color);
+}
+
+/* Bresenham, the bounding box is marked dirty once */
+void FB_DrawLine(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, uint16_t color)
+{
+  int32_t dx = x1 > x0 ? x1 - x0 : x0 - x1;
+  int32_t dy = y1 > y0 ? y0 - y1 : y1 - y0;
+  int32_t sx = x0 < x1 ? 1 : -1;
+  int32_t sy = y0 < y1 ? 1 : -1;
+  int32_t err = dx + dy;
+  int32_t x = x0, y = y0;
+  uint16_t c = FB_SWAP(color);
+
+  Gfx2D_Wait();
+  for (;;)
+  {
+    if (x < FB_WIDTH && y < FB_HEIGHT)
+      Frame[y][x] = c;
+    if (x == x1 && y == y1)
+      break;
+
+    int32_t e2 = 2 * err;
+    if (e2 >= dy)
+    {
+      err += dy;
+      x += sx;
+    }
+    if (e2 <= dx)
+    {
+      err += dx;
+      y += sy;
+    }
+  }
+
+  uint16_t lx = x0 < x1 ? x0 : x1;
+  uint16_t ly = y0 < y1 ? y0 : y1;
+  FB_Invalidate(lx, ly, (uint16_t)(dx + 1), (uint16_t)(-dy + 1));
+}
+
+void FB_WriteChar(uint16_t x, uint16_t y, char ch, FontDef font, uint16_t color, uint16_t bgcolor)
+{
+  uint16_t w = font.width, h = font.height;
+
+  if (!FB_Clip(x, y, &w, &h))
+    return;
+
+  Gfx2D_Glyph(&Frame[y][x], FB_WIDTH, &font, ch, w, h, color, bgcolor);
+  FB_Invalidate(x, y, w, h);
+}
+
+/* Same wrapping as ST7735_WriteString */
+void FB_WriteString(uint16_t x, uint16_t y, const char *str, FontDef font, uint16_t color, uint16_t bgcolor)
+{
+  while (*str)
+  {
+    if (x + font.width >= FB_WIDTH)
+    {
+      x = 0;
+      y += font.height;
+      if (y + font.height >= FB_HEIGHT)
+        break;
+
+      /* skip spaces in the beginning of the new line */
+      if (*str == ' ')
+      {
+        str++;
+        continue;
+      }
+    }
+
+    FB_WriteChar(x, y, *str, font, color, bgcolor);
+    x += font.width;
+    str++;
+  }
+}
+
+void FB_DrawImage(uint16_t x, uint16_t y, uint16_t w, uint16_t h, const uint16_t *data)
+{
+  uint16_t cw = w, ch = h;
+
+  if (!FB_Clip(x, y, &cw, &ch))
+    return;
+
+  /* the caller owns the data, wait until it is copied */
+  Gfx2D_Copy(&Frame[y][x], FB_WIDTH, data, w, cw, ch);
+  Gfx2D_Wait();
+  FB_Invalidate(x, y, cw, ch);
+}
+
+uint16_t FB_GetPixel(uint16_t x, uint16_t y)
+{
+  if (x >= FB_WIDTH || y >= FB_HEIGHT)
+    return 0;
+  Gfx2D_Wait();
+  return FB_SWAP(Frame[y][x]);
+}
+
+uint8_t FB_DirtyCount(void)
+{
+  return DirtyCount;
+}
+
+/* Sends the dirty rectangles, returns the number of pixels sent */
+uint32_t FB_Flush(void)
+{
+  uint32_t pixels = 0;
+
+  Gfx2D_Wait();
+  for (uint8_t i = 0; i < DirtyCount; i++)
+  {
+    const FB_Rect *r = &Dirty[i];
+    uint16_t w = r->x1 - r->x0 + 1;
+    uint16_t h = r->y1 - r->y0 + 1;
+
+    if (w == FB_WIDTH || h == 1)
+    {
+      FB_SEND(r->x0, r->y0, w, h, &Frame[r->y0][r->x0]);
+      Stats.rects++;
+    }
+    else
+    {
+      /* as many rows as the staging buffer holds per window */
+      uint16_t rows = sizeof(Stage) / sizeof(Stage[0]) / w;
+
+      for (uint16_t y = r->y0; y <= r->y1; y += rows)
+      {
+        uint16_t n = r->y1 - y + 1 < rows ? r->y1 - y + 1 : rows;
+
+        FB_WAIT();
+        Gfx2D_Copy(Stage, w, &Frame[y][r->x0], FB_WIDTH, w, n);
+        Gfx2D_Wait();
+        FB_SEND(r->x0, y, w, n, Stage);
+        Stats.rects++;
+      }
+    }
+    pixels += (uint32_t)w * h;
+  }
+
+  if (DirtyCount)
+    Stats.flushes++;
+  Stats.pixels += pixels;
+  DirtyCount = 0;
+  return pixels;
+}
+
+void FB_GetStats(FB_Stats *stats)
+{
+  *stats = Stats;
+}
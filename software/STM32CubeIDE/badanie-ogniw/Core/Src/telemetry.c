@@ -0,0 +1,101 @@
+/*
+ * telemetry.c
+ *
+ *  Binary live telemetry (telemetry.h) through the USART3 transmit ring.
+ *  Tasks mark the channels they refreshed, a packet carries only those,
+ *  so the INA219 rate does not resend the slow sensors every time. A full
+ *  packet now and then lets a decoder that joined late fill every column.
+ */
+
+#include <math.h>
+#include <string.h>
+#include "main.h"
+#include "usart.h"
+#include "printf_to_uart.h"
+#include "telemetry.h"
+
+static uint32_t Pending;
+static uint16_t Sequence;
+
+/* Called before the first packet, the console text follows the new rate */
+void Telemetry_Init(uint32_t baudrate)
+{
+  if (baudrate == huart3.Init.BaudRate)
+    return;
+
+  UARTtx_Flush(100);
+  huart3.Init.BaudRate = baudrate;
+  if (HAL_UART_Init(&huart3) != HAL_OK)
+  {
+    Error_Handler();
+  }
+}
+
+void Telemetry_Mark(uint32_t channels)
+{
+  Pending |= channels;
+}
+
+static uint8_t *Telemetry_Put(uint8_t *p, uint32_t v, uint8_t size)
+{
+  for (uint8_t i = 0; i < size; i++, v >>= 8)
+    *p++ = (uint8_t)v;
+  return p;
+}
+
+static uint32_t Telemetry_Value(const struct sensors *s, uint8_t ch)
+{
+  switch (ch)
+  {
+  case TELEM_CH_PRESSURE:    return (uint32_t)s->BMP280pressure;
+  case TELEM_CH_TEMPERATURE: return (uint32_t)(int16_t)lroundf(s->BMP280temperature * 100.0f);
+  case TELEM_CH_TVOC:        return s->tvoc_ppb;
+  case TELEM_CH_CO2_EQ:      return s->co2_eq_ppm;
+  case TELEM_CH_ETHANOL:     return s->scaled_ethanol_signal;
+  case TELEM_CH_H2:          return s->scaled_h2_signal;
+  case TELEM_CH_VOLTAGE:     return s->INA219_Voltage;
+  case TELEM_CH_CURRENT:     return (uint32_t)s->INA219_Current;
+  case TELEM_CH_POWER:       return s->INA219_Power;
+  case TELEM_CH_ADC:         return s->ADC_avg;
+  case TELEM_CH_CHARGE:      return (uint32_t)s->charge_uAh;
+  case TELEM_CH_ENERGY:      return (uint32_t)s->energy_uWh;
+  default:                   return 0;
+  }
+}
+
+/* Queues one frame with the marked channels, or all of them when full */
+void Telemetry_Send(const struct sensors *s, uint32_t time_ms, uint8_t full)
+{
+  uint8_t packet[TELEM_MAX_PACKET];
+  uint8_t frame[TELEM_MAX_FRAME];
+  TelemHeader hdr;
+  uint8_t *p;
+  size_t len;
+
+  hdr.type = TELEM_TYPE_SAMPLE;
+  hdr.version = TELEM_VERSION;
+  hdr.seq = Sequence;
+  hdr.time_ms = time_ms;
+  hdr.channels = full ? TELEM_ALL : Pending;
+  if (!hdr.channels)
+    return;
+
+  memcpy(packet, &hdr, sizeof(hdr));
+  p = packet + sizeof(hdr);
+  for (uint8_t ch = 0; ch < TELEM_CHANNELS; ch++)
+  {
+    if (hdr.channels & TELEM_MASK(ch))
+      p = Telemetry_Put(p, Telemetry_Value(s, ch), Telem_ValueSize(Telem_Channels[ch].type));
+  }
+  p = Telemetry_Put(p, Log_Crc16(packet, p - packet), 2);
+
+  frame[0] = 0;
+  len = Telem_CobsEncode(packet, p - packet, frame + 1);
+  frame[len + 1] = 0;
+
+  /* with UARTTX_DROP a frame that does not fit is lost whole, the
+     decoder sees the gap in seq */
+  UARTtx_Write(frame, len + 2);
+  Sequence++;
+  Pending = 0;
+}
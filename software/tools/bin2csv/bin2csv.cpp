@@ -0,0 +1,333 @@
+/*
+ * bin2csv.cpp
+ *
+ *  Converts binary measurement logs (log_record.h) to CSV.
+ *
+ *  Build:  g++ -O2 -std=c++17 -o bin2csv bin2csv.cpp
+ *  Usage:  bin2csv POMIAR.BIN [out.csv]      (stdout when no output file)
+ *
+ *  The input is mapped read-only and scanned for session headers, so files
+ *  holding several sessions or a torn tail after a power cut are handled.
+ *  Records with a bad CRC are skipped, gaps in the sequence are counted.
+ *  The timing footer of a cleanly closed session is written as comment
+ *  lines. A summary goes to stderr.
+ */
+
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "../../STM32CubeIDE/badanie-ogniw/Core/Inc/log_record.h"
+
+namespace {
+
+struct Stats
+{
+  size_t sessions = 0;
+  size_t footers = 0;
+  size_t records = 0;
+  size_t crc_errors = 0;
+  size_t seq_gaps = 0;
+  size_t lost_records = 0;
+  size_t skipped_bytes = 0;
+};
+
+class Output
+{
+public:
+  explicit Output(FILE *f) : file(f), buf(1 << 20) {}
+  ~Output() { flush(); }
+
+  void put(const char *s, size_t n)
+  {
+    if (used + n > buf.size())
+      flush();
+    memcpy(buf.data() + used, s, n);
+    used += n;
+  }
+  void put(const char *s) { put(s, strlen(s)); }
+  void put(char c) { put(&c, 1); }
+
+  template <typename T>
+  void num(T v)
+  {
+    char tmp[24];
+    auto r = std::to_chars(tmp, tmp + sizeof(tmp), v);
+    put(tmp, size_t(r.ptr - tmp));
+  }
+
+  /* raw / divisor with enough decimals for the divisor */
+  void scaled(int64_t raw, unsigned divisor)
+  {
+    if (divisor <= 1)
+    {
+      num(raw);
+      return;
+    }
+    char tmp[32];
+    auto r = std::to_chars(tmp, tmp + sizeof(tmp), double(raw) / divisor,
+                           std::chars_format::fixed, divisor <= 100 ? 2 : 4);
+    put(tmp, size_t(r.ptr - tmp));
+  }
+
+  void flush()
+  {
+    if (used)
+      fwrite(buf.data(), 1, used, file);
+    used = 0;
+  }
+
+private:
+  FILE *file;
+  std::vector<char> buf;
+  size_t used = 0;
+};
+
+template <typename T>
+T load(const uint8_t *p)
+{
+  T v;
+  memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+bool valid_header(const uint8_t *p, size_t left, LogFileHeader &hdr)
+{
+  if (left < sizeof(LogFileHeader) || load<uint32_t>(p) != LOG_MAGIC)
+    return false;
+  memcpy(&hdr, p, sizeof(hdr));
+  return hdr.version == LOG_VERSION
+      && hdr.header_size == LOG_HEADER_SIZE
+      && hdr.channel_count <= LOG_MAX_CHANNELS
+      && hdr.record_size >= 10
+      && Log_Crc16(p, offsetof(LogFileHeader, crc)) == hdr.crc;
+}
+
+bool valid_footer(const uint8_t *p, size_t left, LogFileFooter &ftr)
+{
+  if (left < sizeof(LogFileFooter) || load<uint32_t>(p) != LOG_FOOTER_MAGIC)
+    return false;
+  memcpy(&ftr, p, sizeof(ftr));
+  return ftr.footer_size == LOG_FOOTER_SIZE
+      && Log_Crc16(p, offsetof(LogFileFooter, crc)) == ftr.crc;
+}
+
+void write_footer(Output &out, const LogFileFooter &ftr)
+{
+  const LogTiming &t = ftr.timing;
+
+  out.put("# ticks ");
+  out.num(t.ticks);
+  out.put(", missed ");
+  out.num(t.missed_ticks);
+  out.put(", period ");
+  out.num(t.period_min_us);
+  out.put("..");
+  out.num(t.period_max_us);
+  out.put(" us, latency max ");
+  out.num(t.latency_max_us);
+  out.put(" us, jitter max ");
+  out.num(t.jitter_max_us);
+  out.put(" us\n# us < 2^i,latency,jitter\n");
+  for (unsigned i = 0; i < LOG_HIST_BUCKETS; i++)
+  {
+    if (!t.latency_hist[i] && !t.jitter_hist[i])
+      continue;
+    out.put("# ");
+    out.num(i);
+    out.put(',');
+    out.num(t.latency_hist[i]);
+    out.put(',');
+    out.num(t.jitter_hist[i]);
+    out.put('\n');
+  }
+}
+
+size_t channel_size(uint8_t type)
+{
+  return (type == LOG_TYPE_U32 || type == LOG_TYPE_I32) ? 4 : 2;
+}
+
+void write_session_header(Output &out, const LogFileHeader &hdr, size_t session)
+{
+  out.put("# session ");
+  out.num(session);
+  out.put(", period ");
+  out.num(hdr.sample_period_ms);
+  if (hdr.cpu_clock_hz)
+  {
+    out.put(" ms, cpu clock ");
+    out.num(hdr.cpu_clock_hz);
+    out.put(" Hz");
+  }
+  else
+  {
+    out.put(" ms");
+  }
+  out.put("\nseq,time_ms");
+  for (unsigned i = 0; i < hdr.channel_count; i++)
+  {
+    const LogChannel &ch = hdr.channels[i];
+    out.put(',');
+    out.put(ch.name, strnlen(ch.name, sizeof(ch.name)));
+  }
+  out.put('\n');
+}
+
+/* Returns the number of bytes consumed after the header */
+size_t decode_session(Output &out, const LogFileHeader &hdr,
+                      const uint8_t *p, size_t left, Stats &st)
+{
+  const size_t rs = hdr.record_size;
+  size_t pos = 0;
+  bool have_seq = false;
+  uint32_t next_seq = 0;
+
+  while (left - pos >= rs)
+  {
+    const uint8_t *rec = p + pos;
+    LogFileHeader next;
+
+    LogFileFooter ftr;
+
+    if (valid_header(rec, left - pos, next))
+      break;
+
+    if (valid_footer(rec, left - pos, ftr))
+    {
+      write_footer(out, ftr);
+      st.footers++;
+      pos += sizeof(LogFileFooter);
+      break;
+    }
+
+    if (Log_Crc16(rec, rs - 2) != load<uint16_t>(rec + rs - 2))
+    {
+      st.crc_errors++;
+      pos += rs;
+      continue;
+    }
+
+    uint32_t seq = load<uint32_t>(rec);
+    if (have_seq && seq != next_seq)
+    {
+      st.seq_gaps++;
+      st.lost_records += uint32_t(seq - next_seq);
+    }
+    have_seq = true;
+    next_seq = seq + 1;
+
+    out.num(seq);
+    out.put(',');
+    out.num(load<uint32_t>(rec + 4));
+
+    const uint8_t *v = rec + 8;
+    for (unsigned i = 0; i < hdr.channel_count; i++)
+    {
+      const LogChannel &ch = hdr.channels[i];
+      int64_t raw = 0;
+      switch (ch.type)
+      {
+        case LOG_TYPE_U16: raw = load<uint16_t>(v); break;
+        case LOG_TYPE_I16: raw = load<int16_t>(v); break;
+        case LOG_TYPE_U32: raw = load<uint32_t>(v); break;
+        case LOG_TYPE_I32: raw = load<int32_t>(v); break;
+      }
+      v += channel_size(ch.type);
+      out.put(',');
+      out.scaled(raw, ch.divisor);
+    }
+    out.put('\n');
+
+    st.records++;
+    pos += rs;
+  }
+
+  return pos;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+  if (argc < 2 || argc > 3)
+  {
+    fprintf(stderr, "usage: %s input.bin [output.csv]\n", argv[0]);
+    return 2;
+  }
+
+  int fd = open(argv[1], O_RDONLY);
+  if (fd < 0)
+  {
+    perror(argv[1]);
+    return 1;
+  }
+  struct stat sb;
+  if (fstat(fd, &sb) != 0)
+  {
+    perror(argv[1]);
+    return 1;
+  }
+  size_t size = size_t(sb.st_size);
+  const uint8_t *data = nullptr;
+  if (size)
+  {
+    void *m = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (m == MAP_FAILED)
+    {
+      perror("mmap");
+      return 1;
+    }
+    madvise(m, size, MADV_SEQUENTIAL);
+    data = static_cast<const uint8_t *>(m);
+  }
+  close(fd);
+
+  FILE *f = stdout;
+  if (argc == 3 && !(f = fopen(argv[2], "wb")))
+  {
+    perror(argv[2]);
+    return 1;
+  }
+
+  Stats st;
+  {
+    Output out(f);
+    size_t pos = 0;
+    while (pos < size)
+    {
+      LogFileHeader hdr;
+      if (!valid_header(data + pos, size - pos, hdr))
+      {
+        /* resync on the next magic */
+        const void *m = memmem(data + pos + 1, size - pos - 1, "BOGL", 4);
+        size_t next = m ? size_t(static_cast<const uint8_t *>(m) - data) : size;
+        st.skipped_bytes += next - pos;
+        pos = next;
+        continue;
+      }
+      write_session_header(out, hdr, st.sessions++);
+      pos += sizeof(LogFileHeader);
+      pos += decode_session(out, hdr, data + pos, size - pos, st);
+    }
+  }
+
+  if (f != stdout)
+    fclose(f);
+  if (data)
+    munmap(const_cast<uint8_t *>(data), size);
+
+  fprintf(stderr, "sessions %zu (%zu closed), records %zu, crc errors %zu, "
+                  "seq gaps %zu (%zu records lost), skipped %zu bytes\n",
+          st.sessions, st.footers, st.records, st.crc_errors,
+          st.seq_gaps, st.lost_records, st.skipped_bytes);
+
+  return st.sessions ? 0 : 1;
+}
@@ -0,0 +1,170 @@
+/*
+ * fb_host.cpp
+ *
+ *  Host build of the ST7735 framebuffer (Core/Src/st7735_fb.c). Draws the
+ *  measurement screen, updates fields, adds lines and shapes, and after
+ *  every flush checks that a simulated panel fed by the flushed windows
+ *  matches the framebuffer. Prints what each flush sent and writes the
+ *  panel to a PPM image.
+ *
+ *  Build:  gcc -O2 -DFB_HOST -I../../STM32CubeIDE/badanie-ogniw/Core/Inc -c \
+ *              ../../STM32CubeIDE/badanie-ogniw/Core/Src/st7735_fb.c \
+ *              ../../STM32CubeIDE/badanie-ogniw/Core/Src/glyph_cache.c \
+ *              ../../STM32CubeIDE/badanie-ogniw/Core/Src/display_fields.c \
+ *              ../../STM32CubeIDE/badanie-ogniw/Core/Src/gfx2d.c \
+ *              ../../STM32CubeIDE/badanie-ogniw/Core/Src/fonts.c \
+ *              ../../STM32CubeIDE/badanie-ogniw/Core/Src/fonts_packed.c
+ *          g++ -O2 -std=c++17 -DFB_HOST -o fb_host fb_host.cpp st7735_fb.o glyph_cache.o \
+ *              display_fields.o gfx2d.o fonts.o fonts_packed.o
+ *  Usage:  fb_host [out.ppm]
+ */
+
+#include <cstdio>
+#include <cstring>
+
+#include "../../STM32CubeIDE/badanie-ogniw/Core/Inc/st7735_fb.h"
+#include "../../STM32CubeIDE/badanie-ogniw/Core/Inc/glyph_cache.h"
+#include "../../STM32CubeIDE/badanie-ogniw/Core/Inc/display_fields.h"
+
+namespace {
+
+/* panel RAM as written by the flushes, panel byte order */
+uint16_t panel[FB_HEIGHT][FB_WIDTH];
+unsigned windows;
+unsigned long bytes;
+int failures;
+
+uint16_t swap(uint16_t c) { return uint16_t(c >> 8 | c << 8); }
+
+bool check(const char *step)
+{
+  for (unsigned y = 0; y < FB_HEIGHT; y++)
+  {
+    for (unsigned x = 0; x < FB_WIDTH; x++)
+    {
+      if (swap(panel[y][x]) != FB_GetPixel(uint16_t(x), uint16_t(y)))
+      {
+        fprintf(stderr, "%s: panel differs at %u,%u\n", step, x, y);
+        failures++;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+void flush(const char *step)
+{
+  windows = 0;
+  bytes = 0;
+  unsigned dirty = FB_DirtyCount();
+  uint32_t pixels = FB_Flush();
+  check(step);
+  printf("%-16s %2u dirty, %3u windows, %6lu bytes (%5.1f%% of the screen)\n", step, dirty,
+         windows, bytes, 100.0 * pixels / (FB_WIDTH * FB_HEIGHT));
+}
+
+bool write_ppm(const char *path)
+{
+  FILE *f = fopen(path, "wb");
+  if (!f)
+  {
+    perror(path);
+    return false;
+  }
+  fprintf(f, "P6\n%d %d\n255\n", FB_WIDTH, FB_HEIGHT);
+  for (unsigned y = 0; y < FB_HEIGHT; y++)
+  {
+    for (unsigned x = 0; x < FB_WIDTH; x++)
+    {
+      uint16_t c = swap(panel[y][x]);
+      unsigned char rgb[3] = { uint8_t((c >> 11) * 255 / 31), uint8_t(((c >> 5) & 0x3F) * 255 / 63),
+                               uint8_t((c & 0x1F) * 255 / 31) };
+      fwrite(rgb, 1, 3, f);
+    }
+  }
+  return fclose(f) == 0;
+}
+
+const uint16_t WHITE = 0xFFFF, BLACK = 0x0000, RED = 0xF800, GREEN = 0x07E0, BLUE = 0x001F;
+
+} // namespace
+
+extern "C" void FB_HostSend(uint16_t x, uint16_t y, uint16_t w, uint16_t h, const uint16_t *data)
+{
+  for (unsigned j = 0; j < h; j++)
+    memcpy(&panel[y + j][x], data + j * w, w * sizeof(uint16_t));
+  windows++;
+  bytes += 2UL * w * h;
+}
+
+int main(int argc, char **argv)
+{
+  const char *out = argc > 1 ? argv[1] : "fb.ppm";
+
+  /* power up garbage */
+  memset(panel, 0x5A, sizeof(panel));
+
+  FB_Init();
+  flush("clear");
+
+  /* main.c OLEDdisplay layout */
+  const char *lines[] = { "Temp: 23.45 C", "Prs:  100325 Pa", "TVOC:   12 ppb", "CO2:   400 ppm",
+                          "EtOH: 19.52", "H2:   13.81", "Current:  -250 mA", "Voltage:  3712 mV",
+                          "Power:   928 mW" };
+  for (unsigned i = 0; i < sizeof(lines) / sizeof(lines[0]); i++)
+    FB_WriteString(5, uint16_t(5 + 15 * i), lines[i], Font_7x10, WHITE, BLACK);
+  flush("all fields");
+
+  FB_WriteString(5 + 7 * 10, 110, "3711", Font_7x10, WHITE, BLACK);
+  flush("one field");
+
+  FB_WriteChar(5 + 7 * 13, 110, '0', Font_7x10, WHITE, BLACK);
+  flush("one digit");
+
+  /* incremental field, main.c OLEDdisplay */
+  Field field = { 5, 125, &Font_7x10, WHITE, BLACK, {}, 0, 0 };
+  Field_Set(&field, "Power:   928 mW");
+  flush("field redraw");
+  Field_Set(&field, "Power:   929 mW");
+  flush("field one digit");
+  Field_Set(&field, "Power:   929 mW");
+  flush("field unchanged");
+  Field_Set(&field, "Power:  12 mW");
+  flush("field shorter");
+
+  FB_DrawRect(0, 0, FB_WIDTH, FB_HEIGHT, BLUE);
+  FB_DrawLine(0, 150, 127, 140, GREEN);
+  FB_DrawLine(127, 159, 0, 138, RED);
+  flush("frame, lines");
+
+  uint16_t img[16 * 8];
+  for (unsigned i = 0; i < 16 * 8; i++)
+    img[i] = swap(uint16_t(i * 0x0821));
+  FB_DrawImage(120, 150, 16, 8, img);   /* clipped at the corner */
+  FB_WriteString(10, 140, "SD closed", Font_7x10, GREEN, BLACK);
+  flush("image, status");
+
+  /* more scattered rectangles than the dirty list holds */
+  for (unsigned i = 0; i < 3 * FB_MAX_DIRTY; i++)
+    FB_FillRect(uint16_t((i * 37) % 120), uint16_t((i * 53) % 150), 3, 3, RED);
+  flush("scattered");
+
+  FB_DrawPixel(200, 200, RED);           /* off screen, nothing to send */
+  flush("off screen");
+
+  FB_Stats st;
+  FB_GetStats(&st);
+  printf("total %lu flushes, %lu windows, %lu pixels\n", (unsigned long)st.flushes,
+         (unsigned long)st.rects, (unsigned long)st.pixels);
+
+  Glyph_Stats gs;
+  Glyph_GetStats(&gs);
+  printf("glyphs %lu hits, %lu misses, %lu uncached\n", (unsigned long)gs.hits,
+         (unsigned long)gs.misses, (unsigned long)gs.uncached);
+
+  if (!write_ppm(out))
+    return 1;
+  printf("%s written, %d mismatches\n", out, failures);
+  return failures ? 1 : 0;
+}
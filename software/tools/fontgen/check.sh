@@ -0,0 +1,27 @@
+#!/bin/sh
+#
+# check.sh
+#
+#  The firmware build compiles the checked in Core/Src/fonts_packed.c and
+#  does not run fontgen. This regenerates it from fonts.c into a temporary
+#  file and fails when the checked in copy differs, e.g. after fonts.c
+#  was edited without running fontgen.
+#
+#  Usage:  ./check.sh
+
+set -e
+cd "$(dirname "$0")"
+
+src=../../STM32CubeIDE/badanie-ogniw/Core/Src
+tmp=$(mktemp -d)
+trap 'rm -rf "$tmp"' EXIT
+
+g++ -O2 -std=c++17 -o "$tmp/fontgen" fontgen.cpp
+"$tmp/fontgen" $src/fonts.c "$tmp/fonts_packed.c" > /dev/null
+
+if ! cmp -s "$tmp/fonts_packed.c" $src/fonts_packed.c; then
+    echo "fonts_packed.c is out of date, run: fontgen $src/fonts.c $src/fonts_packed.c"
+    diff $src/fonts_packed.c "$tmp/fonts_packed.c" | head -20
+    exit 1
+fi
+echo "fonts_packed.c up to date"
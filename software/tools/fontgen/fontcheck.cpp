@@ -0,0 +1,148 @@
+/*
+ * fontcheck.cpp
+ *
+ *  Host check of the generated run tables (Core/Src/fonts_packed.c). Every
+ *  glyph of every font is drawn by the firmware glyph cache, colour and
+ *  A4 mask, and compared with a bit by bit expansion of the row tables in
+ *  fonts.c, the way glyphs were drawn before. Then both expansions are
+ *  timed, every call a cache miss.
+ *
+ *  Build:  gcc -O2 -DFB_HOST -DFONTS_RAW -I../../STM32CubeIDE/badanie-ogniw/Core/Inc -c \
+ *              ../../STM32CubeIDE/badanie-ogniw/Core/Src/fonts.c \
+ *              ../../STM32CubeIDE/badanie-ogniw/Core/Src/fonts_packed.c \
+ *              ../../STM32CubeIDE/badanie-ogniw/Core/Src/glyph_cache.c \
+ *              ../../STM32CubeIDE/badanie-ogniw/Core/Src/gfx2d.c
+ *          g++ -O2 -std=c++17 -DFB_HOST -o fontcheck fontcheck.cpp fonts.o fonts_packed.o \
+ *              glyph_cache.o gfx2d.o
+ *  Usage:  fontcheck
+ *
+ *  Exits non-zero after printing the first mismatches.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+#include "../../STM32CubeIDE/badanie-ogniw/Core/Inc/fonts.h"
+#include "../../STM32CubeIDE/badanie-ogniw/Core/Inc/glyph_cache.h"
+
+namespace {
+
+uint16_t swap(uint16_t c) { return uint16_t(c >> 8 | c << 8); }
+
+/* The expansion before the run tables */
+void expand_rows(const FontDef *font, char ch, uint16_t color, uint16_t bgcolor, uint16_t *out)
+{
+  const uint16_t *rows = &font->data[(ch - 32) * font->height];
+  uint16_t fg = swap(color), bg = swap(bgcolor);
+
+  for (uint8_t i = 0; i < font->height; i++)
+  {
+    uint32_t b = rows[i];
+
+    for (uint8_t j = 0; j < font->width; j++)
+      *out++ = ((b << j) & 0x8000) ? fg : bg;
+  }
+}
+
+int failures;
+volatile uint32_t sink;   /* keeps the timed loops */
+
+void fail(const FontDef *font, int ch, const char *what, unsigned i)
+{
+  if (failures++ < 10)
+    fprintf(stderr, "%ux%u '%c' %s differs at pixel %u\n", font->width, font->height, ch, what, i);
+}
+
+} // namespace
+
+int main()
+{
+  const FontDef *fonts[] = { &Font_7x10, &Font_11x18, &Font_16x26 };
+  const uint16_t colors[][2] = { { 0xFFFF, 0x0000 }, { 0xF800, 0x07FF }, { 0x1234, 0xABCD } };
+  unsigned glyphs = 0;
+
+  for (const FontDef *font : fonts)
+  {
+    unsigned n = font->width * font->height;
+    unsigned stride = GLYPH_MASK_STRIDE(font->width);
+    std::vector<uint16_t> want(n);
+
+    for (int ch = 32; ch <= 126; ch++)
+    {
+      for (const auto &cp : colors)
+      {
+        expand_rows(font, char(ch), cp[0], cp[1], want.data());
+        const uint16_t *got = Glyph_Get(font, char(ch), cp[0], cp[1]);
+        for (unsigned i = 0; i < n; i++)
+        {
+          if (got[i] != want[i])
+          {
+            fail(font, ch, "colour glyph", i);
+            break;
+          }
+        }
+      }
+
+      expand_rows(font, char(ch), 0xFFFF, 0x0000, want.data());
+      const uint8_t *mask = Glyph_GetMask(font, char(ch));
+      for (unsigned i = 0; i < n; i++)
+      {
+        unsigned m = (i / font->width) * stride + i % font->width;
+        unsigned a = (m & 1) ? mask[m / 2] >> 4 : mask[m / 2] & 0x0F;
+        if (a != (want[i] ? 0x0F : 0))
+        {
+          fail(font, ch, "mask", i);
+          break;
+        }
+      }
+      /* padding nibbles stay clear */
+      if (stride != font->width)
+      {
+        for (unsigned y = 0; y < font->height; y++)
+        {
+          if (mask[(y * stride + stride - 1) / 2] >> 4)
+          {
+            fail(font, ch, "mask padding", y * font->width);
+            break;
+          }
+        }
+      }
+      glyphs++;
+    }
+  }
+
+  /* expansion speed, a new colour every call so the cache always misses */
+  for (const FontDef *font : fonts)
+  {
+    const int rounds = 2000;
+    std::vector<uint16_t> out(font->width * font->height);
+    uint32_t sum = 0;
+
+    auto t0 = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; r++)
+    {
+      for (int ch = 32; ch <= 126; ch++)
+      {
+        expand_rows(font, char(ch), uint16_t(r), uint16_t(~r), out.data());
+        sum += out[r % out.size()];
+      }
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; r++)
+    {
+      for (int ch = 32; ch <= 126; ch++)
+        sum += Glyph_Get(font, char(ch), uint16_t(r), uint16_t(~r))[r % out.size()];
+    }
+    auto t2 = std::chrono::steady_clock::now();
+
+    double rows_ns = std::chrono::duration<double, std::nano>(t1 - t0).count() / (rounds * 95.0);
+    double runs_ns = std::chrono::duration<double, std::nano>(t2 - t1).count() / (rounds * 95.0);
+    sink = sum;
+    printf("%2ux%-2u rows %6.1f ns, runs %6.1f ns per glyph (%.1fx)\n", font->width, font->height,
+           rows_ns, runs_ns, rows_ns / runs_ns);
+  }
+
+  printf("%u glyphs checked, %d mismatches\n", glyphs, failures);
+  return failures ? 1 : 0;
+}
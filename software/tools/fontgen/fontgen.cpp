@@ -0,0 +1,210 @@
+/*
+ * fontgen.cpp
+ *
+ *  Generates Core/Src/fonts_packed.c from the row tables in Core/Src/fonts.c.
+ *  Every glyph becomes a list of runs read from the top left, row after
+ *  row: one byte per pair, background pixels in the high nibble and
+ *  foreground in the low one, longer runs split. The background after
+ *  the last run is left out. An offset table per font finds a glyph.
+ *  The generated tables are decoded again and compared with the rows
+ *  before anything is written.
+ *
+ *  Not part of the firmware build: the output is checked in, run this
+ *  again after editing fonts.c. check.sh tells whether it is current.
+ *
+ *  Build:  g++ -O2 -std=c++17 -o fontgen fontgen.cpp
+ *  Usage:  fontgen ../../STM32CubeIDE/badanie-ogniw/Core/Src/fonts.c \
+ *              ../../STM32CubeIDE/badanie-ogniw/Core/Src/fonts_packed.c
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <regex>
+#include <string>
+#include <vector>
+
+namespace {
+
+const int Glyphs = 95;      /* ' ' .. '~' */
+
+struct Font {
+  std::string name;         /* FontWxH */
+  unsigned width, height;
+  std::vector<uint16_t> rows;
+  std::vector<uint8_t> runs;
+  std::vector<uint16_t> offsets;
+};
+
+bool pixel(const Font &f, int glyph, unsigned i)
+{
+  return (f.rows[glyph * f.height + i / f.width] << (i % f.width)) & 0x8000;
+}
+
+void encode(Font &f)
+{
+  unsigned n = f.width * f.height;
+
+  for (int g = 0; g < Glyphs; g++)
+  {
+    unsigned last = n;
+    while (last > 0 && !pixel(f, g, last - 1))
+      last--;
+
+    f.offsets.push_back(uint16_t(f.runs.size()));
+    for (unsigned i = 0; i < last; )
+    {
+      unsigned bg = 0, fg = 0;
+
+      while (i < last && !pixel(f, g, i) && bg < 15)
+      {
+        bg++;
+        i++;
+      }
+      /* longer runs go on in the next pair */
+      while (i < last && pixel(f, g, i) && fg < 15)
+      {
+        fg++;
+        i++;
+      }
+      f.runs.push_back(uint8_t(bg << 4 | fg));
+    }
+  }
+  f.offsets.push_back(uint16_t(f.runs.size()));
+}
+
+bool verify(const Font &f)
+{
+  for (int g = 0; g < Glyphs; g++)
+  {
+    std::vector<bool> px;
+
+    for (unsigned r = f.offsets[g]; r < f.offsets[g + 1]; r++)
+    {
+      px.insert(px.end(), f.runs[r] >> 4, false);
+      px.insert(px.end(), f.runs[r] & 15, true);
+    }
+    if (px.size() > f.width * f.height)
+      return false;
+    px.resize(f.width * f.height, false);
+    for (unsigned i = 0; i < px.size(); i++)
+    {
+      if (px[i] != pixel(f, g, i))
+      {
+        fprintf(stderr, "%s: glyph '%c' differs at pixel %u\n", f.name.c_str(), g + 32, i);
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+std::string glyph_name(int g)
+{
+  char c = char(g + 32);
+  if (c == ' ')
+    return "sp";
+  if (c == '\\')
+    return "backslash";
+  return std::string(1, c);
+}
+
+void emit(FILE *out, const Font &f)
+{
+  fprintf(out, "\n/* %ux%u, %zu bytes of runs, %zu of rows in fonts.c */\n", f.width, f.height,
+          f.runs.size(), f.rows.size() * 2);
+  fprintf(out, "const uint8_t %s_Runs[] = {\n", f.name.c_str());
+  for (int g = 0; g < Glyphs; g++)
+  {
+    std::string line = "   ";
+    for (unsigned r = f.offsets[g]; r < f.offsets[g + 1]; r++)
+    {
+      char b[8];
+      snprintf(b, sizeof(b), " 0x%02X,", f.runs[r]);
+      line += b;
+    }
+    fprintf(out, "%s // %s\n", line.c_str(), glyph_name(g).c_str());
+  }
+  fprintf(out, "};\n\nconst uint16_t %s_Offsets[%d] = {", f.name.c_str(), Glyphs + 1);
+  for (int g = 0; g <= Glyphs; g++)
+    fprintf(out, "%s%u%s", g % 12 ? " " : "\n    ", f.offsets[g], g < Glyphs ? "," : "");
+  fprintf(out, "\n};\n");
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+  if (argc != 3)
+  {
+    fprintf(stderr, "usage: %s fonts.c fonts_packed.c\n", argv[0]);
+    return 2;
+  }
+
+  std::ifstream in(argv[1]);
+  if (!in)
+  {
+    perror(argv[1]);
+    return 1;
+  }
+
+  /* drop line comments, the glyph names may hold anything */
+  std::string src, line;
+  while (std::getline(in, line))
+    src += line.substr(0, line.find("//")) + "\n";
+
+  std::vector<Font> fonts;
+  std::regex table(R"(const\s+uint16_t\s+(Font(\d+)x(\d+))\s*\[\]\s*=\s*\{([^}]*)\})");
+  std::regex word(R"(0x([0-9A-Fa-f]{1,4}))");
+
+  for (std::sregex_iterator t(src.begin(), src.end(), table), end; t != end; ++t)
+  {
+    Font f;
+    f.name = (*t)[1];
+    f.width = unsigned(std::stoul((*t)[2]));
+    f.height = unsigned(std::stoul((*t)[3]));
+
+    std::string body = (*t)[4];
+    for (std::sregex_iterator w(body.begin(), body.end(), word); w != end; ++w)
+      f.rows.push_back(uint16_t(std::stoul((*w)[1], nullptr, 16)));
+
+    if (f.width > 16 || f.rows.size() != size_t(Glyphs) * f.height)
+    {
+      fprintf(stderr, "%s: %zu rows, expected %d\n", f.name.c_str(), f.rows.size(), Glyphs * f.height);
+      return 1;
+    }
+    encode(f);
+    if (!verify(f))
+      return 1;
+    fonts.push_back(f);
+  }
+
+  if (fonts.empty())
+  {
+    fprintf(stderr, "%s: no font tables found\n", argv[1]);
+    return 1;
+  }
+
+  FILE *out = fopen(argv[2], "w");
+  if (!out)
+  {
+    perror(argv[2]);
+    return 1;
+  }
+
+  fprintf(out, "/*\n * fonts_packed.c\n *\n"
+               " *  Generated by software/tools/fontgen from fonts.c and checked in,\n"
+               " *  do not edit. Run fontgen again after changing fonts.c.\n *\n"
+               " *  Runs of each glyph from the top left, row after row: background\n"
+               " *  pixels in the high nibble, foreground in the low one. Background\n"
+               " *  after the last run is implied. Glyph c is\n"
+               " *  Runs[Offsets[c - 32]] .. Runs[Offsets[c - 31] - 1].\n */\n\n"
+               "#include \"fonts.h\"\n");
+  for (const Font &f : fonts)
+  {
+    emit(out, f);
+    printf("%s: %zu bytes of runs + %zu of offsets, was %zu\n", f.name.c_str(), f.runs.size(),
+           f.offsets.size() * 2, f.rows.size() * 2);
+  }
+  return fclose(out) == 0 ? 0 : 1;
+}
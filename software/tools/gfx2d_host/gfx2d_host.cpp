@@ -0,0 +1,234 @@
+/*
+ * gfx2d_host.cpp
+ *
+ *  Host check of the framebuffer pixel back end (Core/Src/gfx2d.c). The
+ *  DMA2D path is built for the host and its register values run on a
+ *  model of the DMA2D (pixel format conversion, alpha modes, blending and
+ *  output conversion as in RM0385). Every fill, copy and glyph of all
+ *  three fonts in several colour pairs and clip widths has to give the
+ *  same pixels as the portable C path, and glyphs also the same as a
+ *  plain expansion of the font bits.
+ *
+ *  Build:  gcc -O2 -DFB_HOST -DFONTS_RAW -DGFX2D_DMA2D=1 -DGFX2D_MIN_PIXELS=1 \
+ *              -I../../STM32CubeIDE/badanie-ogniw/Core/Inc -c \
+ *              ../../STM32CubeIDE/badanie-ogniw/Core/Src/gfx2d.c \
+ *              ../../STM32CubeIDE/badanie-ogniw/Core/Src/glyph_cache.c \
+ *              ../../STM32CubeIDE/badanie-ogniw/Core/Src/fonts.c \
+ *              ../../STM32CubeIDE/badanie-ogniw/Core/Src/fonts_packed.c
+ *          g++ -O2 -std=c++17 -DFB_HOST -DGFX2D_DMA2D=1 -o gfx2d_host gfx2d_host.cpp \
+ *              gfx2d.o glyph_cache.o fonts.o fonts_packed.o
+ *  Usage:  gfx2d_host
+ *
+ *  Exits non-zero after printing the first mismatches.
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "../../STM32CubeIDE/badanie-ogniw/Core/Inc/gfx2d.h"
+#include "../../STM32CubeIDE/badanie-ogniw/Core/Inc/glyph_cache.h"
+
+namespace {
+
+struct Argb { uint32_t a, r, g, b; };
+
+uint16_t swap(uint16_t c) { return uint16_t(c >> 8 | c << 8); }
+
+/* One input pixel of a layer, index counted from the layer start */
+Argb fetch(const void *base, uint32_t cm, uint32_t index, uint32_t colr)
+{
+  Argb p = { 0xFF, (colr >> 16) & 0xFF, (colr >> 8) & 0xFF, colr & 0xFF };
+
+  switch (cm)
+  {
+  case 2: /* RGB565 */
+  {
+    uint16_t c = static_cast<const uint16_t *>(base)[index];
+    uint32_t r = c >> 11, g = (c >> 5) & 0x3F, b = c & 0x1F;
+    p.r = r << 3 | r >> 2;
+    p.g = g << 2 | g >> 4;
+    p.b = b << 3 | b >> 2;
+    break;
+  }
+  case 10: /* A4, first pixel in the low nibble */
+  {
+    uint8_t byte = static_cast<const uint8_t *>(base)[index / 2];
+    uint32_t a = (index & 1) ? byte >> 4 : byte & 0x0F;
+    p.a = a << 4 | a;
+    break;
+  }
+  default:
+    fprintf(stderr, "model: colour mode %u not modelled\n", cm);
+    break;
+  }
+  return p;
+}
+
+void alpha_mode(Argb &p, uint32_t pfccr)
+{
+  uint32_t am = (pfccr >> 16) & 3, alpha = pfccr >> 24;
+
+  if (am == 1)
+    p.a = alpha;
+  else if (am == 2)
+    p.a = p.a * alpha / 255;
+}
+
+int checks, failures;
+
+bool same(const char *what, const std::vector<uint16_t> &a, const std::vector<uint16_t> &b)
+{
+  checks++;
+  for (size_t i = 0; i < a.size(); i++)
+  {
+    if (a[i] != b[i])
+    {
+      if (failures++ < 10)
+        fprintf(stderr, "%s: pixel %zu is %04x, expected %04x\n", what, i, a[i], b[i]);
+      return false;
+    }
+  }
+  return true;
+}
+
+/* Straight from the font rows (FONTS_RAW), independent of both paths */
+void reference_glyph(uint16_t *out, unsigned pitch, const FontDef *font, char ch,
+                     unsigned w, unsigned h, uint16_t color, uint16_t bg)
+{
+  if (ch < 32 || ch > 126)
+    ch = '?';
+  for (unsigned i = 0; i < h; i++)
+  {
+    uint16_t bits = font->data[(ch - 32) * font->height + i];
+    for (unsigned j = 0; j < w; j++)
+      out[i * pitch + j] = swap((bits << j) & 0x8000 ? color : bg);
+  }
+}
+
+const uint16_t Colors[][2] = {
+  { 0xFFFF, 0x0000 }, { 0x0000, 0xFFFF }, { 0xF800, 0x001F }, { 0x07E0, 0xF81F },
+  { 0x1234, 0xFEDC }, { 0x0821, 0x7BEF }, { 0xFFE0, 0x07FF }, { 0x0001, 0x8000 },
+};
+
+} // namespace
+
+/* DMA2D model, only what gfx2d.c programs: M2M, R2M and blending into RGB565 */
+extern "C" void Gfx2D_HostRun(const Gfx2D_Xfer *x)
+{
+  uint32_t mode = (x->CR >> 16) & 3;
+  uint32_t w = x->NLR >> 16, h = x->NLR & 0xFFFF;
+  uint16_t *out = static_cast<uint16_t *>(x->out);
+
+  if ((x->OPFCCR & 7) != 2)
+    fprintf(stderr, "model: output mode %u not modelled\n", x->OPFCCR & 7);
+
+  for (uint32_t y = 0; y < h; y++)
+  {
+    for (uint32_t i = 0; i < w; i++)
+    {
+      uint16_t *o = &out[y * (w + x->OOR) + i];
+
+      if (mode == 3)
+      {
+        *o = uint16_t(x->OCOLR);
+        continue;
+      }
+
+      Argb f = fetch(x->fg, x->FGPFCCR & 0xF, y * (w + x->FGOR) + i, x->FGCOLR);
+      alpha_mode(f, x->FGPFCCR);
+
+      if (mode == 0 && (x->FGPFCCR & 0xF) == 2)
+      {
+        /* plain copy, no conversion */
+        *o = static_cast<const uint16_t *>(x->fg)[y * (w + x->FGOR) + i];
+        continue;
+      }
+
+      Argb c = f;
+      if (mode == 2)
+      {
+        Argb b = fetch(x->bg, x->BGPFCCR & 0xF, y * (w + x->BGOR) + i, x->BGCOLR);
+        alpha_mode(b, x->BGPFCCR);
+
+        uint32_t mult = f.a * b.a / 255;
+        uint32_t ar = f.a + b.a - mult;
+        c.a = ar;
+        if (ar)
+        {
+          c.r = (f.r * f.a + b.r * b.a - b.r * mult) / ar;
+          c.g = (f.g * f.a + b.g * b.a - b.g * mult) / ar;
+          c.b = (f.b * f.a + b.b * b.a - b.b * mult) / ar;
+        }
+        else
+        {
+          c.r = c.g = c.b = 0;
+        }
+      }
+      *o = uint16_t((c.r >> 3) << 11 | (c.g >> 2) << 5 | (c.b >> 3));
+    }
+  }
+}
+
+int main()
+{
+  const FontDef *fonts[] = { &Font_7x10, &Font_11x18, &Font_16x26 };
+  const unsigned pitch = 40;
+  std::vector<uint16_t> hw(pitch * 32), soft(pitch * 32), ref(pitch * 32);
+  std::mt19937 rng(7);
+  char what[64];
+
+  for (const FontDef *font : fonts)
+  {
+    for (const auto &cp : Colors)
+    {
+      for (int c = 31; c <= 127; c++)
+      {
+        /* full glyph and a clipped one, odd widths included */
+        unsigned widths[] = { font->width, unsigned(font->width / 2 + 1) };
+        for (unsigned w : widths)
+        {
+          unsigned h = (c & 1) ? font->height : unsigned(font->height - 3);
+          std::fill(hw.begin(), hw.end(), 0x5A5A);
+          soft = ref = hw;
+
+          Gfx2D_Glyph(hw.data() + 1, pitch, font, char(c), uint16_t(w), uint16_t(h), cp[0], cp[1]);
+          Gfx2D_SoftGlyph(soft.data() + 1, pitch, font, char(c), uint16_t(w), uint16_t(h), cp[0], cp[1]);
+          reference_glyph(ref.data() + 1, pitch, font, char(c), w, h, cp[0], cp[1]);
+
+          snprintf(what, sizeof(what), "glyph %ux%u '%c' %ux%u %04x/%04x", font->width, font->height,
+                   c, w, h, cp[0], cp[1]);
+          same(what, hw, soft) && same(what, soft, ref);
+        }
+      }
+    }
+  }
+
+  for (int n = 0; n < 2000; n++)
+  {
+    unsigned w = 1 + rng() % 39, h = 1 + rng() % 31, x = rng() % (pitch - w + 1);
+    uint16_t color = uint16_t(rng());
+    std::vector<uint16_t> src(pitch * 32);
+    for (auto &p : src)
+      p = uint16_t(rng());
+
+    std::fill(hw.begin(), hw.end(), 0x5A5A);
+    soft = hw;
+    Gfx2D_Fill(hw.data() + x, pitch, uint16_t(w), uint16_t(h), color);
+    Gfx2D_SoftFill(soft.data() + x, pitch, uint16_t(w), uint16_t(h), color);
+    snprintf(what, sizeof(what), "fill %ux%u at %u %04x", w, h, x, color);
+    same(what, hw, soft);
+
+    Gfx2D_Copy(hw.data() + x, pitch, src.data() + 3, pitch, uint16_t(w - (w > 3 ? 3 : 0)), uint16_t(h));
+    Gfx2D_SoftCopy(soft.data() + x, pitch, src.data() + 3, pitch, uint16_t(w - (w > 3 ? 3 : 0)), uint16_t(h));
+    snprintf(what, sizeof(what), "copy %ux%u at %u", w, h, x);
+    same(what, hw, soft);
+  }
+
+  Gfx2D_Stats st;
+  Gfx2D_GetStats(&st);
+  printf("%d checks, %lu dma2d ops, %lu pixels, %d mismatches\n", checks, (unsigned long)st.ops,
+         (unsigned long)st.pixels, failures);
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,225 @@
+/*
+ * numfmt_host.cpp
+ *
+ *  Host build of the firmware number formatter (Core/Src/numfmt.c).
+ *  Compares every routine with snprintf over edge cases and random
+ *  values, then times both on the rows the firmware writes. Values that
+ *  sit exactly half way in decimal but not in binary are skipped, there
+ *  printf rounds the binary approximation.
+ *
+ *  Build:  gcc -O2 -I../../STM32CubeIDE/badanie-ogniw/Core/Inc \
+ *              -c ../../STM32CubeIDE/badanie-ogniw/Core/Src/numfmt.c
+ *          g++ -O2 -std=c++17 -o numfmt_host numfmt_host.cpp numfmt.o
+ *  Usage:  numfmt_host [random values]
+ *
+ *  Exits non-zero after printing the first mismatches.
+ */
+
+#include <chrono>
+#include <cinttypes>
+#include <climits>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../../STM32CubeIDE/badanie-ogniw/Core/Inc/numfmt.h"
+
+namespace {
+
+size_t failures;
+size_t decimal_ties;
+
+void expect(const char *what, const std::string &got, const char *want)
+{
+  if (got == want)
+    return;
+  if (failures++ < 20)
+    fprintf(stderr, "%s: got \"%s\", snprintf \"%s\"\n", what, got.c_str(), want);
+}
+
+void check_int(uint32_t u)
+{
+  char buf[NUMFMT_MAX], want[32];
+
+  snprintf(want, sizeof(want), "%" PRIu32, u);
+  expect("U32", std::string(buf, NumFmt_U32(buf, u)), want);
+
+  int32_t i = int32_t(u);
+  snprintf(want, sizeof(want), "%" PRId32, i);
+  expect("I32", std::string(buf, NumFmt_I32(buf, i)), want);
+}
+
+/* the firmware divisors: centi degrees, SGP30 signals, ADC counts, milli units */
+const uint32_t divisors[] = { 1, 10, 100, 512, 1000, 4095 };
+
+void check_fixed(int32_t raw)
+{
+  char buf[NUMFMT_MAX], want[48], what[48];
+
+  for (uint32_t d : divisors)
+  {
+    for (uint8_t dec = 0; dec <= NUMFMT_MAX_DECIMALS; dec++)
+    {
+      /* An exact half like 2.55 to one decimal: numfmt rounds the exact
+         value half to even, printf the nearest double (2.5499...). */
+      uint64_t twice = uint64_t(raw < 0 ? -int64_t(raw) : raw) * 2 * uint64_t(pow(10, dec));
+      if ((d & (d - 1)) && twice % d == 0 && (twice / d) & 1)
+      {
+        decimal_ties++;
+        continue;
+      }
+      snprintf(want, sizeof(want), "%.*f", dec, double(raw) / d);
+      snprintf(what, sizeof(what), "Fixed(%" PRId32 ", %" PRIu32 ", %u)", raw, d, dec);
+      expect(what, std::string(buf, NumFmt_Fixed(buf, raw, d, dec)), want);
+    }
+  }
+}
+
+void check_right()
+{
+  char buf[32], want[32];
+
+  for (int32_t v : { 0, 7, -7, 1234, -1234, 123456 })
+  {
+    for (uint8_t w = 0; w < 8; w++)
+    {
+      snprintf(want, sizeof(want), "%*" PRId32, w, v);
+      char *end = NumFmt_Right(buf, NumFmt_I32(buf, v), w);
+      expect("Right", std::string(buf, end), want);
+    }
+  }
+}
+
+struct Row
+{
+  uint16_t tvoc, co2, ethanol, h2, voltage, power;
+  int32_t temp_cC, pressure;
+  int16_t current;
+};
+
+/* the SD card CSV row, main.c SDcardWriteData */
+int row_snprintf(char *buf, size_t size, const Row &r)
+{
+  return snprintf(buf, size, "%u,%u,%.2f,%.2f,%.2f,%" PRId32 ",%u,%d,%u\n",
+                  r.tvoc, r.co2, r.ethanol / 512.0, r.h2 / 512.0, r.temp_cC / 100.0,
+                  r.pressure, r.voltage, r.current, r.power);
+}
+
+int row_numfmt(char *buf, size_t size, const Row &r)
+{
+  CsvRow row;
+  CsvRow_Init(&row, buf, size);
+  CsvRow_U32(&row, r.tvoc);
+  CsvRow_U32(&row, r.co2);
+  CsvRow_Fixed(&row, r.ethanol, 512, 2);
+  CsvRow_Fixed(&row, r.h2, 512, 2);
+  CsvRow_Fixed(&row, r.temp_cC, 100, 2);
+  CsvRow_I32(&row, r.pressure);
+  CsvRow_U32(&row, r.voltage);
+  CsvRow_I32(&row, r.current);
+  CsvRow_U32(&row, r.power);
+  return CsvRow_End(&row);
+}
+
+Row random_row(std::mt19937 &rng)
+{
+  Row r;
+  r.tvoc = uint16_t(rng());
+  r.co2 = uint16_t(rng());
+  r.ethanol = uint16_t(rng());
+  r.h2 = uint16_t(rng());
+  r.voltage = uint16_t(rng());
+  r.power = uint16_t(rng());
+  r.temp_cC = int32_t(rng() % 12000) - 4000;
+  r.pressure = int32_t(30000 + rng() % 80000);
+  r.current = int16_t(rng());
+  return r;
+}
+
+void check_row(const Row &r)
+{
+  char a[200], b[200];
+  int na = row_numfmt(a, sizeof(a), r);
+  row_snprintf(b, sizeof(b), r);
+  expect("CsvRow", na < 0 ? std::string("<overflow>") : std::string(a, size_t(na)), b);
+}
+
+void check_overflow()
+{
+  char buf[200];
+  Row r{};
+  for (size_t size = 0; size < 24; size++)
+  {
+    int n = row_numfmt(buf, size, r);
+    if (n >= 0 && size_t(n) > size)
+      expect("CsvRow overflow", "written past the end", "-1");
+  }
+}
+
+template <typename F>
+double ns_per_call(size_t n, F fn)
+{
+  auto t0 = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < n; i++)
+    fn(i);
+  auto t1 = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::nano>(t1 - t0).count() / double(n);
+}
+
+volatile int sink;
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+  size_t n = argc > 1 ? strtoul(argv[1], nullptr, 0) : 1000000;
+  std::mt19937 rng(12345);
+
+  for (int64_t v : { INT64_C(0), INT64_C(1), INT64_C(9), INT64_C(10), INT64_C(99), INT64_C(100),
+                     INT64_C(255), INT64_C(256), INT64_C(511), INT64_C(512), INT64_C(4094), INT64_C(4095),
+                     INT64_C(65535), INT64_C(999999999), INT64_C(1000000000),
+                     int64_t(INT32_MAX), int64_t(INT32_MIN), int64_t(UINT32_MAX) })
+  {
+    check_int(uint32_t(v));
+    check_int(uint32_t(-v));
+    check_fixed(int32_t(v));
+    check_fixed(int32_t(-v));
+  }
+  for (int32_t v = -70000; v <= 70000; v++)
+    check_fixed(v);
+  for (size_t i = 0; i < n; i++)
+  {
+    uint32_t u = uint32_t(rng());
+    check_int(u >> (rng() % 32));
+    if (i % 16 == 0)
+      check_fixed(int32_t(u));
+    if (i % 8 == 0)
+      check_row(random_row(rng));
+  }
+  check_right();
+  check_overflow();
+
+  std::vector<Row> rows(4096);
+  for (Row &r : rows)
+    r = random_row(rng);
+  char buf[200];
+  size_t iters = n < 100000 ? 100000 : n;
+
+  double t_sn = ns_per_call(iters, [&](size_t i) { sink = row_snprintf(buf, sizeof(buf), rows[i & 4095]); });
+  double t_nf = ns_per_call(iters, [&](size_t i) { sink = row_numfmt(buf, sizeof(buf), rows[i & 4095]); });
+  double f_sn = ns_per_call(iters, [&](size_t i) {
+    sink = snprintf(buf, sizeof(buf), "%.2f", rows[i & 4095].ethanol / 512.0); });
+  double f_nf = ns_per_call(iters, [&](size_t i) {
+    sink = int(NumFmt_Fixed(buf, rows[i & 4095].ethanol, 512, 2) - buf); });
+
+  printf("%-18s %10s %10s %8s\n", "", "snprintf", "numfmt", "speedup");
+  printf("%-18s %8.1fns %8.1fns %7.1fx\n", "CSV row", t_sn, t_nf, t_sn / t_nf);
+  printf("%-18s %8.1fns %8.1fns %7.1fx\n", "%.2f of raw/512", f_sn, f_nf, f_sn / f_nf);
+  printf("%zu mismatches, %zu decimal ties skipped\n", failures, decimal_ties);
+
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,195 @@
+/*
+ * profiler_host.cpp
+ *
+ *  Host build of the firmware profiler (Core/Src/profiler.c) on a
+ *  std::chrono clock, used to time the portable parts of the pipeline
+ *  (record CRC, the SD log writer) and to check the profiler itself.
+ *
+ *  sdlog_write times the firmware SDlog_Write (Core/Src/sd_log.c) with
+ *  FatFs on a RAM disk, the log file opened like TaskLog does: contiguous
+ *  area of LOG_PREALLOC_BYTES, a commit every 60 rows as SDLOG_SYNC_MS
+ *  gives at a 1 s sample period. Sectors are copied instead of sent to a
+ *  card, so this is the CPU side of a row: staging, chunk writes through
+ *  FatFs and the commits, without the SPI time.
+ *
+ *  Build:  FW=../../STM32CubeIDE/badanie-ogniw
+ *          INC="-I../spi_bus_host/stub -I$FW/Core/Inc -I$FW/FATFS/Target \
+ *               -I$FW/Middlewares/Third_Party/FatFs/src"
+ *          gcc -O2 -DPROFILER_HOST $INC -c $FW/Core/Src/profiler.c $FW/Core/Src/sd_log.c \
+ *              $FW/Middlewares/Third_Party/FatFs/src/ff.c $FW/Middlewares/Third_Party/FatFs/src/option/ccsbcs.c
+ *          g++ -O2 -std=c++17 -DPROFILER_HOST $INC -o profiler_host profiler_host.cpp \
+ *              profiler.o sd_log.o ff.o ccsbcs.o
+ *  Usage:  profiler_host [iterations]
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "ff.h"
+#include "diskio.h"
+#include "fatfs_sd.h"
+#include "sd_log.h"
+#include "log_record.h"
+#include "profiler.h"
+
+/* PROFILER_NOW(): nanoseconds, wraps every 4.3 s like CYCCNT every 59 s */
+extern "C" uint32_t Profiler_HostNow(void)
+{
+  using namespace std::chrono;
+  return uint32_t(duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count());
+}
+
+namespace {
+
+const DWORD DiskSectors = 2 * LOG_PREALLOC_BYTES / 512;
+
+std::vector<uint8_t> Disk(size_t(DiskSectors) * 512);
+uint32_t SectorsWritten;
+
+volatile uint16_t sink;
+
+void crc_record(const LogRecord &rec)
+{
+  PROFILE_BEGIN(crc_record);
+  sink = Log_Crc16(&rec, offsetof(LogRecord, crc));
+  PROFILE_END(crc_record);
+}
+
+void crc_header(const LogFileHeader &hdr)
+{
+  PROFILE_BEGIN(crc_header);
+  sink = Log_Crc16(&hdr, offsetof(LogFileHeader, crc));
+  PROFILE_END(crc_header);
+}
+
+/* One log row through the firmware writer, as SDcardWriteData does */
+FRESULT sdlog_write(const LogRecord &rec)
+{
+  PROFILE_BEGIN(sdlog_write);
+  FRESULT res = SDlog_Write(&rec, sizeof(rec));
+  PROFILE_END(sdlog_write);
+  return res;
+}
+
+} // namespace
+
+/* RAM disk under FatFs, and what sd_log.c takes from the HAL and fatfs_sd.c */
+extern "C" {
+
+DSTATUS disk_initialize(BYTE)
+{
+  return 0;
+}
+
+DSTATUS disk_status(BYTE)
+{
+  return 0;
+}
+
+DRESULT disk_read(BYTE, BYTE *buff, DWORD sector, UINT count)
+{
+  if (sector + count > DiskSectors)
+    return RES_PARERR;
+  memcpy(buff, &Disk[size_t(sector) * 512], size_t(count) * 512);
+  return RES_OK;
+}
+
+DRESULT disk_write(BYTE, const BYTE *buff, DWORD sector, UINT count)
+{
+  if (sector + count > DiskSectors)
+    return RES_PARERR;
+  memcpy(&Disk[size_t(sector) * 512], buff, size_t(count) * 512);
+  SectorsWritten += count;
+  return RES_OK;
+}
+
+DRESULT disk_ioctl(BYTE, BYTE cmd, void *buff)
+{
+  switch (cmd)
+  {
+  case GET_SECTOR_COUNT: *(DWORD *)buff = DiskSectors; return RES_OK;
+  case GET_SECTOR_SIZE:  *(WORD *)buff = 512; return RES_OK;
+  case GET_BLOCK_SIZE:   *(DWORD *)buff = 1; return RES_OK;
+  case CTRL_SYNC:        return RES_OK;
+  default:               return RES_PARERR;
+  }
+}
+
+DWORD get_fattime(void)
+{
+  return 0;
+}
+
+uint32_t HAL_GetTick(void)
+{
+  using namespace std::chrono;
+  return uint32_t(duration_cast<milliseconds>(steady_clock::now().time_since_epoch()).count());
+}
+
+void SD_GetBusStats(SD_BusStats *stats)
+{
+  memset(stats, 0, sizeof(*stats));
+  stats->sectors_written = SectorsWritten;
+}
+
+} // extern "C"
+
+int main(int argc, char **argv)
+{
+  unsigned long n = argc > 1 ? strtoul(argv[1], nullptr, 0) : 100000;
+  static BYTE work[_MAX_SS];
+  static FATFS fs;
+  static FIL fil;
+  LogFileHeader hdr{};
+  LogRecord rec{};
+
+  if (n > LOG_PREALLOC_BYTES / sizeof(LogRecord))
+    n = LOG_PREALLOC_BYTES / sizeof(LogRecord);
+
+  if (f_mkfs("", FM_FAT | FM_SFD, 0, work, sizeof(work)) != FR_OK || f_mount(&fs, "", 1) != FR_OK ||
+      f_open(&fil, "log.bin", FA_CREATE_ALWAYS | FA_WRITE) != FR_OK ||
+      SDlog_OpenContiguous(&fil, LOG_PREALLOC_BYTES) != FR_OK)
+  {
+    fprintf(stderr, "RAM disk log file failed\n");
+    return 1;
+  }
+  SDlog_SyncPolicy policy = { 60, 0, 0 };
+  SDlog_SetSyncPolicy(&policy);
+
+  for (unsigned long i = 0; i < n; i++)
+  {
+    rec.seq = uint32_t(i);
+    rec.time_ms = uint32_t(i * 1000);
+    rec.pressure_Pa = int32_t(100000 + i % 500);
+    crc_record(rec);
+    rec.crc = sink;
+    if (sdlog_write(rec) != FR_OK)
+    {
+      fprintf(stderr, "SDlog_Write failed at row %lu\n", i);
+      return 1;
+    }
+    if (i % 64 == 0)
+      crc_header(hdr);
+  }
+
+  SDlog_Stats st;
+  SDlog_GetStats(&st);
+  FRESULT closed = SDlog_Close();
+
+  FILINFO fi;
+  if (closed != FR_OK || f_stat("log.bin", &fi) != FR_OK || fi.fsize != n * sizeof(LogRecord))
+  {
+    fprintf(stderr, "log file not closed at %lu bytes\n", n * sizeof(LogRecord));
+    return 1;
+  }
+
+  Profiler_Dump();
+  printf("\nSD log: %lu rows, %lu chunk writes (%lu sectors), %lu commits (%lu sectors), %lu errors\n",
+         (unsigned long)st.rows, (unsigned long)st.chunks, (unsigned long)st.chunk_sectors,
+         (unsigned long)st.syncs[SDLOG_SYNC_BY_ROWS], (unsigned long)st.sync_sectors[SDLOG_SYNC_BY_ROWS],
+         (unsigned long)st.errors);
+  return 0;
+}
@@ -0,0 +1,439 @@
+/*
+ * sd_bus_host.cpp
+ *
+ *  Host build of the SD card driver (Core/Src/fatfs_sd.c) on the stubbed
+ *  HAL of spi_bus_host, with an SD card in SPI mode behind hspi1. Writes
+ *  and reads back sectors one per call (CMD24 / CMD17) and in batches
+ *  (ACMD23 + CMD25 / CMD18 + CMD12), and reports the SPI transactions
+ *  per 512-byte sector for each path: the HAL SPI calls counted by the
+ *  driver (SD_BusStats.spi_transfers), the bytes clocked and the chip
+ *  select cycles.
+ *
+ *  The card answers after one byte (Ncr), starts a data block after two
+ *  (Nac) and is busy for three after a write, about as fast as a card
+ *  can be, so the counts are the driver's own cost per sector.
+ *
+ *  Then a block with a bad CRC and a data command without R1 are
+ *  injected: both are retried, only the CRC error slows the data clock.
+ *  Every driver call has to leave the counted bus lock as it found it.
+ *
+ *  Build:  gcc -O2 [-DSD_USE_DMA=0] -I../spi_bus_host/stub -I../../STM32CubeIDE/badanie-ogniw/Core/Inc \
+ *              -I../../STM32CubeIDE/badanie-ogniw/Middlewares/Third_Party/FatFs/src \
+ *              -c ../../STM32CubeIDE/badanie-ogniw/Core/Src/fatfs_sd.c
+ *          g++ -O2 -std=c++17 [-DSD_USE_DMA=0] -I../spi_bus_host/stub \
+ *              -I../../STM32CubeIDE/badanie-ogniw/Core/Inc \
+ *              -I../../STM32CubeIDE/badanie-ogniw/Middlewares/Third_Party/FatFs/src \
+ *              -o sd_bus_host sd_bus_host.cpp fatfs_sd.o
+ *  Usage:  sd_bus_host [sectors [batch]]
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <string>
+#include <vector>
+
+#include "diskio.h"
+#include "fatfs_sd.h"
+#include "spi_bus.h"
+
+SPI_HandleTypeDef hspi1;
+volatile uint8_t Timer1, Timer2;
+
+namespace {
+
+const uint32_t CardSectors = 8192;
+
+/* Bus activity seen on the card side */
+struct Counters {
+  uint32_t hal_calls;       /* HAL_SPI_Transmit / TransmitReceive */
+  uint32_t dma_calls;       /* SPIbus_LockedDma */
+  uint32_t bytes;
+  uint32_t selects;
+  uint32_t unlocked;        /* bytes clocked without the bus lock */
+};
+Counters Count;
+int LockDepth;             /* SPIbus_Lock calls not undone yet */
+
+int checks, failures;
+
+void check(bool ok, const char *what, const std::string &got = "")
+{
+  checks++;
+  if (!ok)
+  {
+    failures++;
+    fprintf(stderr, "%s failed%s%s\n", what, got.empty() ? "" : ": ", got.c_str());
+  }
+}
+
+uint16_t Crc16(const uint8_t *p, size_t len)
+{
+  uint16_t crc = 0;
+
+  while (len--)
+  {
+    crc ^= uint16_t(*p++ << 8);
+    for (int i = 0; i < 8; i++)
+      crc = uint16_t(crc & 0x8000 ? (crc << 1) ^ 0x1021 : crc << 1);
+  }
+  return crc;
+}
+
+/* SD card in SPI mode, SDHC: block addressed, CCS set in the OCR */
+class Card {
+public:
+  std::vector<uint8_t> disk = std::vector<uint8_t>(CardSectors * 512);
+  unsigned badCrc;          /* next data blocks sent with a wrong CRC */
+  unsigned noResponse;      /* next data commands left without R1 */
+
+  void Select(bool on)
+  {
+    selected = on;
+    if (!on)
+    {
+      out.clear();
+      mode = Command;
+      cmdLen = 0;
+      multiRead = false;
+    }
+  }
+
+  uint8_t Exchange(uint8_t mosi)
+  {
+    Count.bytes++;
+    if (!LockDepth)
+      Count.unlocked++;
+    if (!selected)
+      return 0xFF;
+
+    if (out.empty() && multiRead)
+      QueueBlock(next++);
+    uint8_t miso = 0xFF;
+    if (!out.empty())
+    {
+      miso = out.front();
+      out.pop_front();
+    }
+
+    switch (mode)
+    {
+    case Command:
+      if (cmdLen == 0 && (mosi & 0xC0) != 0x40)
+        break;
+      cmd[cmdLen++] = mosi;
+      if (cmdLen == 6)
+      {
+        cmdLen = 0;
+        Execute(cmd[0] & 0x3F, uint32_t(cmd[1]) << 24 | uint32_t(cmd[2]) << 16 | uint32_t(cmd[3]) << 8 | cmd[4]);
+      }
+      break;
+
+    case WriteToken:
+      if (mosi == 0xFE || mosi == 0xFC)
+      {
+        block.clear();
+        mode = WriteData;
+      }
+      else if (mosi == 0xFD)
+      {
+        mode = Command;
+        Busy();
+      }
+      break;
+
+    case WriteData:
+      block.push_back(mosi);
+      if (block.size() == 512 + 2)
+      {
+        if (next < CardSectors)
+          memcpy(&disk[next * 512], block.data(), 512);
+        next++;
+        out.push_back(0xE5);            /* data accepted */
+        Busy();
+        mode = multiWrite ? WriteToken : Command;
+      }
+      break;
+    }
+    return miso;
+  }
+
+private:
+  enum Mode { Command, WriteToken, WriteData };
+
+  std::deque<uint8_t> out;
+  Mode mode = Command;
+  uint8_t cmd[6];
+  int cmdLen = 0;
+  bool selected, app, ready, multiRead, multiWrite;
+  uint32_t next;
+  std::vector<uint8_t> block;
+
+  void Respond(std::initializer_list<uint8_t> bytes)
+  {
+    out.push_back(0xFF);                /* Ncr */
+    out.insert(out.end(), bytes);
+  }
+
+  void Busy()
+  {
+    out.insert(out.end(), { 0x00, 0x00, 0x00 });
+  }
+
+  void QueueBlock(uint32_t sector)
+  {
+    const uint8_t *data = &disk[(sector % CardSectors) * 512];
+    uint16_t crc = Crc16(data, 512);
+
+    if (badCrc)
+    {
+      badCrc--;
+      crc ^= 0x0001;
+    }
+
+    out.insert(out.end(), { 0xFF, 0xFF, 0xFE });   /* Nac, start token */
+    out.insert(out.end(), data, data + 512);
+    out.push_back(uint8_t(crc >> 8));
+    out.push_back(uint8_t(crc));
+  }
+
+  void Execute(uint8_t index, uint32_t arg)
+  {
+    bool acmd = app;
+
+    app = false;
+    if (noResponse && (index == 17 || index == 18 || index == 24 || index == 25))
+    {
+      noResponse--;
+      return;
+    }
+    switch (index)
+    {
+    case 0:
+      ready = false;
+      Respond({ 0x01 });
+      break;
+    case 8:
+      Respond({ 0x01, 0x00, 0x00, uint8_t(arg >> 8), uint8_t(arg) });
+      break;
+    case 12:
+      multiRead = false;
+      out.clear();
+      out.insert(out.end(), { 0xFF, 0x00 });       /* stuff byte, R1 */
+      break;
+    case 17:
+    case 18:
+      Respond({ 0x00 });
+      if (index == 17)
+        QueueBlock(arg);
+      else
+      {
+        multiRead = true;
+        next = arg;
+      }
+      break;
+    case 23:
+      Respond({ uint8_t(acmd ? 0x00 : 0x04) });
+      break;
+    case 24:
+    case 25:
+      Respond({ 0x00 });
+      mode = WriteToken;
+      multiWrite = index == 25;
+      next = arg;
+      break;
+    case 41:
+      ready = true;
+      Respond({ 0x00 });
+      break;
+    case 55:
+      app = true;
+      Respond({ uint8_t(ready ? 0x00 : 0x01) });
+      break;
+    case 58:
+      Respond({ 0x00, 0xC0, 0xFF, 0x80, 0x00 });
+      break;
+    default:
+      Respond({ 0x04 });                /* illegal command */
+      break;
+    }
+  }
+};
+
+Card Sd;
+
+struct Result {
+  const char *path;
+  uint32_t sectors;
+  SD_BusStats bus;
+  Counters seen;
+};
+
+/* Stats of one path over 'sectors' sectors, 'batch' per driver call */
+Result Run(const char *path, bool write, uint32_t first, uint32_t sectors, uint32_t batch,
+           std::vector<uint8_t> &data)
+{
+  Result r = { path, sectors, {}, {} };
+
+  SD_ResetBusStats();
+  Count = Counters{};
+  for (uint32_t s = 0; s < sectors; s += batch)
+  {
+    uint32_t n = std::min(batch, sectors - s);
+    DRESULT res = write ? SD_disk_write(0, &data[s * 512], first + s, n)
+                        : SD_disk_read(0, &data[s * 512], first + s, n);
+    check(res == RES_OK, path, "sector " + std::to_string(first + s));
+    check(LockDepth == 0, "every SPIbus_Lock undone", std::to_string(LockDepth));
+  }
+  SD_GetBusStats(&r.bus);
+  r.seen = Count;
+
+  check(r.bus.spi_transfers == Count.hal_calls + Count.dma_calls, "driver counts every HAL SPI call",
+        std::to_string(r.bus.spi_transfers) + " vs " + std::to_string(Count.hal_calls + Count.dma_calls));
+  check(r.bus.crc_errors == 0 && r.bus.token_errors == 0 && r.bus.retries == 0, "no errors or retries");
+  check((write ? r.bus.sectors_written : r.bus.sectors_read) == sectors, "sector count");
+  check(Count.unlocked == 0, "bus locked for every byte", std::to_string(Count.unlocked));
+  return r;
+}
+
+/* A CRC error steps the data clock down, a command without R1 does not */
+void TestRetries(uint32_t sector)
+{
+  SD_BusStats bus;
+  uint8_t buf[512];
+
+  SD_ResetBusStats();
+  Sd.noResponse = 1;
+  check(SD_disk_read(0, buf, sector, 1) == RES_OK, "read after a missing R1");
+  Sd.noResponse = 1;
+  check(SD_disk_write(0, buf, sector, 1) == RES_OK, "write after a missing R1");
+  SD_GetBusStats(&bus);
+  check(bus.retries == 2 && bus.clock_steps == 0, "missing R1 retried at the same clock",
+        std::to_string(bus.retries) + " retries, " + std::to_string(bus.clock_steps) + " steps");
+
+  Sd.badCrc = 1;
+  check(SD_disk_read(0, buf, sector, 1) == RES_OK, "read after a CRC error");
+  SD_GetBusStats(&bus);
+  check(bus.crc_errors == 1 && bus.retries == 3 && bus.clock_steps == 1, "CRC error retried at a slower clock",
+        std::to_string(bus.retries) + " retries, " + std::to_string(bus.clock_steps) + " steps");
+}
+
+} // namespace
+
+/* HAL and spi_bus.c stand-ins, every byte goes through the card */
+extern "C" {
+
+HAL_StatusTypeDef HAL_SPI_Transmit(SPI_HandleTypeDef *, uint8_t *tx, uint16_t size, uint32_t)
+{
+  Count.hal_calls++;
+  while (size--)
+    Sd.Exchange(*tx++);
+  return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_SPI_TransmitReceive(SPI_HandleTypeDef *, uint8_t *tx, uint8_t *rx, uint16_t size, uint32_t)
+{
+  Count.hal_calls++;
+  while (size--)
+    *rx++ = Sd.Exchange(*tx++);
+  return HAL_OK;
+}
+
+HAL_SPI_StateTypeDef HAL_SPI_GetState(SPI_HandleTypeDef *)
+{
+  return HAL_SPI_STATE_READY;
+}
+
+void SPIbus_Lock(SPIbus_Id)
+{
+  LockDepth++;
+}
+
+void SPIbus_Unlock(void)
+{
+  LockDepth--;
+}
+
+/* rx may be tx: each byte is sent before its slot is overwritten */
+HAL_StatusTypeDef SPIbus_LockedDma(const uint8_t *tx, uint8_t *rx, uint16_t len, uint32_t)
+{
+  Count.dma_calls++;
+  for (uint16_t i = 0; i < len; i++)
+  {
+    uint8_t b = Sd.Exchange(tx ? tx[i] : 0xFF);
+    if (rx)
+      rx[i] = b;
+  }
+  return HAL_OK;
+}
+
+void SPIbus_Configure(SPIbus_Id)
+{
+}
+
+void SPIbus_Select(SPIbus_Id)
+{
+  Count.selects++;
+  Sd.Select(true);
+}
+
+void SPIbus_Deselect(SPIbus_Id)
+{
+  Sd.Select(false);
+}
+
+void SPIbus_SetPrescaler(SPIbus_Id, uint32_t)
+{
+}
+
+uint32_t SPIbus_GetClockHz(SPIbus_Id)
+{
+  return 18000000;
+}
+
+} // extern "C"
+
+int main(int argc, char **argv)
+{
+  uint32_t sectors = argc > 1 ? strtoul(argv[1], nullptr, 0) : 64;
+  uint32_t batch = argc > 2 ? strtoul(argv[2], nullptr, 0) : 8;
+
+  if (sectors == 0 || batch < 2 || sectors > CardSectors / 2)
+  {
+    fprintf(stderr, "usage: %s [sectors [batch]], batch >= 2, sectors <= %u\n", argv[0], CardSectors / 2);
+    return 2;
+  }
+
+  for (size_t i = 0; i < Sd.disk.size(); i++)
+    Sd.disk[i] = uint8_t(i * 7 + (i >> 9));
+
+  check(SD_disk_initialize(0) == 0, "SD_disk_initialize");
+  check(LockDepth == 0, "every SPIbus_Lock undone after init", std::to_string(LockDepth));
+
+  std::vector<uint8_t> src(sectors * 512), single(sectors * 512), multi(sectors * 512);
+  for (size_t i = 0; i < src.size(); i++)
+    src[i] = uint8_t(rand());
+
+  /* the two paths write to separate areas, each one is read back */
+  uint32_t a = 1, b = 1 + sectors;
+  Result res[] = {
+    Run("single-block write", true, a, sectors, 1, src),
+    Run("multi-block write", true, b, sectors, batch, src),
+    Run("single-block read", false, a, sectors, 1, single),
+    Run("multi-block read", false, b, sectors, batch, multi),
+  };
+  check(single == src, "single-block read back");
+  check(multi == src, "multi-block read back");
+  TestRetries(b + sectors);
+
+  printf("SD_USE_DMA %d, %u sectors, batch %u\n\n", SD_USE_DMA, sectors, batch);
+  printf("%-20s %12s %12s %12s %12s\n", "path", "transfers", "per sector", "bytes/sect", "CS/sector");
+  for (const Result &r : res)
+    printf("%-20s %12u %12.2f %12.2f %12.3f\n", r.path, r.bus.spi_transfers,
+           double(r.bus.spi_transfers) / r.sectors, double(r.seen.bytes) / r.sectors,
+           double(r.seen.selects) / r.sectors);
+
+  printf("\n%d checks, %d failures\n", checks, failures);
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,387 @@
+/*
+ * spi_bus_host.cpp
+ *
+ *  Host build of the shared SPI bus queue (Core/Src/spi_bus.c) on a
+ *  stubbed HAL (stub/). DMA transfers complete when the test says so,
+ *  from a fake interrupt with IPSR set, and the tick only moves when the
+ *  test moves it. Checks the pick order by priority and submit order,
+ *  aging, the wait of a display transfer under a continuous sensor load,
+ *  chunking, that nothing is polled from the completion interrupt, and
+ *  that a nested bus lock holds the queue until its last unlock.
+ *
+ *  Build:  gcc -O2 -Istub -I../../STM32CubeIDE/badanie-ogniw/Core/Inc \
+ *              -c ../../STM32CubeIDE/badanie-ogniw/Core/Src/spi_bus.c
+ *          g++ -O2 -std=c++17 -Istub -I../../STM32CubeIDE/badanie-ogniw/Core/Inc \
+ *              -o spi_bus_host spi_bus_host.cpp spi_bus.o
+ *  Usage:  spi_bus_host
+ */
+
+#include <cstdio>
+#include <deque>
+#include <string>
+#include <vector>
+
+#include "spi.h"
+#include "spi_bus.h"
+
+GPIO_TypeDef HostGPIOE, HostGPIOF;
+SPI_HandleTypeDef hspi1;
+
+namespace {
+
+SPI_TypeDef Spi1;
+DMA_Stream_TypeDef TxStream;
+DMA_HandleTypeDef TxDma;
+
+uint32_t Tick, Primask, Ipsr;
+int Selected = -1;          /* device with CS low */
+
+struct Chunk {
+  const uint8_t *tx;
+  uint16_t len;
+  int dev;
+  bool polled;
+};
+std::vector<Chunk> Chunks;
+bool DmaBusy;
+int IsrPolls, CsClashes;
+
+/* A transfer with its own buffer, found again from the chunk address */
+struct Job {
+  SPIbus_Xfer x;
+  std::vector<uint8_t> buf;
+  char name;
+  uint32_t started;
+  bool done;
+};
+std::deque<Job> Jobs;
+
+int checks, failures;
+
+void check(bool ok, const char *what, const std::string &got = "")
+{
+  checks++;
+  if (!ok)
+  {
+    failures++;
+    fprintf(stderr, "%s failed%s%s\n", what, got.empty() ? "" : ": ", got.c_str());
+  }
+}
+
+int DeviceOf(GPIO_TypeDef *port, uint16_t pin)
+{
+  if (port == GPIOE && pin == GPIO_PIN_11)
+    return SPIBUS_SD;
+  if (port == GPIOE && pin == GPIO_PIN_9)
+    return SPIBUS_BMP280;
+  return SPIBUS_ST7735;
+}
+
+Job *JobOf(const uint8_t *tx)
+{
+  for (Job &j : Jobs)
+    if (tx >= j.buf.data() && tx < j.buf.data() + j.buf.size())
+      return &j;
+  return nullptr;
+}
+
+void Started(const uint8_t *tx, uint16_t len, bool polled)
+{
+  Chunks.push_back({ tx, len, Selected, polled });
+  Job *j = JobOf(tx);
+  if (j && tx == j->buf.data())
+    j->started = Tick;
+}
+
+void JobDone(SPIbus_Xfer *x)
+{
+  static_cast<Job *>(x->ctx)->done = true;
+}
+
+Job &Make(char name, SPIbus_Id dev, uint8_t prio, uint32_t len, uint16_t chunk = 0)
+{
+  Jobs.emplace_back();
+  Job &j = Jobs.back();
+  j.buf.assign(len, uint8_t(name));
+  j.name = name;
+  j.x = SPIbus_Xfer{};
+  j.x.dev = dev;
+  j.x.prio = prio;
+  j.x.tx = j.buf.data();
+  j.x.len = len;
+  j.x.chunk = chunk;
+  j.x.done = JobDone;
+  j.x.ctx = &j;
+  return j;
+}
+
+/* Ends the running DMA chunk from the SPI1 interrupt */
+void Complete()
+{
+  DmaBusy = false;
+  Ipsr = 16 + 35;
+  HAL_SPI_TxCpltCallback(&hspi1);
+  Ipsr = 0;
+}
+
+/* Chunks until the bus is idle, each ms_per_chunk long */
+void Run(uint32_t ms_per_chunk)
+{
+  for (int guard = 0; DmaBusy && guard < 100000; guard++)
+  {
+    Tick += ms_per_chunk;
+    Complete();
+  }
+}
+
+/* Job names in the order their first chunk started, from chunk 'from' on */
+std::string Order(size_t from = 0)
+{
+  std::string s;
+  for (size_t i = from; i < Chunks.size(); i++)
+  {
+    Job *j = JobOf(Chunks[i].tx);
+    if (j && Chunks[i].tx == j->buf.data())
+      s += j->name;
+  }
+  return s;
+}
+
+void TestPriority()
+{
+  Chunks.clear();
+  SPIbus_Submit(&Make('0', SPIBUS_ST7735, SPIBUS_PRIO_LOW, 64).x);
+  SPIbus_Submit(&Make('a', SPIBUS_ST7735, SPIBUS_PRIO_LOW, 16).x);
+  SPIbus_Submit(&Make('b', SPIBUS_SD, SPIBUS_PRIO_NORMAL, 16).x);
+  SPIbus_Submit(&Make('c', SPIBUS_BMP280, SPIBUS_PRIO_HIGH, 16).x);
+  SPIbus_Submit(&Make('d', SPIBUS_BMP280, SPIBUS_PRIO_HIGH, 16).x);
+  SPIbus_Submit(&Make('e', SPIBUS_SD, SPIBUS_PRIO_NORMAL, 16).x);
+  Run(0);
+  check(Order() == "0cdbea", "priority, then submit order", Order());
+}
+
+void TestAging()
+{
+  /* three levels of waiting lift LOW above a fresh HIGH */
+  Chunks.clear();
+  SPIbus_Submit(&Make('0', SPIBUS_ST7735, SPIBUS_PRIO_LOW, 64).x);
+  SPIbus_Submit(&Make('l', SPIBUS_ST7735, SPIBUS_PRIO_LOW, 16).x);
+  Tick += 3 * SPIBUS_AGING_MS;
+  SPIbus_Submit(&Make('h', SPIBUS_BMP280, SPIBUS_PRIO_HIGH, 16).x);
+  Run(0);
+  check(Order() == "0lh", "aged LOW before a fresh HIGH", Order());
+
+  /* one level is not enough */
+  Chunks.clear();
+  SPIbus_Submit(&Make('0', SPIBUS_ST7735, SPIBUS_PRIO_LOW, 64).x);
+  SPIbus_Submit(&Make('l', SPIBUS_ST7735, SPIBUS_PRIO_LOW, 16).x);
+  Tick += SPIBUS_AGING_MS;
+  SPIbus_Submit(&Make('h', SPIBUS_BMP280, SPIBUS_PRIO_HIGH, 16).x);
+  Run(0);
+  check(Order() == "0hl", "HIGH before a LOW one level up", Order());
+}
+
+/* A sensor read resubmitted from its own completion keeps the bus busy */
+Job *Load;
+uint32_t LoadRuns;
+
+void LoadDone(SPIbus_Xfer *x)
+{
+  LoadRuns++;
+  if (!Load->done && LoadRuns < 10000)
+    SPIbus_Submit(x);
+}
+
+void TestStarvation()
+{
+  const uint32_t ms_per_chunk = 1;
+
+  Chunks.clear();
+  Job &h = Make('h', SPIBUS_BMP280, SPIBUS_PRIO_HIGH, 16);
+  Load = &h;
+  h.x.done = LoadDone;
+  LoadRuns = 0;
+  SPIbus_Submit(&h.x);
+
+  Job &l = Make('l', SPIBUS_ST7735, SPIBUS_PRIO_LOW, 64);
+  uint32_t queued = Tick;
+  SPIbus_Submit(&l.x);
+
+  /* the load stops once the display transfer is through */
+  for (int guard = 0; DmaBusy && guard < 100000; guard++)
+  {
+    Tick += ms_per_chunk;
+    if (l.done)
+      h.done = true;
+    Complete();
+  }
+
+  uint32_t bound = (SPIBUS_PRIO_HIGH - SPIBUS_PRIO_LOW) * SPIBUS_AGING_MS + ms_per_chunk;
+  uint32_t wait = l.started - queued;
+  check(l.done && wait <= bound, "LOW wait under a HIGH load",
+        std::to_string(wait) + " ms, bound " + std::to_string(bound) + " ms");
+  printf("display waited %lu ms behind %lu sensor reads (bound %lu ms)\n", (unsigned long)wait,
+         (unsigned long)LoadRuns, (unsigned long)bound);
+}
+
+/* Short transfers are polled in thread context only */
+Job *Chained;
+
+void ChainDone(SPIbus_Xfer *x)
+{
+  static_cast<Job *>(x->ctx)->done = true;
+  SPIbus_Submit(&Chained->x);
+}
+
+void TestNoPollFromIsr()
+{
+  Chunks.clear();
+  SPIbus_Submit(&Make('s', SPIBUS_BMP280, SPIBUS_PRIO_HIGH, 2).x);
+  check(!Chunks.empty() && Chunks.back().polled, "short transfer polled from thread context");
+
+  Chunks.clear();
+  Job &first = Make('0', SPIBUS_ST7735, SPIBUS_PRIO_LOW, 64);
+  first.x.done = ChainDone;
+  Chained = &Make('s', SPIBUS_BMP280, SPIBUS_PRIO_HIGH, 2);
+  SPIbus_Submit(&first.x);
+  Run(0);
+  check(Chained->done && Chunks.size() == 2 && !Chunks[1].polled, "short transfer on DMA from the interrupt");
+  check(IsrPolls == 0, "no polled transfer with IPSR or PRIMASK set", std::to_string(IsrPolls));
+}
+
+void TestChunks()
+{
+  Chunks.clear();
+  Job &d = Make('d', SPIBUS_ST7735, SPIBUS_PRIO_LOW, 2 * SPIBUS_CHUNK + 100);
+  SPIbus_Submit(&d.x);
+  SPIbus_Submit(&Make('s', SPIBUS_BMP280, SPIBUS_PRIO_HIGH, 16).x);
+  Run(0);
+
+  std::string got;
+  for (const Chunk &c : Chunks)
+    got += std::string(1, JobOf(c.tx)->name) + std::to_string(c.len) + " ";
+  std::string want = "d" + std::to_string(SPIBUS_CHUNK) + " s16 d" + std::to_string(SPIBUS_CHUNK) + " d100 ";
+  check(got == want, "chunks of SPIBUS_CHUNK, sensor read in between", got);
+
+  Chunks.clear();
+  SPIbus_Submit(&Make('c', SPIBUS_ST7735, SPIBUS_PRIO_LOW, 1000, 256).x);
+  Run(0);
+  check(Chunks.size() == 4 && Chunks[3].len == 1000 - 3 * 256, "per transfer chunk size");
+}
+
+void TestNestedLock()
+{
+  Chunks.clear();
+  SPIbus_Lock(SPIBUS_SD);
+  SPIbus_Lock(SPIBUS_SD);
+  SPIbus_Submit(&Make('n', SPIBUS_BMP280, SPIBUS_PRIO_HIGH, 16).x);
+  SPIbus_Unlock();
+  Run(0);
+  check(Chunks.empty(), "queue held after an inner unlock", Order());
+  SPIbus_Unlock();
+  Run(0);
+  check(Order() == "n", "queue runs after the outer unlock", Order());
+}
+
+void TestTimeout()
+{
+  uint32_t len = 7;
+  uint32_t ms = SPIbus_TimeoutMs(SPIBUS_BMP280, len);
+  uint64_t bits = (2ULL * SPIBUS_CHUNK + len) * 8;
+
+  /* two chunks ahead at the slowest queued clock, then our own */
+  check(uint64_t(ms - 2) * SPIbus_GetClockHz(SPIBUS_ST7735) >= bits * 1000, "timeout covers the chunks ahead",
+        std::to_string(ms) + " ms");
+  printf("BMP280 %lu byte timeout %lu ms\n", (unsigned long)len, (unsigned long)ms);
+}
+
+} // namespace
+
+extern "C" {
+
+uint32_t __get_PRIMASK(void) { return Primask; }
+void __set_PRIMASK(uint32_t primask) { Primask = primask; }
+void __disable_irq(void) { Primask = 1; }
+uint32_t __get_IPSR(void) { return Ipsr; }
+
+uint32_t HAL_GetTick(void) { return Tick; }
+uint32_t HAL_RCC_GetPCLK2Freq(void) { return 72000000; }
+
+void HAL_GPIO_WritePin(GPIO_TypeDef *port, uint16_t pin, GPIO_PinState state)
+{
+  int dev = DeviceOf(port, pin);
+
+  if (state == GPIO_PIN_RESET)
+  {
+    if (Selected >= 0 && Selected != dev)
+      CsClashes++;
+    Selected = dev;
+  }
+  else if (Selected == dev)
+  {
+    Selected = -1;
+  }
+}
+
+HAL_StatusTypeDef HAL_SPI_Transmit(SPI_HandleTypeDef *hspi, uint8_t *tx, uint16_t size, uint32_t timeout)
+{
+  if (Ipsr || Primask)
+    IsrPolls++;
+  Started(tx, size, true);
+  return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_SPI_TransmitReceive(SPI_HandleTypeDef *hspi, uint8_t *tx, uint8_t *rx, uint16_t size,
+                                          uint32_t timeout)
+{
+  return HAL_SPI_Transmit(hspi, tx, size, timeout);
+}
+
+HAL_StatusTypeDef HAL_SPI_Transmit_DMA(SPI_HandleTypeDef *hspi, uint8_t *tx, uint16_t size)
+{
+  if (DmaBusy)
+    return HAL_BUSY;
+  DmaBusy = true;
+  Started(tx, size, false);
+  return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_SPI_TransmitReceive_DMA(SPI_HandleTypeDef *hspi, uint8_t *tx, uint8_t *rx, uint16_t size)
+{
+  return HAL_SPI_Transmit_DMA(hspi, tx, size);
+}
+
+HAL_StatusTypeDef HAL_SPI_Abort(SPI_HandleTypeDef *hspi)
+{
+  DmaBusy = false;
+  return HAL_OK;
+}
+
+HAL_SPI_StateTypeDef HAL_SPI_GetState(SPI_HandleTypeDef *hspi)
+{
+  return DmaBusy ? HAL_SPI_STATE_BUSY : HAL_SPI_STATE_READY;
+}
+
+} // extern "C"
+
+int main()
+{
+  TxDma.Instance = &TxStream;
+  TxDma.Init.MemInc = DMA_SxCR_MINC;
+  hspi1.Instance = &Spi1;
+  hspi1.hdmatx = &TxDma;
+  hspi1.Init.DataSize = SPI_DATASIZE_8BIT;
+  Tick = 1000;
+
+  TestPriority();
+  TestAging();
+  TestStarvation();
+  TestNoPollFromIsr();
+  TestChunks();
+  TestNestedLock();
+  TestTimeout();
+  check(CsClashes == 0, "one chip select low at a time", std::to_string(CsClashes));
+
+  printf("%d checks, %d failures\n", checks, failures);
+  return failures ? 1 : 0;
+}
@@ -0,0 +1,22 @@
+/*
+ * spi.h
+ *
+ *  hspi1 for spi_bus_host, defined in spi_bus_host.cpp.
+ */
+
+#ifndef SPI_BUS_HOST_SPI_H_
+#define SPI_BUS_HOST_SPI_H_
+
+#include "stm32f7xx_hal.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern SPI_HandleTypeDef hspi1;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SPI_BUS_HOST_SPI_H_ */
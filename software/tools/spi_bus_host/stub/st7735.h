@@ -0,0 +1,13 @@
+/*
+ * st7735.h
+ *
+ *  The display chip select, all spi_bus.c takes from the driver.
+ */
+
+#ifndef SPI_BUS_HOST_ST7735_H_
+#define SPI_BUS_HOST_ST7735_H_
+
+#define ST7735_CS_Pin        GPIO_PIN_13
+#define ST7735_CS_GPIO_Port  GPIOF
+
+#endif /* SPI_BUS_HOST_ST7735_H_ */
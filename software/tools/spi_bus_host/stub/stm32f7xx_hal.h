@@ -0,0 +1,144 @@
+/*
+ * stm32f7xx_hal.h
+ *
+ *  The part of the HAL that spi_bus.c, fatfs_sd.c and sd_log.c use, for
+ *  spi_bus_host, sd_bus_host and profiler_host. Register values are the
+ *  STM32F746 ones, the functions are in the tool.
+ */
+
+#ifndef SPI_BUS_HOST_HAL_H_
+#define SPI_BUS_HOST_HAL_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+  HAL_OK,
+  HAL_ERROR,
+  HAL_BUSY,
+  HAL_TIMEOUT
+} HAL_StatusTypeDef;
+
+#define HAL_MAX_DELAY             0xFFFFFFFFU
+
+#define MODIFY_REG(REG, CLEARMASK, SETMASK)  ((REG) = (((REG) & ~(CLEARMASK)) | (SETMASK)))
+
+typedef struct {
+  volatile uint32_t ODR;
+} GPIO_TypeDef;
+
+typedef enum {
+  GPIO_PIN_RESET,
+  GPIO_PIN_SET
+} GPIO_PinState;
+
+extern GPIO_TypeDef HostGPIOE, HostGPIOF;
+#define GPIOE                     (&HostGPIOE)
+#define GPIOF                     (&HostGPIOF)
+#define GPIO_PIN_9                ((uint16_t)0x0200)
+#define GPIO_PIN_11               ((uint16_t)0x0800)
+#define GPIO_PIN_13               ((uint16_t)0x2000)
+
+typedef struct {
+  volatile uint32_t CR1;
+  volatile uint32_t CR2;
+  volatile uint32_t SR;
+} SPI_TypeDef;
+
+typedef struct {
+  volatile uint32_t CR;
+} DMA_Stream_TypeDef;
+
+#define SPI_CR1_CPHA              0x00000001U
+#define SPI_CR1_CPOL              0x00000002U
+#define SPI_CR1_BR_Pos            3U
+#define SPI_CR1_BR_0              0x00000008U
+#define SPI_CR1_BR                0x00000038U
+#define SPI_CR1_SPE               0x00000040U
+#define SPI_CR2_DS                0x00000F00U
+#define SPI_SR_BSY                0x00000080U
+#define DMA_SxCR_MINC             0x00000400U
+#define DMA_SxCR_PSIZE            0x00001800U
+#define DMA_SxCR_MSIZE            0x00006000U
+
+#define SPI_BAUDRATEPRESCALER_2   0x00000000U
+#define SPI_BAUDRATEPRESCALER_4   0x00000008U
+#define SPI_BAUDRATEPRESCALER_8   0x00000010U
+#define SPI_BAUDRATEPRESCALER_16  0x00000018U
+#define SPI_BAUDRATEPRESCALER_32  0x00000020U
+#define SPI_BAUDRATEPRESCALER_64  0x00000028U
+#define SPI_BAUDRATEPRESCALER_128 0x00000030U
+#define SPI_BAUDRATEPRESCALER_256 0x00000038U
+#define SPI_DATASIZE_8BIT         0x00000700U
+#define SPI_DATASIZE_16BIT        0x00000F00U
+#define SPI_POLARITY_LOW          0x00000000U
+#define SPI_PHASE_1EDGE           0x00000000U
+#define DMA_PDATAALIGN_HALFWORD   0x00000800U
+#define DMA_MDATAALIGN_HALFWORD   0x00002000U
+#define HAL_SPI_ERROR_NONE        0x00000000U
+
+typedef struct {
+  uint32_t MemInc;
+  uint32_t PeriphDataAlignment;
+  uint32_t MemDataAlignment;
+} DMA_InitTypeDef;
+
+typedef struct {
+  DMA_Stream_TypeDef *Instance;
+  DMA_InitTypeDef Init;
+} DMA_HandleTypeDef;
+
+typedef struct {
+  uint32_t DataSize;
+  uint32_t CLKPolarity;
+  uint32_t CLKPhase;
+  uint32_t BaudRatePrescaler;
+} SPI_InitTypeDef;
+
+typedef struct {
+  SPI_TypeDef *Instance;
+  SPI_InitTypeDef Init;
+  DMA_HandleTypeDef *hdmatx;
+  volatile uint32_t ErrorCode;
+} SPI_HandleTypeDef;
+
+typedef enum {
+  HAL_SPI_STATE_RESET,
+  HAL_SPI_STATE_READY,
+  HAL_SPI_STATE_BUSY
+} HAL_SPI_StateTypeDef;
+
+#define __HAL_SPI_DISABLE(h)      ((h)->Instance->CR1 &= ~SPI_CR1_SPE)
+
+/* Interrupt state, IPSR nonzero while a completion callback runs */
+uint32_t __get_PRIMASK(void);
+void __set_PRIMASK(uint32_t primask);
+void __disable_irq(void);
+uint32_t __get_IPSR(void);
+
+uint32_t HAL_GetTick(void);
+uint32_t HAL_RCC_GetPCLK2Freq(void);
+void HAL_GPIO_WritePin(GPIO_TypeDef *port, uint16_t pin, GPIO_PinState state);
+
+HAL_StatusTypeDef HAL_SPI_Transmit(SPI_HandleTypeDef *hspi, uint8_t *tx, uint16_t size, uint32_t timeout);
+HAL_StatusTypeDef HAL_SPI_TransmitReceive(SPI_HandleTypeDef *hspi, uint8_t *tx, uint8_t *rx, uint16_t size,
+                                          uint32_t timeout);
+HAL_StatusTypeDef HAL_SPI_Transmit_DMA(SPI_HandleTypeDef *hspi, uint8_t *tx, uint16_t size);
+HAL_StatusTypeDef HAL_SPI_TransmitReceive_DMA(SPI_HandleTypeDef *hspi, uint8_t *tx, uint8_t *rx, uint16_t size);
+HAL_StatusTypeDef HAL_SPI_Abort(SPI_HandleTypeDef *hspi);
+HAL_SPI_StateTypeDef HAL_SPI_GetState(SPI_HandleTypeDef *hspi);
+
+/* In spi_bus.c */
+void HAL_SPI_TxCpltCallback(SPI_HandleTypeDef *hspi);
+void HAL_SPI_TxRxCpltCallback(SPI_HandleTypeDef *hspi);
+void HAL_SPI_ErrorCallback(SPI_HandleTypeDef *hspi);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SPI_BUS_HOST_HAL_H_ */
@@ -0,0 +1,44 @@
+#!/bin/sh
+#
+# check.sh
+#
+#  Builds telemetry_decoder and runs it on the fixtures (fixtures/, made
+#  by fixturegen), with and without -f. The CSV and the summary line with
+#  the CRC, bad frame and sequence gap counters have to match exactly.
+#
+#  Usage:  ./check.sh
+
+set -e
+cd "$(dirname "$0")"
+
+tmp=$(mktemp -d)
+trap 'rm -rf "$tmp"' EXIT
+
+g++ -O2 -std=c++17 -o "$tmp/telemetry_decoder" telemetry_decoder.cpp
+
+fail=0
+check() {
+    name=$1
+    expected=$2
+    shift 2
+    "$tmp/telemetry_decoder" "$@" fixtures/$name.bin "$tmp/out.csv" 2> "$tmp/summary" || true
+    if ! cmp -s "$tmp/out.csv" fixtures/$expected.csv; then
+        echo "$name $*: CSV differs from fixtures/$expected.csv"
+        diff fixtures/$expected.csv "$tmp/out.csv" | head -20
+        fail=1
+    fi
+    if ! cmp -s "$tmp/summary" fixtures/$name.summary; then
+        echo "$name $*: summary differs"
+        echo "  expected: $(cat fixtures/$name.summary)"
+        echo "  got:      $(cat "$tmp/summary")"
+        fail=1
+    fi
+}
+
+check console console
+check console console_fill -f
+
+if [ $fail -eq 0 ]; then
+    echo "fixtures OK"
+fi
+exit $fail
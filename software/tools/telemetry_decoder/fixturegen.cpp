@@ -0,0 +1,213 @@
+/*
+ * fixturegen.cpp
+ *
+ *  Writes the telemetry_decoder fixtures (fixtures/): a stream laid out
+ *  like the USART3 output of the firmware, with the CSV and the summary
+ *  the decoder has to produce for it. The packets are built here and
+ *  COBS encoded with telemetry.h, the expected rows come from the values
+ *  that went in, not from the decoder.
+ *
+ *  console.bin holds packets with changing channel sets and a sequence
+ *  wrapping through 0, console text before the first frame and between
+ *  two frames, a dropped packet, one with a bad CRC and one cut short
+ *  (a malformed COBS frame).
+ *
+ *  Build:  g++ -O2 -std=c++17 -o fixturegen fixturegen.cpp
+ *  Usage:  fixturegen fixtures/
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "../../STM32CubeIDE/badanie-ogniw/Core/Inc/telemetry.h"
+
+namespace {
+
+const unsigned Packets = 12;
+const uint16_t FirstSeq = 65530;
+
+enum Fate { Sent, Dropped, BadCrc, Truncated };
+
+Fate fate(unsigned i)
+{
+  switch (i)
+  {
+  case 6: return Dropped;       /* seq 0 */
+  case 8: return BadCrc;
+  case 10: return Truncated;
+  default: return Sent;
+  }
+}
+
+const uint32_t InaChannels = TELEM_MASK(TELEM_CH_VOLTAGE) | TELEM_MASK(TELEM_CH_CURRENT) |
+                             TELEM_MASK(TELEM_CH_POWER) | TELEM_MASK(TELEM_CH_CHARGE) |
+                             TELEM_MASK(TELEM_CH_ENERGY);
+const uint32_t BmpChannels = TELEM_MASK(TELEM_CH_PRESSURE) | TELEM_MASK(TELEM_CH_TEMPERATURE);
+
+/* A full packet first, then the INA219 set, the BMP280 every fourth */
+uint32_t channels(unsigned i)
+{
+  if (i == 0)
+    return TELEM_ALL;
+  return InaChannels | (i % 4 == 0 ? BmpChannels : 0);
+}
+
+int64_t value(unsigned ch, unsigned i)
+{
+  switch (ch)
+  {
+  case TELEM_CH_PRESSURE:    return 100653 + int(i);
+  case TELEM_CH_TEMPERATURE: return 2508 - int(i);
+  case TELEM_CH_TVOC:        return 12;
+  case TELEM_CH_CO2_EQ:      return 400;
+  case TELEM_CH_ETHANOL:     return 9995;
+  case TELEM_CH_H2:          return 7067;
+  case TELEM_CH_VOLTAGE:     return 3712 - int(i);
+  case TELEM_CH_CURRENT:     return -250 + 3 * int(i);
+  case TELEM_CH_POWER:       return 928;
+  case TELEM_CH_ADC:         return 2048;
+  case TELEM_CH_CHARGE:      return -7 * int(i);
+  case TELEM_CH_ENERGY:      return 26 * int(i);
+  default:                   return 0;
+  }
+}
+
+std::vector<uint8_t> packet(unsigned i)
+{
+  TelemHeader hdr = { TELEM_TYPE_SAMPLE, TELEM_VERSION, uint16_t(FirstSeq + i), 1000 + 10 * i, channels(i) };
+  std::vector<uint8_t> p(sizeof(hdr));
+
+  memcpy(p.data(), &hdr, sizeof(hdr));
+  for (unsigned ch = 0; ch < TELEM_CHANNELS; ch++)
+  {
+    if (!(hdr.channels & TELEM_MASK(ch)))
+      continue;
+    uint32_t v = uint32_t(value(ch, i));
+    for (uint8_t b = 0; b < Telem_ValueSize(Telem_Channels[ch].type); b++)
+      p.push_back(uint8_t(v >> (8 * b)));
+  }
+  uint16_t crc = Log_Crc16(p.data(), p.size());
+  if (fate(i) == BadCrc)
+    crc ^= 0x0100;
+  p.push_back(uint8_t(crc));
+  p.push_back(uint8_t(crc >> 8));
+  return p;
+}
+
+void frame(std::string &out, const std::vector<uint8_t> &p, bool truncate)
+{
+  uint8_t enc[TELEM_MAX_FRAME];
+  size_t n = Telem_CobsEncode(p.data(), p.size(), enc);
+
+  if (truncate)
+    n /= 2;
+  out += '\0';
+  out.append(reinterpret_cast<const char *>(enc), n);
+  out += '\0';
+}
+
+/* Formatted like the decoder: fixed point by the channel divisor */
+std::string field(unsigned ch, int64_t v)
+{
+  char s[32];
+  unsigned divisor = Telem_Channels[ch].divisor;
+
+  if (divisor <= 1)
+    snprintf(s, sizeof(s), "%lld", (long long)v);
+  else
+    snprintf(s, sizeof(s), divisor <= 100 ? "%.2f" : "%.4f", double(v) / divisor);
+  return s;
+}
+
+bool write(const std::string &name, const std::string &data)
+{
+  FILE *f = fopen(name.c_str(), "wb");
+  if (!f || fwrite(data.data(), 1, data.size(), f) != data.size() || fclose(f))
+  {
+    perror(name.c_str());
+    return false;
+  }
+  return true;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+  if (argc != 2)
+  {
+    fprintf(stderr, "usage: %s fixtures-dir\n", argv[0]);
+    return 2;
+  }
+  std::string dir = std::string(argv[1]) + "/";
+
+  std::string stream = "SD card mounted\r\n";
+  std::string header = "seq,time_ms";
+  for (const TelemChannel &ch : Telem_Channels)
+    header += std::string(",") + ch.name;
+  header += "\n";
+  std::string csv = header, filled = header;
+
+  /* the boot text is the first bad frame */
+  unsigned packets = 0, crc_errors = 0, bad_frames = 1, gaps = 0, lost = 0;
+  int64_t last[TELEM_CHANNELS] = {};
+  uint32_t have = 0;
+  int prev = -1;
+
+  for (unsigned i = 0; i < Packets; i++)
+  {
+    if (fate(i) != Dropped)
+      frame(stream, packet(i), fate(i) == Truncated);
+    if (i == 3)
+    {
+      stream += "clear screen 2380 us, frame from RAM 2410 us, wire time 2275 us\r\n";
+      bad_frames++;
+    }
+
+    if (fate(i) == BadCrc)
+      crc_errors++;
+    if (fate(i) == Truncated)
+      bad_frames++;
+    if (fate(i) != Sent)
+      continue;
+
+    if (prev >= 0 && i != unsigned(prev) + 1)
+    {
+      gaps++;
+      lost += i - unsigned(prev) - 1;
+    }
+    prev = int(i);
+    packets++;
+
+    std::string row = std::to_string(uint16_t(FirstSeq + i)) + "," + std::to_string(1000 + 10 * i);
+    std::string frow = row;
+    for (unsigned ch = 0; ch < TELEM_CHANNELS; ch++)
+    {
+      row += ",";
+      frow += ",";
+      if (channels(i) & TELEM_MASK(ch))
+      {
+        last[ch] = value(ch, i);
+        have |= TELEM_MASK(ch);
+        row += field(ch, last[ch]);
+      }
+      if (have & TELEM_MASK(ch))
+        frow += field(ch, last[ch]);
+    }
+    csv += row + "\n";
+    filled += frow + "\n";
+  }
+
+  char summary[160];
+  snprintf(summary, sizeof(summary), "packets %u, crc errors %u, bad frames %u, seq gaps %u (%u packets lost)\n",
+           packets, crc_errors, bad_frames, gaps, lost);
+
+  if (!write(dir + "console.bin", stream) || !write(dir + "console.csv", csv) ||
+      !write(dir + "console_fill.csv", filled) || !write(dir + "console.summary", summary))
+    return 1;
+  printf("%s", summary);
+  return 0;
+}
@@ -0,0 +1,310 @@
+/*
+ * telemetry_decoder.cpp
+ *
+ *  Decodes the binary live telemetry stream (telemetry.h) to CSV.
+ *
+ *  Build:  g++ -O2 -std=c++17 -o telemetry_decoder telemetry_decoder.cpp
+ *  Usage:  telemetry_decoder [-b baud] [-f] input [output.csv]
+ *  Check:  ./check.sh, the fixtures come from fixturegen.cpp
+ *
+ *  The input is a serial device (set to raw mode at -b baud, 921600 by
+ *  default) or a file holding a recorded stream, e.g. from
+ *  `cat /dev/ttyACM0 > rec.bin`. One row per packet, channels missing
+ *  from a packet are left empty, or repeat their last value with -f.
+ *  Frames with a bad CRC or COBS coding (console text between frames
+ *  ends up as one) are skipped, gaps in the sequence are counted. A
+ *  summary goes to stderr at the end of the input or on Ctrl-C.
+ */
+
+#include <charconv>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include <fcntl.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include "../../STM32CubeIDE/badanie-ogniw/Core/Inc/telemetry.h"
+
+namespace {
+
+struct Stats
+{
+  size_t packets = 0;
+  size_t crc_errors = 0;
+  size_t bad_frames = 0;
+  size_t seq_gaps = 0;
+  size_t lost_packets = 0;
+};
+
+volatile sig_atomic_t stop;
+
+void on_signal(int) { stop = 1; }
+
+speed_t baud_constant(unsigned long baud)
+{
+  switch (baud)
+  {
+  case 9600: return B9600;
+  case 19200: return B19200;
+  case 38400: return B38400;
+  case 57600: return B57600;
+  case 115200: return B115200;
+  case 230400: return B230400;
+  case 460800: return B460800;
+  case 921600: return B921600;
+  case 1000000: return B1000000;
+  case 2000000: return B2000000;
+  default: return B0;
+  }
+}
+
+bool set_raw(int fd, unsigned long baud)
+{
+  struct termios tio;
+  speed_t speed = baud_constant(baud);
+  if (speed == B0)
+  {
+    fprintf(stderr, "unsupported baud rate %lu\n", baud);
+    return false;
+  }
+  if (tcgetattr(fd, &tio) != 0)
+  {
+    perror("tcgetattr");
+    return false;
+  }
+  cfmakeraw(&tio);
+  cfsetispeed(&tio, speed);
+  cfsetospeed(&tio, speed);
+  tio.c_cflag |= CLOCAL | CREAD;
+  tio.c_cc[VMIN] = 1;
+  tio.c_cc[VTIME] = 0;
+  if (tcsetattr(fd, TCSANOW, &tio) != 0)
+  {
+    perror("tcsetattr");
+    return false;
+  }
+  tcflush(fd, TCIFLUSH);
+  return true;
+}
+
+class Decoder
+{
+public:
+  Decoder(FILE *f, bool fill) : out(f), fill(fill) {}
+
+  void write_header()
+  {
+    fputs("seq,time_ms", out);
+    for (const TelemChannel &ch : Telem_Channels)
+      fprintf(out, ",%s", ch.name);
+    fputc('\n', out);
+  }
+
+  /* One frame without its delimiters */
+  void frame(const uint8_t *data, size_t len)
+  {
+    uint8_t packet[TELEM_MAX_FRAME];
+    TelemHeader hdr;
+
+    if (len > TELEM_MAX_FRAME)
+    {
+      st.bad_frames++;
+      return;
+    }
+    size_t n = Telem_CobsDecode(data, len, packet);
+    if (n < sizeof(hdr) + 2)
+    {
+      st.bad_frames++;
+      return;
+    }
+    uint16_t crc = uint16_t(packet[n - 2] | packet[n - 1] << 8);
+    if (Log_Crc16(packet, n - 2) != crc)
+    {
+      st.crc_errors++;
+      return;
+    }
+    memcpy(&hdr, packet, sizeof(hdr));
+    if (hdr.type != TELEM_TYPE_SAMPLE || hdr.version != TELEM_VERSION ||
+        (hdr.channels & ~uint32_t(TELEM_ALL)) || n != packet_size(hdr.channels))
+    {
+      st.bad_frames++;
+      return;
+    }
+
+    if (st.packets && hdr.seq != uint16_t(last_seq + 1))
+    {
+      st.seq_gaps++;
+      st.lost_packets += uint16_t(hdr.seq - last_seq - 1);
+    }
+    last_seq = hdr.seq;
+    st.packets++;
+
+    const uint8_t *p = packet + sizeof(hdr);
+    for (unsigned ch = 0; ch < TELEM_CHANNELS; ch++)
+    {
+      if (!(hdr.channels & TELEM_MASK(ch)))
+        continue;
+      uint8_t size = Telem_ValueSize(Telem_Channels[ch].type);
+      uint32_t v = 0;
+      for (uint8_t i = 0; i < size; i++)
+        v |= uint32_t(*p++) << (8 * i);
+      value[ch] = signed_value(Telem_Channels[ch].type, v);
+      have |= TELEM_MASK(ch);
+    }
+    write_row(hdr);
+  }
+
+  const Stats &stats() const { return st; }
+
+private:
+  static size_t packet_size(uint32_t channels)
+  {
+    size_t n = sizeof(TelemHeader) + 2;
+    for (unsigned ch = 0; ch < TELEM_CHANNELS; ch++)
+    {
+      if (channels & TELEM_MASK(ch))
+        n += Telem_ValueSize(Telem_Channels[ch].type);
+    }
+    return n;
+  }
+
+  static int64_t signed_value(uint8_t type, uint32_t v)
+  {
+    switch (type)
+    {
+    case LOG_TYPE_I16: return int16_t(v);
+    case LOG_TYPE_I32: return int32_t(v);
+    default: return v;
+    }
+  }
+
+  void write_row(const TelemHeader &hdr)
+  {
+    char line[512];
+    char *p = line, *end = line + sizeof(line);
+
+    p = std::to_chars(p, end, hdr.seq).ptr;
+    *p++ = ',';
+    p = std::to_chars(p, end, hdr.time_ms).ptr;
+    for (unsigned ch = 0; ch < TELEM_CHANNELS; ch++)
+    {
+      *p++ = ',';
+      uint32_t mask = fill ? have : hdr.channels;
+      if (!(mask & TELEM_MASK(ch)))
+        continue;
+      unsigned divisor = Telem_Channels[ch].divisor;
+      if (divisor <= 1)
+        p = std::to_chars(p, end, value[ch]).ptr;
+      else
+        p = std::to_chars(p, end, double(value[ch]) / divisor,
+                          std::chars_format::fixed, divisor <= 100 ? 2 : 4).ptr;
+    }
+    *p++ = '\n';
+    fwrite(line, 1, size_t(p - line), out);
+  }
+
+  FILE *out;
+  bool fill;
+  Stats st;
+  uint16_t last_seq = 0;
+  uint32_t have = 0;
+  int64_t value[TELEM_CHANNELS] = {};
+};
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+  unsigned long baud = 921600;
+  bool fill = false;
+  int opt;
+
+  while ((opt = getopt(argc, argv, "b:f")) != -1)
+  {
+    switch (opt)
+    {
+    case 'b': baud = strtoul(optarg, nullptr, 0); break;
+    case 'f': fill = true; break;
+    default:
+      fprintf(stderr, "usage: %s [-b baud] [-f] input [output.csv]\n", argv[0]);
+      return 2;
+    }
+  }
+  if (argc - optind < 1 || argc - optind > 2)
+  {
+    fprintf(stderr, "usage: %s [-b baud] [-f] input [output.csv]\n", argv[0]);
+    return 2;
+  }
+
+  const char *in_name = argv[optind];
+  int fd = strcmp(in_name, "-") ? open(in_name, O_RDONLY | O_NOCTTY) : STDIN_FILENO;
+  if (fd < 0)
+  {
+    perror(in_name);
+    return 1;
+  }
+  bool live = isatty(fd);
+  if (live && !set_raw(fd, baud))
+    return 1;
+
+  FILE *f = stdout;
+  if (argc - optind == 2 && !(f = fopen(argv[optind + 1], "wb")))
+  {
+    perror(argv[optind + 1]);
+    return 1;
+  }
+
+  /* live rows show up as they arrive, a recording is written in blocks */
+  if (live)
+    setvbuf(f, nullptr, _IOLBF, 0);
+
+  struct sigaction sa = {};
+  sa.sa_handler = on_signal;
+  sigaction(SIGINT, &sa, nullptr);
+  sigaction(SIGTERM, &sa, nullptr);
+
+  Decoder dec(f, fill);
+  dec.write_header();
+
+  std::vector<uint8_t> buf(1 << 16);
+  std::vector<uint8_t> frame;
+  frame.reserve(TELEM_MAX_FRAME + 1);
+
+  while (!stop)
+  {
+    ssize_t n = read(fd, buf.data(), buf.size());
+    if (n <= 0)
+      break;
+    for (ssize_t i = 0; i < n; i++)
+    {
+      uint8_t c = buf[size_t(i)];
+      if (c != 0)
+      {
+        /* an overlong run is not a frame, keep one byte too many to reject it */
+        if (frame.size() <= TELEM_MAX_FRAME)
+          frame.push_back(c);
+        continue;
+      }
+      if (!frame.empty())
+        dec.frame(frame.data(), frame.size());
+      frame.clear();
+    }
+  }
+
+  if (fd != STDIN_FILENO)
+    close(fd);
+  if (f != stdout)
+    fclose(f);
+  else
+    fflush(f);
+
+  const Stats &st = dec.stats();
+  fprintf(stderr, "packets %zu, crc errors %zu, bad frames %zu, seq gaps %zu (%zu packets lost)\n",
+          st.packets, st.crc_errors, st.bad_frames, st.seq_gaps, st.lost_packets);
+
+  return st.packets ? 0 : 1;
+}